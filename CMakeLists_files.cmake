@@ -57,12 +57,17 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_convergencereport.cpp
   tests/test_flexiblesolver.cpp
   tests/test_preconditionerfactory.cpp
+  tests/test_recycledkrylovspace.cpp
+  tests/test_linearsystemio.cpp
   tests/test_graphcoloring.cpp
   tests/test_vfpproperties.cpp
   tests/test_milu.cpp
   tests/test_multmatrixtransposed.cpp
   tests/test_nncsorter.cpp
   tests/test_wellmodel.cpp
+  tests/test_wellschurcomplement.cpp
+  tests/test_parallelwellloop.cpp
+  tests/test_segmenttreesolver.cpp
   tests/test_deferredlogger.cpp
   tests/test_timer.cpp
   tests/test_invert.cpp
@@ -157,6 +162,8 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/ExtractParallelGridInformationToISTL.hpp
   opm/simulators/linalg/FlexibleSolver.hpp
   opm/simulators/linalg/FlowLinearSolverParameters.hpp
+  opm/simulators/linalg/FusedBiCGSTABSolver.hpp
+  opm/simulators/linalg/LinearSystemIO.hpp
   opm/simulators/linalg/GraphColoring.hpp
   opm/simulators/linalg/ISTLSolverEbos.hpp
   opm/simulators/linalg/ISTLSolverEbosCpr.hpp
@@ -169,10 +176,13 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/ParallelIstlInformation.hpp
   opm/simulators/linalg/PressureSolverPolicy.hpp
   opm/simulators/linalg/PressureTransferPolicy.hpp
+  opm/simulators/linalg/RecycledKrylovSpace.hpp
   opm/simulators/linalg/PreconditionerFactory.hpp
+  opm/simulators/linalg/PreconditionerSetupData.hpp
   opm/simulators/linalg/PreconditionerWithUpdate.hpp
   opm/simulators/linalg/findOverlapRowsAndColumns.hpp
   opm/simulators/linalg/getQuasiImpesWeights.hpp
+  opm/simulators/linalg/iluClusterKeys.hpp
   opm/simulators/linalg/setupPropertyTree.hpp
   opm/simulators/timestepping/AdaptiveSimulatorTimer.hpp
   opm/simulators/timestepping/AdaptiveTimeSteppingEbos.hpp
@@ -197,12 +207,15 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/wells/VFPProdProperties.hpp
   opm/simulators/wells/WellHelpers.hpp
   opm/simulators/wells/WellInterface.hpp
+  opm/simulators/wells/WellSchurComplement.hpp
+  opm/simulators/wells/ParallelWellLoop.hpp
   opm/simulators/wells/WellInterface_impl.hpp
   opm/simulators/wells/StandardWell.hpp
   opm/simulators/wells/StandardWell_impl.hpp
   opm/simulators/wells/MultisegmentWell.hpp
   opm/simulators/wells/MultisegmentWell_impl.hpp
   opm/simulators/wells/MSWellHelpers.hpp
+  opm/simulators/wells/SegmentTreeSolver.hpp
   opm/simulators/wells/BlackoilWellModel.hpp
   opm/simulators/wells/BlackoilWellModel_impl.hpp
   )
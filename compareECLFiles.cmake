@@ -419,6 +419,38 @@ add_test_compareECLFiles(CASENAME norne
                          PREFIX compareECLInitFiles
                          DIR_PREFIX /init)
 
+# Linear tolerance comparison tests
+opm_set_test_driver(${PROJECT_SOURCE_DIR}/tests/run-linear-tolerance-comparison.sh "")
+
+# The adaptive tolerance changes the Newton path, hence the cruder tolerances
+add_test_compareECLFiles(CASENAME spe1
+                         FILENAME SPE1CASE2
+                         SIMULATOR flow
+                         ABS_TOL ${abs_tol_restart}
+                         REL_TOL ${coarse_rel_tol}
+                         PREFIX compareLinearTolerance
+                         DIR_PREFIX /linear-tolerance)
+
+add_test_compareECLFiles(CASENAME spe9
+                         FILENAME SPE9_CP_SHORT
+                         SIMULATOR flow
+                         ABS_TOL ${abs_tol_restart}
+                         REL_TOL ${coarse_rel_tol}
+                         PREFIX compareLinearTolerance
+                         DIR_PREFIX /linear-tolerance)
+
+# ILU ordering comparison tests, these also replay the linear systems with flow_linsolve_bench
+opm_set_test_driver(${PROJECT_SOURCE_DIR}/tests/run-ilu-ordering-comparison.sh "")
+
+# The ordering changes the linear solutions, hence the cruder tolerances
+add_test_compareECLFiles(CASENAME spe9
+                         FILENAME SPE9_CP_SHORT
+                         SIMULATOR flow
+                         ABS_TOL ${abs_tol_restart}
+                         REL_TOL ${coarse_rel_tol}
+                         PREFIX compareIluOrdering
+                         DIR_PREFIX /ilu-ordering)
+
 # Parallel tests
 if(MPI_FOUND)
   opm_set_test_driver(${PROJECT_SOURCE_DIR}/tests/run-restart-regressionTest.sh "")
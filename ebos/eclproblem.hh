@@ -790,13 +790,23 @@ public:
             // has changed, the grid may need be re-created which has some serious
             // implications on e.g., the solution of the simulation.)
             const auto& miniDeck = schedule.getModifierDeck(episodeIdx);
+            bool onlyTransMultipliers = onlyModifiesTransMultipliers_(miniDeck);
             eclState.applyModifierDeck(miniDeck);
 
             // re-compute all quantities which may possibly be affected.
-            transmissibilities_.update();
-            referencePorosity_[1] = referencePorosity_[0];
-            updateReferencePorosity_();
-            updatePffDofData_();
+            if (onlyTransMultipliers) {
+                // the geometric part of the transmissibilities and the pore volumes
+                // are unaffected, so we only need to touch the faces for which the
+                // multipliers have changed.
+                if (transmissibilities_.updateMultipliers() > 0)
+                    updatePffDofData_();
+            }
+            else {
+                transmissibilities_.update();
+                referencePorosity_[1] = referencePorosity_[0];
+                updateReferencePorosity_();
+                updatePffDofData_();
+            }
         }
 
         if (enableExperiments && this->gridView().comm().rank() == 0 && episodeIdx >= 0) {
@@ -2857,6 +2867,26 @@ private:
         }
     }
 
+    // returns true if a SCHEDULE modifier deck only changes the transmissibility
+    // multipliers, i.e., if the transmissibilities can be updated incrementally
+    static bool onlyModifiesTransMultipliers_(const Opm::Deck& miniDeck)
+    {
+        static const std::set<std::string> multiplierKeywords = {
+            "MULTFLT",
+            "MULTX", "MULTX-",
+            "MULTY", "MULTY-",
+            "MULTZ", "MULTZ-",
+            "MULTREGT"
+        };
+
+        for (size_t keywordIdx = 0; keywordIdx < miniDeck.size(); ++keywordIdx) {
+            if (multiplierKeywords.count(miniDeck.getKeyword(keywordIdx).name()) == 0)
+                return false;
+        }
+
+        return true;
+    }
+
     struct PffDofData_
     {
         Opm::ConditionalStorage<enableEnergy, Scalar> thermalHalfTrans;
@@ -31,6 +31,7 @@
 #include <ebos/nncsorter.hpp>
 
 #include <ewoms/common/propertysystem.hh>
+#include <ewoms/parallel/threadedentityiterator.hh>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
@@ -50,9 +51,13 @@
 #include <dune/common/fvector.hh>
 #include <dune/common/fmatrix.hh>
 
+#include <algorithm>
 #include <array>
+#include <exception>
+#include <numeric>
+#include <stdexcept>
+#include <string>
 #include <vector>
-#include <unordered_map>
 
 BEGIN_PROPERTIES
 
@@ -82,6 +87,7 @@ class EclTransmissibility
     typedef typename GET_PROP_TYPE(TypeTag, Vanguard) Vanguard;
     typedef typename GET_PROP_TYPE(TypeTag, ElementMapper) ElementMapper;
     typedef typename GridView::Intersection Intersection;
+    typedef typename GridView::template Codim<0>::Entity Element;
 
     static const bool enableEnergy = GET_PROP_VALUE(TypeTag, EnableEnergy);
 
@@ -91,8 +97,6 @@ class EclTransmissibility
     typedef Dune::FieldMatrix<Scalar, dimWorld, dimWorld> DimMatrix;
     typedef Dune::FieldVector<Scalar, dimWorld> DimVector;
 
-    static const unsigned elemIdxShift = 32; // bits
-
 public:
 
     EclTransmissibility(const Vanguard& vanguard)
@@ -147,18 +151,21 @@ public:
 
         extractPermeability_();
 
+        // The MULTZ needs special case if the option is ALL
+        // Then the smallest multiplier is applied.
+        // Default is to apply the top and bottom multiplier
+        bool useSmallestMultiplier = eclGrid.getMultzOption() == Opm::PinchMode::ModeEnum::ALL;
+
         // calculate the axis specific centroids of all elements
         std::array<std::vector<DimVector>, dimWorld> axisCentroids;
 
         for (unsigned dimIdx = 0; dimIdx < dimWorld; ++dimIdx)
             axisCentroids[dimIdx].resize(numElements);
 
-        auto elemIt = gridView.template begin</*codim=*/ 0>();
-        const auto& elemEndIt = gridView.template end</*codim=*/ 0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const auto& elem = *elemIt;
-            unsigned elemIdx = elemMapper.index(elem);
-
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int elemIdx = 0; elemIdx < static_cast<int>(numElements); ++elemIdx) {
             // compute the axis specific "centroids" used for the transmissibilities. for
             // consistency with the flow simulator, we use the element centers as
             // computed by opm-parser's Opm::EclipseGrid class for all axes.
@@ -169,27 +176,25 @@ public:
                     axisCentroids[axisIdx][elemIdx][dimIdx] = centroid[dimIdx];
         }
 
-        // reserving some space in the hashmap upfront saves quite a bit of time because
-        // resizes are costly for hashmaps and there would be quite a few of them if we
-        // would not have a rough idea of how large the final map will be (the rough idea
-        // is a conforming Cartesian grid).
-        trans_.clear();
-        trans_.reserve(numElements*3*1.05);
+        // set up the face numbering and allocate the storage for all faces
+        buildFaceTopology_(elemMapper);
 
-        transBoundary_.clear();
+        unsigned numFaces = faceNeighbors_.size();
+        unsigned numBoundaryFaces = boundaryFaceOffsets_.back();
+        faces_.resize(numFaces);
+        transBoundary_.resize(numBoundaryFaces);
 
         // if energy is enabled, let's do the same for the "thermal half transmissibilities"
         if (enableEnergy) {
-            thermalHalfTrans_->clear();
-            thermalHalfTrans_->reserve(numElements*6*1.05);
-
-            thermalHalfTransBoundary_.clear();
+            thermalHalfTrans_->resize(2*numFaces);
+            thermalHalfTransBoundary_.resize(numBoundaryFaces);
         }
 
-        // compute the transmissibilities for all intersections
-        elemIt = gridView.template begin</*codim=*/ 0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const auto& elem = *elemIt;
+        // compute the geometric part of the transmissibilities for all intersections.
+        // every element only writes to the storage of its own faces, so the elements
+        // can be processed concurrently and the result does not depend on the number
+        // of threads.
+        forEachElementParallel_([&](const Element& elem) {
             unsigned elemIdx = elemMapper.index(elem);
 
             auto isIt = gridView.ibegin(elem);
@@ -221,7 +226,7 @@ public:
                     // normally there would be two half-transmissibilities that would be
                     // averaged. on the grid boundary there only is the half
                     // transmissibility of the interior element.
-                    transBoundary_[std::make_pair(elemIdx, boundaryIsIdx)] = transBoundaryIs;
+                    transBoundary_[boundaryFaceOffsets_[elemIdx] + boundaryIsIdx] = transBoundaryIs;
 
                     // for boundary intersections we also need to compute the thermal
                     // half transmissibilities
@@ -235,7 +240,7 @@ public:
                         // the transmissibility with the face area here
                         Scalar thermalHalfTrans = std::abs(n*d)/(d*d);
 
-                        thermalHalfTransBoundary_[std::make_pair(elemIdx, boundaryIsIdx)] =
+                        thermalHalfTransBoundary_[boundaryFaceOffsets_[elemIdx] + boundaryIsIdx] =
                             thermalHalfTrans;
                     }
 
@@ -260,7 +265,7 @@ public:
                     const auto& outPos = intersection.geometry().center();
                     const auto& d = outPos - inPos;
 
-                    (*thermalHalfTrans_)[directionalIsId_(elemIdx, outsideElemIdx)] =
+                    (*thermalHalfTrans_)[directionalFaceIdx_(elemIdx, outsideElemIdx)] =
                         A * (n*d)/(d*d);
                 }
 
@@ -277,11 +282,19 @@ public:
                 int insideFaceIdx  = intersection.indexInInside();
                 int outsideFaceIdx = intersection.indexInOutside();
 
+                int faceIdx = findFace_(elemIdx, outsideElemIdx);
+                assert(faceIdx >= 0);
+                FaceInfo_& face = faces_[faceIdx];
+                face.insideFaceIdx = insideFaceIdx;
+                face.outsideFaceIdx = outsideFaceIdx;
+                face.baseTrans = 0.0;
+                face.mult = 1.0;
+                face.nncDataIdx = -1;
+
                 if (insideFaceIdx == -1) {
                     // NNC. Set zero transmissibility, as it will be
                     // *added to* by applyNncToGridTrans_() later.
                     assert(outsideFaceIdx == -1);
-                    trans_[isId_(elemIdx, outsideElemIdx)] = 0.0;
                     continue;
                 }
 
@@ -325,78 +338,96 @@ public:
 
                 // convert half transmissibilities to full face
                 // transmissibilities using the harmonic mean
-                Scalar trans;
                 if (std::abs(halfTrans1) < 1e-30 || std::abs(halfTrans2) < 1e-30)
                     // avoid division by zero
-                    trans = 0.0;
+                    face.baseTrans = 0.0;
                 else
-                    trans = 1.0 / (1.0/halfTrans1 + 1.0/halfTrans2);
-
-                // apply the full face transmissibility multipliers
-                // for the inside ...
-
-                // The MULTZ needs special case if the option is ALL
-                // Then the smallest multiplier is applied.
-                // Default is to apply the top and bottom multiplier
-                bool useSmallestMultiplier = eclGrid.getMultzOption() == Opm::PinchMode::ModeEnum::ALL;
-                if (useSmallestMultiplier)
-                    applyAllZMultipliers_(trans, insideFaceIdx, insideCartElemIdx, outsideCartElemIdx, transMult, cartDims);
-                else
-                    applyMultipliers_(trans, insideFaceIdx, insideCartElemIdx, transMult);
-                // ... and outside elements
-                applyMultipliers_(trans, outsideFaceIdx, outsideCartElemIdx, transMult);
-
-                // apply the region multipliers (cf. the MULTREGT keyword)
-                Opm::FaceDir::DirEnum faceDir;
-                switch (insideFaceIdx) {
-                case 0:
-                case 1:
-                    faceDir = Opm::FaceDir::XPlus;
-                    break;
-
-                case 2:
-                case 3:
-                    faceDir = Opm::FaceDir::YPlus;
-                    break;
-
-                case 4:
-                case 5:
-                    faceDir = Opm::FaceDir::ZPlus;
-                    break;
-
-                default:
-                    throw std::logic_error("Could not determine a face direction");
-                }
+                    face.baseTrans = 1.0 / (1.0/halfTrans1 + 1.0/halfTrans2);
 
-                trans *= transMult.getRegionMultiplier(insideCartElemIdx,
-                                                       outsideCartElemIdx,
-                                                       faceDir);
-
-                trans_[isId_(elemIdx, outsideElemIdx)] = trans;
+                // the multipliers are applied later by computeFaceTrans_() because they
+                // may change during the simulation (cf. updateMultipliers())
+                face.mult = computeMultiplier_(elemIdx, faceIdx, transMult, useSmallestMultiplier, cartDims);
             }
-        }
-
-        // potentially overwrite and/or modify  transmissibilities based on input from deck
-        updateFromEclState_();
+        });
 
         // Create mapping from global to local index
         const size_t cartesianSize = cartMapper.cartesianSize();
         // reserve memory
         std::vector<int> globalToLocal(cartesianSize, -1);
 
-        // loop over all elements (global grid) and store Cartesian index
-        elemIt = vanguard_.grid().leafGridView().template begin<0>();
-
-        for (; elemIt != elemEndIt; ++elemIt) {
-            int elemIdx = elemMapper.index(*elemIt);
-            int cartElemIdx = vanguard_.cartesianIndexMapper().cartesianIndex(elemIdx);
+        // loop over all elements and store Cartesian index
+        for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx) {
+            int cartElemIdx = cartMapper.cartesianIndex(elemIdx);
             globalToLocal[cartElemIdx] = elemIdx;
         }
+        nncFaceData_.clear();
         applyEditNncToGridTrans_(globalToLocal);
         applyNncToGridTrans_(globalToLocal);
+        nncFaceData_.shrink_to_fit();
 
-        //remove very small non-neighbouring transmissibilities
-        removeSmallNonCartesianTransmissibilities_();
+        // finally, compute the transmissibilities of all faces. this applies the
+        // multipliers, the TRAN[XYZ] keywords as well as NNCs and EDITNNC
+        const auto& properties = eclState.get3DProperties();
+        const auto& inputTranx = properties.getDoubleGridProperty("TRANX");
+        const auto& inputTrany = properties.getDoubleGridProperty("TRANY");
+        const auto& inputTranz = properties.getDoubleGridProperty("TRANZ");
+
+        trans_.resize(numFaces);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int elemIdx = 0; elemIdx < static_cast<int>(numElements); ++elemIdx) {
+            for (unsigned faceIdx = faceOffsets_[elemIdx]; faceIdx < faceOffsets_[elemIdx + 1]; ++faceIdx)
+                trans_[faceIdx] = computeFaceTrans_(elemIdx, faceIdx, inputTranx, inputTrany, inputTranz);
+        }
+    }
+
+    /*!
+     * \brief Re-apply the transmissibility multipliers without recomputing the
+     *        geometric part of the transmissibilities.
+     *
+     * This is only valid if the grid, the permeabilities and the NTG values did not
+     * change since the last call to update(), i.e., if only the multipliers of the
+     * transmissibilities (MULTFLT, MULT[XYZ]-, MULTREGT) were modified by the
+     * schedule. Only the faces whose multiplier has changed are touched.
+     *
+     * \return The number of faces for which the transmissibility has been updated.
+     */
+    unsigned updateMultipliers()
+    {
+        const auto& cartMapper = vanguard_.cartesianIndexMapper();
+        const auto& eclState = vanguard_.eclState();
+        const auto& cartDims = cartMapper.cartesianDimensions();
+        const auto& transMult = eclState.getTransMult();
+        bool useSmallestMultiplier = eclState.getInputGrid().getMultzOption() == Opm::PinchMode::ModeEnum::ALL;
+
+        const auto& properties = eclState.get3DProperties();
+        const auto& inputTranx = properties.getDoubleGridProperty("TRANX");
+        const auto& inputTrany = properties.getDoubleGridProperty("TRANY");
+        const auto& inputTranz = properties.getDoubleGridProperty("TRANZ");
+
+        unsigned numChanged = 0;
+        int numElements = faceOffsets_.size() - 1;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+:numChanged)
+#endif
+        for (int elemIdx = 0; elemIdx < numElements; ++elemIdx) {
+            for (unsigned faceIdx = faceOffsets_[elemIdx]; faceIdx < faceOffsets_[elemIdx + 1]; ++faceIdx) {
+                auto& face = faces_[faceIdx];
+                if (face.insideFaceIdx < 0)
+                    continue; // NNCs are not subject to multipliers
+
+                Scalar mult = computeMultiplier_(elemIdx, faceIdx, transMult, useSmallestMultiplier, cartDims);
+                if (mult == face.mult)
+                    continue;
+
+                face.mult = mult;
+                trans_[faceIdx] = computeFaceTrans_(elemIdx, faceIdx, inputTranx, inputTrany, inputTranz);
+                ++numChanged;
+            }
+        }
+
+        return numChanged;
     }
 
     /*!
@@ -409,13 +440,22 @@ public:
      * \brief Return the transmissibility for the intersection between two elements.
      */
     Scalar transmissibility(unsigned elemIdx1, unsigned elemIdx2) const
-    { return trans_.at(isId_(elemIdx1, elemIdx2)); }
+    {
+        int faceIdx = findFace_(elemIdx1, elemIdx2);
+        if (faceIdx < 0)
+            throw std::out_of_range("Elements "+std::to_string(elemIdx1)+" and "
+                                    +std::to_string(elemIdx2)+" are not connected");
+        return trans_[faceIdx];
+    }
 
     /*!
      * \brief Return the transmissibility for a given boundary segment.
      */
     Scalar transmissibilityBoundary(unsigned elemIdx, unsigned boundaryFaceIdx) const
-    { return transBoundary_.at(std::make_pair(elemIdx, boundaryFaceIdx)); }
+    {
+        assert(boundaryFaceOffsets_[elemIdx] + boundaryFaceIdx < boundaryFaceOffsets_[elemIdx + 1]);
+        return transBoundary_[boundaryFaceOffsets_[elemIdx] + boundaryFaceIdx];
+    }
 
     /*!
      * \brief Return the thermal "half transmissibility" for the intersection between two
@@ -432,40 +472,54 @@ public:
      * cell and the center of the intersection.
      */
     Scalar thermalHalfTrans(unsigned insideElemIdx, unsigned outsideElemIdx) const
-    { return thermalHalfTrans_->at(directionalIsId_(insideElemIdx, outsideElemIdx)); }
+    {
+        int faceIdx = directionalFaceIdx_(insideElemIdx, outsideElemIdx);
+        if (faceIdx < 0)
+            throw std::out_of_range("Elements "+std::to_string(insideElemIdx)+" and "
+                                    +std::to_string(outsideElemIdx)+" are not connected");
+        return (*thermalHalfTrans_)[faceIdx];
+    }
 
     Scalar thermalHalfTransBoundary(unsigned insideElemIdx, unsigned boundaryFaceIdx) const
-    { return thermalHalfTransBoundary_.at(std::make_pair(insideElemIdx, boundaryFaceIdx)); }
+    {
+        assert(boundaryFaceOffsets_[insideElemIdx] + boundaryFaceIdx < boundaryFaceOffsets_[insideElemIdx + 1]);
+        return thermalHalfTransBoundary_[boundaryFaceOffsets_[insideElemIdx] + boundaryFaceIdx];
+    }
 
 private:
-
-    void removeSmallNonCartesianTransmissibilities_()
+    // the data which is required to compute the transmissibility of a face without
+    // having to look at the grid geometry again
+    struct FaceInfo_
     {
-        const auto& cartMapper = vanguard_.cartesianIndexMapper();
-        const auto& cartDims = cartMapper.cartesianDimensions();
-        for (auto&& trans: trans_) {
-            if (trans.second < transmissibilityThreshold_) {
-                const auto& id = trans.first;
-                const auto& elements = isIdReverse_(id);
-                int gc1 = std::min(cartMapper.cartesianIndex(elements.first), cartMapper.cartesianIndex(elements.second));
-                int gc2 = std::max(cartMapper.cartesianIndex(elements.first), cartMapper.cartesianIndex(elements.second));
-
-                // only adjust the NNCs
-                if (gc2 - gc1 == 1 || gc2 - gc1 == cartDims[0] || gc2 - gc1 == cartDims[0]*cartDims[1])
-                    continue;
+        // the transmissibility without any multipliers, TRAN[XYZ], NNC and EDITNNC
+        Scalar baseTrans;
 
-                //remove transmissibilities less than the threshold (by default 1e-6 in the deck's unit system)
-                trans.second = 0.0;
-            }
-        }
-    }
+        // the product of the multipliers which are currently applied
+        Scalar mult;
+
+        // index of the face in the reference element of the element with the lower
+        // and the higher index, -1 for NNCs
+        signed char insideFaceIdx;
+        signed char outsideFaceIdx;
+
+        // index of the NNC and EDITNNC contributions in nncFaceData_, -1 if there
+        // are none. for double precision this fits into the padding of the struct.
+        int nncDataIdx = -1;
+    };
+
+    // NNC and EDITNNC contributions to the transmissibility of a face
+    struct NncFaceData_
+    {
+        Scalar editNncMult = 1.0;
+        Scalar nncTrans = 0.0;
+    };
 
     void applyAllZMultipliers_(Scalar& trans,
                                unsigned insideFaceIdx,
                                unsigned insideCartElemIdx,
                                unsigned outsideCartElemIdx,
                                const Opm::TransMult& transMult,
-                               const std::array<int, dimWorld>& cartDims)
+                               const std::array<int, dimWorld>& cartDims) const
     {
         if (insideFaceIdx > 3) { // top or or bottom
             Scalar mult = 1e20;
@@ -486,77 +540,279 @@ private:
             applyMultipliers_(trans, insideFaceIdx, insideCartElemIdx, transMult);
     }
 
-    void updateFromEclState_()
+    /*!
+     * \brief Compute the product of all multipliers which apply to a face.
+     *
+     * This covers the directional multipliers of the inside and outside cells (i.e.,
+     * MULT[XYZ]- and MULTFLT) as well as the region multipliers (MULTREGT).
+     */
+    Scalar computeMultiplier_(unsigned elemIdx1,
+                              unsigned faceIdx,
+                              const Opm::TransMult& transMult,
+                              bool useSmallestMultiplier,
+                              const std::array<int, dimWorld>& cartDims) const
+    {
+        const auto& cartMapper = vanguard_.cartesianIndexMapper();
+        const auto& face = faces_[faceIdx];
+        unsigned insideCartElemIdx = cartMapper.cartesianIndex(elemIdx1);
+        unsigned outsideCartElemIdx = cartMapper.cartesianIndex(faceNeighbors_[faceIdx]);
+
+        // apply the full face transmissibility multipliers
+        // for the inside ...
+        Scalar mult = 1.0;
+        if (useSmallestMultiplier)
+            applyAllZMultipliers_(mult, face.insideFaceIdx, insideCartElemIdx, outsideCartElemIdx, transMult, cartDims);
+        else
+            applyMultipliers_(mult, face.insideFaceIdx, insideCartElemIdx, transMult);
+        // ... and outside elements
+        applyMultipliers_(mult, face.outsideFaceIdx, outsideCartElemIdx, transMult);
+
+        // apply the region multipliers (cf. the MULTREGT keyword)
+        Opm::FaceDir::DirEnum faceDir;
+        switch (face.insideFaceIdx) {
+        case 0:
+        case 1:
+            faceDir = Opm::FaceDir::XPlus;
+            break;
+
+        case 2:
+        case 3:
+            faceDir = Opm::FaceDir::YPlus;
+            break;
+
+        case 4:
+        case 5:
+            faceDir = Opm::FaceDir::ZPlus;
+            break;
+
+        default:
+            throw std::logic_error("Could not determine a face direction");
+        }
+
+        mult *= transMult.getRegionMultiplier(insideCartElemIdx,
+                                              outsideCartElemIdx,
+                                              faceDir);
+
+        return mult;
+    }
+
+    /*!
+     * \brief Compute the final transmissibility of a face.
+     *
+     * This starts from the cached geometric part of the transmissibility and the
+     * product of its multipliers. Then the transmissibility is potentially overwritten
+     * and/or modified based on the TRAN[XYZ] keywords, and EDITNNC and NNC are applied.
+     * Finally, very small non-neighbouring transmissibilities are removed.
+     */
+    Scalar computeFaceTrans_(unsigned elemIdx1,
+                             unsigned faceIdx,
+                             const Opm::GridProperty<double>& inputTranx,
+                             const Opm::GridProperty<double>& inputTrany,
+                             const Opm::GridProperty<double>& inputTranz) const
     {
-        const auto& gridView = vanguard_.gridView();
         const auto& cartMapper = vanguard_.cartesianIndexMapper();
         const auto& cartDims = cartMapper.cartesianDimensions();
-        const auto& properties = vanguard_.eclState().get3DProperties();
+        const auto& face = faces_[faceIdx];
+
+        Scalar trans = face.baseTrans*face.mult;
+
+        unsigned elemIdx2 = faceNeighbors_[faceIdx];
+        int gc1 = std::min(cartMapper.cartesianIndex(elemIdx1), cartMapper.cartesianIndex(elemIdx2));
+        int gc2 = std::max(cartMapper.cartesianIndex(elemIdx1), cartMapper.cartesianIndex(elemIdx2));
+
+        bool isCartesianNeighbor = true;
+        if (gc2 - gc1 == 1) {
+            if (inputTranx.deckAssigned())
+                // set simulator internal transmissibilities to values from inputTranx
+                trans = inputTranx.iget(gc1);
+            else
+                // Scale transmissibilities with scale factor from inputTranx
+                trans *= inputTranx.iget(gc1);
+        }
+        else if (gc2 - gc1 == cartDims[0]) {
+            if (inputTrany.deckAssigned())
+                // set simulator internal transmissibilities to values from inputTrany
+                trans = inputTrany.iget(gc1);
+            else
+                // Scale transmissibilities with scale factor from inputTrany
+                trans *= inputTrany.iget(gc1);
+        }
+        else if (gc2 - gc1 == cartDims[0]*cartDims[1]) {
+            if (inputTranz.deckAssigned())
+                // set simulator internal transmissibilities to values from inputTranz
+                trans = inputTranz.iget(gc1);
+            else
+                // Scale transmissibilities with scale factor from inputTranz
+                trans *= inputTranz.iget(gc1);
+        }
+        else
+            //else.. We don't support modification of NNC at the moment.
+            isCartesianNeighbor = false;
 
-#if DUNE_VERSION_NEWER(DUNE_GRID, 2,6)
-        ElementMapper elemMapper(gridView, Dune::mcmgElementLayout());
-#else
-        ElementMapper elemMapper(gridView);
+        if (face.nncDataIdx >= 0) {
+            const auto& nncData = nncFaceData_[face.nncDataIdx];
+            trans *= nncData.editNncMult;
+            trans += nncData.nncTrans;
+        }
+
+        //remove transmissibilities less than the threshold (by default 1e-6 in the deck's unit system)
+        if (!isCartesianNeighbor && trans < transmissibilityThreshold_)
+            trans = 0.0;
+
+        return trans;
+    }
+
+    /*!
+     * \brief Return the index of the face between two elements or -1 if the elements
+     *        are not connected.
+     */
+    int findFace_(int elemIdx1, int elemIdx2) const
+    {
+        if (elemIdx1 < 0 || elemIdx2 < 0)
+            return -1;
+
+        if (elemIdx1 > elemIdx2)
+            std::swap(elemIdx1, elemIdx2);
+
+        if (static_cast<unsigned>(elemIdx1) + 1 >= faceOffsets_.size())
+            return -1;
+
+        // the neighbors of each element are sorted, so we can use a binary search
+        auto rowBegin = faceNeighbors_.begin() + faceOffsets_[elemIdx1];
+        auto rowEnd = faceNeighbors_.begin() + faceOffsets_[elemIdx1 + 1];
+        auto neighborIt = std::lower_bound(rowBegin, rowEnd, static_cast<unsigned>(elemIdx2));
+        if (neighborIt == rowEnd || *neighborIt != static_cast<unsigned>(elemIdx2))
+            return -1;
+
+        return neighborIt - faceNeighbors_.begin();
+    }
+
+    /*!
+     * \brief Return the index of the thermal half transmissibility for the direction
+     *        from the inside to the outside element or -1 if the elements are not
+     *        connected.
+     */
+    int directionalFaceIdx_(unsigned insideElemIdx, unsigned outsideElemIdx) const
+    {
+        int faceIdx = findFace_(insideElemIdx, outsideElemIdx);
+        if (faceIdx < 0)
+            return -1;
+
+        return 2*faceIdx + (insideElemIdx > outsideElemIdx ? 1 : 0);
+    }
+
+    /*!
+     * \brief Call a functor for each element of the grid view.
+     *
+     * If OpenMP is enabled, the elements are distributed over all threads and each
+     * element is visited by exactly one of them. Exceptions thrown by the functor are
+     * re-thrown by the calling thread.
+     */
+    template <class Functor>
+    void forEachElementParallel_(const Functor& fn) const
+    {
+        Ewoms::ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(vanguard_.gridView());
+        std::exception_ptr exceptionPtr;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            auto elemIt = threadedElemIt.beginParallel();
+            for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
+                try {
+                    fn(*elemIt);
+                }
+                catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
 #endif
+                    exceptionPtr = std::current_exception();
+                }
+            }
+        }
 
-        const auto& inputTranx = properties.getDoubleGridProperty("TRANX");
-        const auto& inputTrany = properties.getDoubleGridProperty("TRANY");
-        const auto& inputTranz = properties.getDoubleGridProperty("TRANZ");
+        if (exceptionPtr)
+            std::rethrow_exception(exceptionPtr);
+    }
 
-        // compute the transmissibilities for all intersections
-        auto elemIt = gridView.template begin</*codim=*/ 0>();
-        const auto& elemEndIt = gridView.template end</*codim=*/ 0>();
+    /*!
+     * \brief Set up the face numbering.
+     *
+     * The faces are stored in a compressed sparse row fashion: the faces of each
+     * element which connect it to elements with a higher index are stored
+     * consecutively and they are sorted by the index of the neighboring element. The
+     * boundary faces of each element are numbered the same way as by the intersection
+     * iterator. Since this numbering only depends on the grid, it stays the same for
+     * the whole simulation.
+     */
+    void buildFaceTopology_(const ElementMapper& elemMapper)
+    {
+        const auto& gridView = vanguard_.gridView();
+        unsigned numElements = elemMapper.size();
+
+        faceOffsets_.assign(numElements + 1, 0);
+        boundaryFaceOffsets_.assign(numElements + 1, 0);
+
+        // count the number of faces of each element
+        forEachElementParallel_([&](const Element& elem) {
+            unsigned elemIdx = elemMapper.index(elem);
 
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const auto& elem = *elemIt;
             auto isIt = gridView.ibegin(elem);
             const auto& isEndIt = gridView.iend(elem);
             for (; isIt != isEndIt; ++ isIt) {
-                // store intersection, this might be costly
                 const auto& intersection = *isIt;
-                if (!intersection.neighbor())
-                    continue; // intersection is on the domain boundary
-
-                unsigned c1 = elemMapper.index(intersection.inside());
-                unsigned c2 = elemMapper.index(intersection.outside());
+                if (intersection.boundary())
+                    ++ boundaryFaceOffsets_[elemIdx + 1];
+                else if (intersection.neighbor() && elemIdx < elemMapper.index(intersection.outside()))
+                    ++ faceOffsets_[elemIdx + 1];
+            }
+        });
 
-                if (c1 > c2)
-                    continue; // we only need to handle each connection once, thank you.
+        std::partial_sum(faceOffsets_.begin(), faceOffsets_.end(), faceOffsets_.begin());
+        std::partial_sum(boundaryFaceOffsets_.begin(), boundaryFaceOffsets_.end(), boundaryFaceOffsets_.begin());
 
-                auto isId = isId_(c1, c2);
+        // collect the neighbors
+        faceNeighbors_.resize(faceOffsets_.back());
+        std::vector<unsigned> rowSize(numElements, 0);
+        forEachElementParallel_([&](const Element& elem) {
+            unsigned elemIdx = elemMapper.index(elem);
 
-                int gc1 = std::min(cartMapper.cartesianIndex(c1), cartMapper.cartesianIndex(c2));
-                int gc2 = std::max(cartMapper.cartesianIndex(c1), cartMapper.cartesianIndex(c2));
+            auto isIt = gridView.ibegin(elem);
+            const auto& isEndIt = gridView.iend(elem);
+            for (; isIt != isEndIt; ++ isIt) {
+                const auto& intersection = *isIt;
+                if (intersection.boundary() || !intersection.neighbor())
+                    continue;
 
-                if (gc2 - gc1 == 1) {
-                    if (inputTranx.deckAssigned())
-                        // set simulator internal transmissibilities to values from inputTranx
-                        trans_[isId] = inputTranx.iget(gc1);
-                    else
-                        // Scale transmissibilities with scale factor from inputTranx
-                        trans_[isId] *= inputTranx.iget(gc1);
-                }
-                else if (gc2 - gc1 == cartDims[0]) {
-                    if (inputTrany.deckAssigned())
-                        // set simulator internal transmissibilities to values from inputTrany
-                        trans_[isId] = inputTrany.iget(gc1);
-                    else
-                        // Scale transmissibilities with scale factor from inputTrany
-                        trans_[isId] *= inputTrany.iget(gc1);
-                }
-                else if (gc2 - gc1 == cartDims[0]*cartDims[1]) {
-                    if (inputTranz.deckAssigned())
-                        // set simulator internal transmissibilities to values from inputTranz
-                        trans_[isId] = inputTranz.iget(gc1);
-                    else
-                        // Scale transmissibilities with scale factor from inputTranz
-                        trans_[isId] *= inputTranz.iget(gc1);
-                }
-                //else.. We don't support modification of NNC at the moment.
+                unsigned outsideElemIdx = elemMapper.index(intersection.outside());
+                if (elemIdx < outsideElemIdx)
+                    faceNeighbors_[faceOffsets_[elemIdx] + rowSize[elemIdx]++] = outsideElemIdx;
             }
+        });
+
+        // sort the neighbors of each element. two elements might be connected by more
+        // than one intersection, so we also need to get rid of duplicates.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int elemIdx = 0; elemIdx < static_cast<int>(numElements); ++elemIdx) {
+            auto rowBegin = faceNeighbors_.begin() + faceOffsets_[elemIdx];
+            auto rowEnd = faceNeighbors_.begin() + faceOffsets_[elemIdx + 1];
+            std::sort(rowBegin, rowEnd);
+            rowSize[elemIdx] = std::unique(rowBegin, rowEnd) - rowBegin;
         }
-    }
 
+        unsigned numFaces = 0;
+        for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx) {
+            auto rowBegin = faceNeighbors_.begin() + faceOffsets_[elemIdx];
+            faceOffsets_[elemIdx] = numFaces;
+            numFaces = std::copy(rowBegin, rowBegin + rowSize[elemIdx], faceNeighbors_.begin() + numFaces) - faceNeighbors_.begin();
+        }
+        faceOffsets_[numElements] = numFaces;
+        faceNeighbors_.resize(numFaces);
+        faceNeighbors_.shrink_to_fit();
+    }
 
     template <class Intersection>
     void computeFaceProperties(const Intersection& intersection,
@@ -643,9 +899,9 @@ private:
                 continue;
             }
 
-            auto candidate = trans_.find(isId_(low, high));
+            int faceIdx = findFace_(low, high);
 
-            if (candidate == trans_.end())
+            if (faceIdx < 0)
                 // This NNC is not resembled by the grid. Save it for later
                 // processing with local cell values
                 unprocessedNnc.push_back({c1, c2, nncEntry.trans});
@@ -653,14 +909,25 @@ private:
                 // NNC is represented by the grid and might be a neighboring connection
                 // In this case the transmissibilty is added to the value already
                 // set or computed.
-                candidate->second += nncEntry.trans;
+                nncDataOfFace_(faceIdx).nncTrans += nncEntry.trans;
                 processedNnc.push_back({c1, c2, nncEntry.trans});
             }
         }
         return make_tuple(processedNnc, unprocessedNnc);
     }
 
-    /// \brief Multiplies the grid transmissibilities according to EDITNNC.
+    // the NNC and EDITNNC contributions of a face, added if the face does not have any yet
+    NncFaceData_& nncDataOfFace_(unsigned faceIdx)
+    {
+        auto& face = faces_[faceIdx];
+        if (face.nncDataIdx < 0) {
+            face.nncDataIdx = nncFaceData_.size();
+            nncFaceData_.emplace_back();
+        }
+        return nncFaceData_[face.nncDataIdx];
+    }
+
+    /// \brief Records the multipliers of the grid transmissibilities according to EDITNNC.
     void applyEditNncToGridTrans_(const std::vector<int>& globalToLocal)
     {
         const auto& editNnc = vanguard_.eclState().getInputEDITNNC();
@@ -680,8 +947,8 @@ private:
             if (low > high)
                 std::swap(low, high);
 
-            auto candidate = trans_.find(isId_(low, high));
-            if (candidate == trans_.end()) {
+            int faceIdx = findFace_(low, high);
+            if (faceIdx < 0) {
                 std::ostringstream sstr;
                 sstr << "Cannot edit NNC from " << c1 << " to " << c2
                      << " as it does not exist";
@@ -690,8 +957,9 @@ private:
             }
             else {
                 // NNC exists
+                auto& nncFaceData = nncDataOfFace_(faceIdx);
                 while (nnc!= end && c1==nnc->cell1 && c2==nnc->cell2) {
-                    candidate->second *= nnc->trans;
+                    nncFaceData.editNncMult *= nnc->trans;
                     ++nnc;
                 }
             }
@@ -719,7 +987,10 @@ private:
             if (props.hasDeckDoubleGridProperty("PERMZ"))
                 permzData = props.getDoubleGridProperty("PERMZ").getData();
 
-            for (size_t dofIdx = 0; dofIdx < numElem; ++ dofIdx) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+            for (int dofIdx = 0; dofIdx < static_cast<int>(numElem); ++ dofIdx) {
                 unsigned cartesianElemIdx = vanguard_.cartesianIndex(dofIdx);
                 permeability_[dofIdx] = 0.0;
                 permeability_[dofIdx][0][0] = permxData[cartesianElemIdx];
@@ -734,30 +1005,6 @@ private:
                                    "(The PERM{X,Y,Z} keywords are missing)");
     }
 
-    std::uint64_t isId_(std::uint32_t elemIdx1, std::uint32_t elemIdx2) const
-    {
-        std::uint32_t elemAIdx = std::min(elemIdx1, elemIdx2);
-        std::uint64_t elemBIdx = std::max(elemIdx1, elemIdx2);
-
-        return (elemBIdx<<elemIdxShift) + elemAIdx;
-    }
-
-    std::pair<std::uint32_t, std::uint32_t> isIdReverse_(const std::uint64_t& id) const
-    {
-        // Assigning an unsigned integer to a narrower type discards the most significant bits.
-        // See "The C programming language", section A.6.2.
-        // NOTE that the ordering of element A and B may have changed
-        std::uint32_t elemAIdx = id;
-        std::uint32_t elemBIdx = (id - elemAIdx) >> elemIdxShift;
-
-        return std::make_pair(elemAIdx, elemBIdx);
-    }
-
-    std::uint64_t directionalIsId_(std::uint32_t elemIdx1, std::uint32_t elemIdx2) const
-    {
-        return (std::uint64_t(elemIdx1)<<elemIdxShift) + elemIdx2;
-    }
-
     void computeHalfTrans_(Scalar& halfTrans,
                            const DimVector& areaNormal,
                            int faceIdx, // in the reference element that contains the intersection
@@ -874,7 +1121,10 @@ private:
         const auto& cartDims = cartMapper.cartesianDimensions();
         assert(dimWorld > 1);
         const size_t nxny = cartDims[0] * cartDims[1];
-        for (size_t cartesianCellIdx = 0; cartesianCellIdx < ntg.size(); ++cartesianCellIdx) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int cartesianCellIdx = 0; cartesianCellIdx < static_cast<int>(ntg.size()); ++cartesianCellIdx) {
             // use the original ntg values for the inactive cells
             if (!actnum[cartesianCellIdx])
                 continue;
@@ -903,11 +1153,21 @@ private:
     const Vanguard& vanguard_;
     Scalar transmissibilityThreshold_;
     std::vector<DimMatrix> permeability_;
-    std::unordered_map<std::uint64_t, Scalar> trans_;
-    std::map<std::pair<unsigned, unsigned>, Scalar> transBoundary_;
-    std::map<std::pair<unsigned, unsigned>, Scalar> thermalHalfTransBoundary_;
-    Opm::ConditionalStorage<enableEnergy,
-                            std::unordered_map<std::uint64_t, Scalar> > thermalHalfTrans_;
+
+    // the face numbering in compressed sparse row format (see buildFaceTopology_())
+    std::vector<unsigned> faceOffsets_;
+    std::vector<unsigned> faceNeighbors_;
+    std::vector<unsigned> boundaryFaceOffsets_;
+
+    // per face data, indexed by the face index
+    std::vector<FaceInfo_> faces_;
+    std::vector<NncFaceData_> nncFaceData_;
+    std::vector<Scalar> trans_;
+    Opm::ConditionalStorage<enableEnergy, std::vector<Scalar> > thermalHalfTrans_;
+
+    // per boundary face data
+    std::vector<Scalar> transBoundary_;
+    std::vector<Scalar> thermalHalfTransBoundary_;
 };
 
 } // namespace Ewoms
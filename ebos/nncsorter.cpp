@@ -28,8 +28,56 @@
 #include <sstream>
 #include <algorithm>
 #include <iostream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace Ewoms
 {
+namespace
+{
+/// \brief Stable sort which uses all OpenMP threads if available.
+///
+/// The range is split into one chunk per thread, the chunks are sorted
+/// concurrently and then merged pairwise. Since both steps are stable, the
+/// result does not depend on the number of threads.
+template <class Iterator, class Compare>
+void parallelStableSort(Iterator begin, Iterator end, Compare comp)
+{
+#ifdef _OPENMP
+    const std::ptrdiff_t size = end - begin;
+    const int numChunks = omp_get_max_threads();
+    // not worth the overhead for small ranges
+    if (numChunks < 2 || size < 8192) {
+        std::stable_sort(begin, end, comp);
+        return;
+    }
+
+    std::vector<std::ptrdiff_t> chunkBegin(numChunks + 1);
+    for (int chunkIdx = 0; chunkIdx <= numChunks; ++chunkIdx)
+        chunkBegin[chunkIdx] = size*chunkIdx/numChunks;
+
+#pragma omp parallel for schedule(static)
+    for (int chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx)
+        std::stable_sort(begin + chunkBegin[chunkIdx], begin + chunkBegin[chunkIdx + 1], comp);
+
+    for (int width = 1; width < numChunks; width *= 2) {
+#pragma omp parallel for schedule(static)
+        for (int chunkIdx = 0; chunkIdx < numChunks - width; chunkIdx += 2*width) {
+            const int lastChunkIdx = std::min(chunkIdx + 2*width, numChunks);
+            std::inplace_merge(begin + chunkBegin[chunkIdx],
+                               begin + chunkBegin[chunkIdx + width],
+                               begin + chunkBegin[lastChunkIdx],
+                               comp);
+        }
+    }
+#else
+    std::stable_sort(begin, end, comp);
+#endif
+}
+} // end anonymous namespace
+
 std::vector<Opm::NNCdata> sortNncAndApplyEditnnc(const std::vector<Opm::NNCdata>& nncDataIn, std::vector<Opm::NNCdata> editnncData,
                                                  bool log )
 {
@@ -54,41 +102,40 @@ std::vector<Opm::NNCdata> sortNncAndApplyEditnnc(const std::vector<Opm::NNCdata>
     std::vector<Opm::NNCdata> nncData(nncDataIn);
     std::transform(nncData.begin(), nncData.end(), nncData.begin(), makeCell1LessCell2);
     std::transform(editnncData.begin(), editnncData.end(), editnncData.begin(), makeCell1LessCell2);
-    std::sort(nncData.begin(), nncData.end(), nncLess);
-    auto candidate = nncData.begin();
 
+    // Sort both sequences. This allows to apply the EDITNNC entries by a single
+    // merge-like pass over the NNCs. Since the sort is stable, EDITNNC entries for
+    // the same pair of cells are applied in the order given in the deck.
+    parallelStableSort(nncData.begin(), nncData.end(), nncLess);
+    parallelStableSort(editnncData.begin(), editnncData.end(), nncLess);
+
+    auto candidate = nncData.begin();
     for (const auto& edit: editnncData) {
-        auto printNncWarning =
-            [](int c1, int c2) {
+        // the EDITNNC entries are sorted, so the first matching NNC cannot be located
+        // before the one of the previous entry.
+        candidate = std::lower_bound(candidate, nncData.end(), edit, nncLess);
+
+        if (candidate == nncData.end()
+            || candidate->cell1 != edit.cell1
+            || candidate->cell2 != edit.cell2)
+        {
+            if (log) {
                 std::ostringstream sstr;
-                sstr << "Cannot edit NNC from " << c1 << " to " << c2
+                sstr << "Cannot edit NNC from " << edit.cell1 << " to " << edit.cell2
                      << " as it does not exist";
                 Opm::OpmLog::warning(sstr.str());
-            };
-        if (candidate == nncData.end() && log) {
-            // no more NNCs left
-            printNncWarning(edit.cell1, edit.cell2);
-            continue;
-        }
-        if (candidate->cell1 != edit.cell1 || candidate->cell2 != edit.cell2) {
-            candidate = std::lower_bound(nncData.begin(), nncData.end(), Opm::NNCdata(edit.cell1, edit.cell2, 0), nncLess);
-            if (candidate == nncData.end() && log) {
-                // no more NNCs left
-                printNncWarning(edit.cell1, edit.cell2);
-                continue;
             }
+            continue;
         }
-        auto firstCandidate = candidate;
-        while (candidate != nncData.end()
-               && candidate->cell1 == edit.cell1
-               && candidate->cell2 == edit.cell2)
+
+        // the candidate is kept at the first match so that the next EDITNNC entry for
+        // the same pair also catches all NNCs of it.
+        for (auto nncIt = candidate;
+             nncIt != nncData.end() && nncIt->cell1 == edit.cell1 && nncIt->cell2 == edit.cell2;
+             ++nncIt)
         {
-            candidate->trans *= edit.trans;
-            ++candidate;
+            nncIt->trans *= edit.trans;
         }
-        // start with first match in next iteration to catch case where next
-        // EDITNNC is for same pair.
-        candidate = firstCandidate;
     }
     return nncData;
 }
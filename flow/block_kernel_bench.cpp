@@ -0,0 +1,168 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Compare the sparse matrix-vector product of a matrix of MatrixBlock,
+// which uses the block kernels of Dune::Detail::BlockKernels, with the
+// same product for a matrix of plain FieldMatrix blocks, which uses the
+// generic DenseMatrix code.
+//
+// Usage: block_kernel_bench [--products=<n>] [<cells in each direction>]
+//
+// The matrices have the pattern of a two-point flux discretization on a
+// structured n x n x n grid, 40 x 40 x 40 by default, and the time of
+// 100 products is reported for the block sizes 1 to 4.
+
+#include "config.h"
+
+#include <opm/simulators/linalg/MatrixBlock.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/timer.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+template <class Matrix>
+Matrix gridMatrix(const int n)
+{
+    const int numCells = n * n * n;
+    Matrix A(numCells, numCells, 7 * numCells, Matrix::row_wise);
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        const int cell = row.index();
+        const int i = cell % n;
+        const int j = (cell / n) % n;
+        const int k = cell / (n * n);
+        if (k > 0) {
+            row.insert(cell - n * n);
+        }
+        if (j > 0) {
+            row.insert(cell - n);
+        }
+        if (i > 0) {
+            row.insert(cell - 1);
+        }
+        row.insert(cell);
+        if (i < n - 1) {
+            row.insert(cell + 1);
+        }
+        if (j < n - 1) {
+            row.insert(cell + n);
+        }
+        if (k < n - 1) {
+            row.insert(cell + n * n);
+        }
+    }
+    for (auto row = A.begin(); row != A.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            for (std::size_t ii = 0; ii < col->N(); ++ii) {
+                for (std::size_t jj = 0; jj < col->M(); ++jj) {
+                    (*col)[ii][jj] = std::sin(1.0 + 0.37 * row.index() + 1.3 * col.index() + 2.1 * (ii * col->M() + jj));
+                }
+            }
+        }
+    }
+    return A;
+}
+
+template <class Matrix, class Vector>
+double timeProducts(const Matrix& A, const Vector& x, Vector& y, const int products)
+{
+    Dune::Timer timer;
+    for (int p = 0; p < products; ++p) {
+        A.mv(x, y);
+    }
+    return timer.stop();
+}
+
+template <int bs>
+bool benchmark(const int n, const int products)
+{
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, bs>>;
+    using KernelMatrix = Dune::BCRSMatrix<Dune::MatrixBlock<double, bs, bs>>;
+    using GenericMatrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, bs, bs>>;
+
+    const KernelMatrix kernelA = gridMatrix<KernelMatrix>(n);
+    const GenericMatrix genericA = gridMatrix<GenericMatrix>(n);
+    Vector x(kernelA.N());
+    for (std::size_t cell = 0; cell < x.size(); ++cell) {
+        for (int k = 0; k < bs; ++k) {
+            x[cell][k] = std::cos(cell + 0.5 * k);
+        }
+    }
+    Vector yKernel(x.size());
+    Vector yGeneric(x.size());
+
+    // One product each first, so that both time warm caches.
+    kernelA.mv(x, yKernel);
+    genericA.mv(x, yGeneric);
+    const double kernelTime = timeProducts(kernelA, x, yKernel, products);
+    const double genericTime = timeProducts(genericA, x, yGeneric, products);
+
+    double diff = 0.0;
+    for (std::size_t cell = 0; cell < x.size(); ++cell) {
+        for (int k = 0; k < bs; ++k) {
+            diff = std::max(diff, std::abs(yKernel[cell][k] - yGeneric[cell][k]));
+        }
+    }
+
+    std::cout << std::setw(6) << bs << std::fixed << std::setprecision(6)
+              << std::setw(14) << kernelTime << std::setw(14) << genericTime
+              << std::setprecision(2) << std::setw(10) << genericTime / kernelTime
+              << std::scientific << std::setw(14) << diff << "\n";
+    return diff < 1e-12;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    int products = 100;
+    int n = 40;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.compare(0, 11, "--products=") == 0) {
+            products = std::max(std::stoi(arg.substr(11)), 1);
+        } else if (arg == "--help" || arg == "-h") {
+            std::cerr << "Usage: " << argv[0] << " [--products=<n>] [<cells in each direction>]\n";
+            return EXIT_SUCCESS;
+        } else {
+            n = std::max(std::stoi(arg), 1);
+        }
+    }
+
+    std::cout << n * n * n << " cells, " << products << " products\n"
+              << std::setw(6) << "block" << std::setw(14) << "kernel [s]"
+              << std::setw(14) << "generic [s]" << std::setw(10) << "speedup"
+              << std::setw(14) << "max diff" << "\n";
+    bool ok = benchmark<1>(n, products);
+    ok = benchmark<2>(n, products) && ok;
+    ok = benchmark<3>(n, products) && ok;
+    ok = benchmark<4>(n, products) && ok;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,233 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Replay linear systems written with --linear-solver-dump-prefix against a
+// FlexibleSolver configuration, and report setup time, solve time and
+// iterations for each system.
+//
+// Usage: flow_linsolve_bench [--config=<options.json>] [--repeat=<n>] [--ilu-reorder-rcm]
+//                            <system.opmls>...
+//
+// Without --config the default tree of setupPropertyTree() is used.
+// --ilu-reorder-rcm makes the ILU0 preconditioner (the fine smoother of CPR)
+// use the reverse Cuthill-McKee ordering. The region keys of the cells are
+// not part of the dumped systems, so the ordering is not clustered here. The CPR
+// weights stored with a system are used by the CPR preconditioners instead of
+// recomputed ones, so the replay sees the weights of the simulator run.
+
+#include "config.h"
+
+#include <dune/common/version.hh>
+
+#include <cstdlib>
+#include <iostream>
+
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
+
+#include <opm/simulators/linalg/FlexibleSolver.hpp>
+#include <opm/simulators/linalg/LinearSystemIO.hpp>
+#include <opm/simulators/linalg/PreconditionerSetupData.hpp>
+#include <opm/simulators/linalg/setupPropertyTree.hpp>
+#include <opm/simulators/linalg/twolevelmethodcpr.hh>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/timer.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct BenchResult
+{
+    double setupTime = 0.0;
+    double solveTime = 0.0;
+    double cprSetupTime = 0.0;
+    double cprApplyTime = 0.0;
+    int iterations = 0;
+    bool converged = true;
+};
+
+template <int bz>
+BenchResult benchmark(const boost::property_tree::ptree& prm, const std::string& filename, int repeat)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, bz, bz>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, bz>>;
+
+    Matrix matrix;
+    Vector rhs;
+    Vector weights;
+    Opm::readLinearSystem(filename, matrix, rhs, weights);
+    std::vector<double> cprWeights;
+    cprWeights.reserve(weights.size() * bz);
+    for (const auto& block : weights) {
+        cprWeights.insert(cprWeights.end(), block.begin(), block.end());
+    }
+
+    BenchResult result;
+    for (int run = 0; run < repeat; ++run) {
+        // Fresh setup data in every run, such that each setup starts from scratch.
+        auto setupData = std::make_shared<Opm::PreconditionerSetupData>();
+        setupData->cprWeights = cprWeights;
+        Dune::Timer timer;
+        Dune::FlexibleSolver<Matrix, Vector> solver(prm, matrix, setupData);
+        result.setupTime += timer.stop();
+
+        Vector x(rhs.size());
+        x = 0.0;
+        Vector b(rhs);
+        Dune::InverseOperatorResult res;
+        timer.reset();
+        timer.start();
+        solver.apply(x, b, res);
+        result.solveTime += timer.stop();
+        result.iterations += res.iterations;
+        result.converged = result.converged && res.converged;
+
+        auto* timed = dynamic_cast<Dune::Amg::TwoLevelMethodTimingsProvider*>(&solver.preconditioner());
+        if (timed) {
+            const auto timings = timed->takeTimings();
+            result.cprSetupTime += timings.setup;
+            result.cprApplyTime += timings.apply;
+        }
+    }
+    result.setupTime /= repeat;
+    result.solveTime /= repeat;
+    result.cprSetupTime /= repeat;
+    result.cprApplyTime /= repeat;
+    result.iterations /= repeat;
+    return result;
+}
+
+BenchResult benchmark(const boost::property_tree::ptree& prm, const std::string& filename, int repeat)
+{
+    const int bz = Opm::readLinearSystemBlockSize(filename);
+    switch (bz) {
+    case 1:
+        return benchmark<1>(prm, filename, repeat);
+    case 2:
+        return benchmark<2>(prm, filename, repeat);
+    case 3:
+        return benchmark<3>(prm, filename, repeat);
+    case 4:
+        return benchmark<4>(prm, filename, repeat);
+    default:
+        throw std::runtime_error("Unsupported block size " + std::to_string(bz) + " in " + filename);
+    }
+}
+
+void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program
+              << " [--config=<options.json>] [--repeat=<n>] [--ilu-reorder-rcm] <system.opmls>...\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    std::string configFile;
+    int repeat = 1;
+    bool reorderRcm = false;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.compare(0, 9, "--config=") == 0) {
+            configFile = arg.substr(9);
+        } else if (arg.compare(0, 9, "--repeat=") == 0) {
+            repeat = std::max(std::stoi(arg.substr(9)), 1);
+        } else if (arg == "--ilu-reorder-rcm") {
+            reorderRcm = true;
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return EXIT_SUCCESS;
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    boost::property_tree::ptree prm;
+    if (configFile.empty()) {
+        prm = Opm::setupPropertyTree(Opm::FlowLinearSolverParameters());
+    } else {
+        boost::property_tree::read_json(configFile, prm);
+    }
+    if (reorderRcm) {
+        const auto type = prm.get<std::string>("preconditioner.type");
+        const bool cpr = type == "cpr" || type == "cprt";
+        prm.put(cpr ? "preconditioner.finesmoother.reorder_rcm" : "preconditioner.reorder_rcm", true);
+    }
+
+    std::cout << std::left << std::setw(40) << "system" << std::right
+              << std::setw(12) << "setup [s]" << std::setw(12) << "solve [s]"
+              << std::setw(12) << "cpr setup" << std::setw(12) << "cpr apply"
+              << std::setw(8) << "iter" << "\n";
+
+    BenchResult total;
+    bool ok = true;
+    for (const auto& file : files) {
+        try {
+            const BenchResult r = benchmark(prm, file, repeat);
+            std::cout << std::left << std::setw(40) << file << std::right << std::fixed << std::setprecision(4)
+                      << std::setw(12) << r.setupTime << std::setw(12) << r.solveTime
+                      << std::setw(12) << r.cprSetupTime << std::setw(12) << r.cprApplyTime
+                      << std::setw(8) << r.iterations << (r.converged ? "" : "  (not converged)") << "\n";
+            total.setupTime += r.setupTime;
+            total.solveTime += r.solveTime;
+            total.cprSetupTime += r.cprSetupTime;
+            total.cprApplyTime += r.cprApplyTime;
+            total.iterations += r.iterations;
+            total.converged = total.converged && r.converged;
+        } catch (const std::exception& e) {
+            std::cerr << file << ": " << e.what() << std::endl;
+            ok = false;
+        }
+    }
+    std::cout << std::left << std::setw(40) << "total" << std::right << std::fixed << std::setprecision(4)
+              << std::setw(12) << total.setupTime << std::setw(12) << total.solveTime
+              << std::setw(12) << total.cprSetupTime << std::setw(12) << total.cprApplyTime
+              << std::setw(8) << total.iterations << std::endl;
+
+    return ok && total.converged ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#else
+
+int main()
+{
+    std::cerr << "flow_linsolve_bench requires dune-istl 2.6 or newer." << std::endl;
+    return EXIT_FAILURE;
+}
+
+#endif
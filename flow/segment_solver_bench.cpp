@@ -0,0 +1,203 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Compare the SegmentTreeSolver used for the segment systems of
+// multisegment wells with the UMFPack solve of mswellhelpers::invDXDirect(),
+// for synthetic wells with a main stem and laterals.
+//
+// Usage: segment_solver_bench [--solves=<n>] [<number of segments>...]
+//
+// For each well the time of one factorization followed by n solves is
+// reported, as in a linear solve where apply() is called once per
+// iteration. The default is 20 solves for wells with 50 to 2000 segments.
+
+#include "config.h"
+
+#include <opm/simulators/wells/SegmentTreeSolver.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/timer.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/solver.hh>
+#if HAVE_UMFPACK
+#include <dune/istl/umfpack.hh>
+#endif // HAVE_UMFPACK
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr int numWellEq = 4;
+using Block = Dune::FieldMatrix<double, numWellEq, numWellEq>;
+using Matrix = Dune::BCRSMatrix<Block>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, numWellEq>>;
+
+// A main stem holding half of the segments, and laterals of 25 segments
+// branching off it.
+std::vector<int> wellOutlets(const int numSeg)
+{
+    const int stem = std::max(numSeg / 2, 1);
+    std::vector<int> outlets(numSeg);
+    outlets[0] = -1;
+    for (int seg = 1; seg < numSeg; ++seg) {
+        const int lateralPos = (seg - stem) % 25;
+        if (seg < stem) {
+            outlets[seg] = seg - 1;
+        } else if (lateralPos == 0) {
+            outlets[seg] = (seg * 7) % stem;
+        } else {
+            outlets[seg] = seg - 1;
+        }
+    }
+    return outlets;
+}
+
+Matrix segmentMatrix(const std::vector<int>& outlets)
+{
+    const int numSeg = outlets.size();
+    Matrix D(numSeg, numSeg, Matrix::random);
+    std::vector<int> rowSize(numSeg, 1);
+    for (int seg = 0; seg < numSeg; ++seg) {
+        if (outlets[seg] >= 0) {
+            ++rowSize[seg];
+            ++rowSize[outlets[seg]];
+        }
+    }
+    for (int seg = 0; seg < numSeg; ++seg) {
+        D.setrowsize(seg, rowSize[seg]);
+    }
+    D.endrowsizes();
+    for (int seg = 0; seg < numSeg; ++seg) {
+        D.addindex(seg, seg);
+        if (outlets[seg] >= 0) {
+            D.addindex(seg, outlets[seg]);
+            D.addindex(outlets[seg], seg);
+        }
+    }
+    D.endindices();
+    for (auto row = D.begin(); row != D.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            for (int i = 0; i < numWellEq; ++i) {
+                for (int j = 0; j < numWellEq; ++j) {
+                    (*col)[i][j] = std::sin(1.0 + 0.37 * row.index() + 1.3 * col.index() + 2.1 * (i * numWellEq + j));
+                }
+            }
+            if (row.index() == col.index()) {
+                for (int i = 0; i < numWellEq; ++i) {
+                    (*col)[i][i] += 4.0;
+                }
+            }
+        }
+    }
+    return D;
+}
+
+#if HAVE_UMFPACK
+double maxDifference(const Vector& a, const Vector& b)
+{
+    double diff = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        for (int k = 0; k < numWellEq; ++k) {
+            diff = std::max(diff, std::abs(a[i][k] - b[i][k]));
+        }
+    }
+    return diff;
+}
+#endif // HAVE_UMFPACK
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    int solves = 20;
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.compare(0, 9, "--solves=") == 0) {
+            solves = std::max(std::stoi(arg.substr(9)), 1);
+        } else if (arg == "--help" || arg == "-h") {
+            std::cerr << "Usage: " << argv[0] << " [--solves=<n>] [<number of segments>...]\n";
+            return EXIT_SUCCESS;
+        } else {
+            sizes.push_back(std::stoi(arg));
+        }
+    }
+    if (sizes.empty()) {
+        sizes = {50, 100, 200, 500, 1000, 2000};
+    }
+
+    std::cout << std::setw(10) << "segments" << std::setw(14) << "tree [s]"
+              << std::setw(14) << "umfpack [s]" << std::setw(14) << "max diff" << "\n";
+    bool ok = true;
+    for (const int numSeg : sizes) {
+        const auto outlets = wellOutlets(numSeg);
+        const Matrix D = segmentMatrix(outlets);
+        Vector b(numSeg);
+        for (int seg = 0; seg < numSeg; ++seg) {
+            for (int k = 0; k < numWellEq; ++k) {
+                b[seg][k] = std::cos(seg + 0.5 * k);
+            }
+        }
+
+        Dune::Timer timer;
+        Opm::SegmentTreeSolver<double, numWellEq> solver;
+        solver.setStructure(outlets);
+        Vector xTree(numSeg);
+        if (!solver.factorize(D)) {
+            std::cerr << numSeg << " segments: singular pivot block" << std::endl;
+            ok = false;
+            continue;
+        }
+        for (int s = 0; s < solves; ++s) {
+            solver.solve(b, xTree);
+        }
+        const double treeTime = timer.stop();
+
+        std::cout << std::setw(10) << numSeg << std::fixed << std::setprecision(6)
+                  << std::setw(14) << treeTime;
+#if HAVE_UMFPACK
+        // invDXDirect() factorizes D for each solve.
+        timer.reset();
+        timer.start();
+        Vector xUmf(numSeg);
+        for (int s = 0; s < solves; ++s) {
+            Dune::UMFPack<Matrix> umfpack(D, 0);
+            Vector rhs(b);
+            Dune::InverseOperatorResult res;
+            umfpack.apply(xUmf, rhs, res);
+        }
+        const double umfTime = timer.stop();
+        std::cout << std::setw(14) << umfTime << std::scientific << std::setprecision(2)
+                  << std::setw(14) << maxDifference(xTree, xUmf);
+#else
+        std::cout << std::setw(14) << "-" << std::setw(14) << "-";
+#endif // HAVE_UMFPACK
+        std::cout << "\n";
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,313 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Compare the compile-time sized well equation types of StandardWell
+// (DenseAd::Evaluation, FieldMatrix and FieldVector) with the run-time
+// sized fallback (DenseAd::DynamicEvaluation, DynamicMatrix and
+// DynamicVector) on a synthetic model with many black-oil wells.
+//
+// Usage: well_eval_bench [--repeat=<n>] [<number of wells> [<perforations per well>]]
+//
+// The assembly mimics StandardWell::assembleWellEq(): for every perforation
+// the component rates are evaluated with AD and their derivatives are
+// written into the B, C and D blocks of the well. The apply mimics
+// StandardWell::apply(), i.e. Ax -= C^T D^-1 B x, once per well. The
+// defaults are 1000 wells with 20 perforations each and 10 repetitions.
+
+#include "config.h"
+
+#include <opm/material/densead/DynamicEvaluation.hpp>
+#include <opm/material/densead/Evaluation.hpp>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/timer.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr int numEq = 3;
+constexpr int numWellEq = numEq + 1;
+constexpr int numDerivatives = numEq + numWellEq;
+
+using Vector = Dune::BlockVector<Dune::FieldVector<double, numEq>>;
+
+// The types of StandardWell without polymer molecular weight.
+struct StaticTypes
+{
+    using EvalWell = Opm::DenseAd::Evaluation<double, numDerivatives>;
+    using VectorBlockWell = Dune::FieldVector<double, numWellEq>;
+    using DiagBlock = Dune::FieldMatrix<double, numWellEq, numWellEq>;
+    using OffDiagBlock = Dune::FieldMatrix<double, numWellEq, numEq>;
+
+    static EvalWell constant(const double value)
+    {
+        return EvalWell(value);
+    }
+
+    static EvalWell variable(const double value, const int varPos)
+    {
+        return EvalWell::createVariable(value, varPos);
+    }
+
+    template <class Block>
+    static void resize(Block&, int, int)
+    {
+    }
+
+    static void resize(VectorBlockWell&, int)
+    {
+    }
+};
+
+// The run-time sized fallback of StandardWell.
+struct DynamicTypes
+{
+    using EvalWell = Opm::DenseAd::DynamicEvaluation<double, numDerivatives + 1>;
+    using VectorBlockWell = Dune::DynamicVector<double>;
+    using DiagBlock = Dune::DynamicMatrix<double>;
+    using OffDiagBlock = Dune::DynamicMatrix<double>;
+
+    static EvalWell constant(const double value)
+    {
+        return EvalWell(numDerivatives, value);
+    }
+
+    static EvalWell variable(const double value, const int varPos)
+    {
+        return EvalWell::createVariable(numDerivatives, value, varPos);
+    }
+
+    static void resize(Dune::DynamicMatrix<double>& block, const int rows, const int cols)
+    {
+        block.resize(rows, cols);
+    }
+
+    static void resize(VectorBlockWell& block, const int size)
+    {
+        block.resize(size);
+    }
+};
+
+template <class Types>
+class SyntheticWell
+{
+public:
+    using EvalWell = typename Types::EvalWell;
+    using BVectorWell = Dune::BlockVector<typename Types::VectorBlockWell>;
+    using DiagMatWell = Dune::BCRSMatrix<typename Types::DiagBlock>;
+    using OffDiagMatWell = Dune::BCRSMatrix<typename Types::OffDiagBlock>;
+
+    SyntheticWell(const int wellIdx, const int numPerfs, const int numCells)
+        : wellIdx_(wellIdx)
+    {
+        for (int perf = 0; perf < numPerfs; ++perf) {
+            cells_.push_back((wellIdx * numPerfs + perf) % numCells);
+            trans_.push_back(1.0 + 0.1 * std::sin(wellIdx + 0.3 * perf));
+        }
+        std::sort(cells_.begin(), cells_.end());
+        cells_.erase(std::unique(cells_.begin(), cells_.end()), cells_.end());
+
+        invD_.setBuildMode(DiagMatWell::row_wise);
+        invD_.setSize(1, 1, 1);
+        for (auto row = invD_.createbegin(); row != invD_.createend(); ++row) {
+            row.insert(0);
+        }
+        for (auto* M : {&B_, &C_}) {
+            M->setBuildMode(OffDiagMatWell::row_wise);
+            M->setSize(1, numCells, cells_.size());
+            for (auto row = M->createbegin(); row != M->createend(); ++row) {
+                for (const int cell : cells_) {
+                    row.insert(cell);
+                }
+            }
+        }
+        Types::resize(invD_[0][0], numWellEq, numWellEq);
+        for (const int cell : cells_) {
+            Types::resize(B_[0][cell], numWellEq, numEq);
+            Types::resize(C_[0][cell], numWellEq, numEq);
+        }
+        resWell_.resize(1);
+        Types::resize(resWell_[0], numWellEq);
+        Bx_.resize(1);
+        Types::resize(Bx_[0], numWellEq);
+        invDBx_.resize(1);
+        Types::resize(invDBx_[0], numWellEq);
+    }
+
+    void assemble(const Vector& cellPressures)
+    {
+        B_ = 0.0;
+        C_ = 0.0;
+        invD_ = 0.0;
+        resWell_ = 0.0;
+
+        // the well variables: total rate, two fractions and the bottom hole pressure
+        std::array<EvalWell, numWellEq> wellVars;
+        for (int i = 0; i < numWellEq; ++i) {
+            wellVars[i] = Types::variable(0.1 * (i + 1) + 1e-3 * wellIdx_, numEq + i);
+        }
+        const EvalWell& bhp = wellVars[numWellEq - 1];
+
+        for (std::size_t perf = 0; perf < cells_.size(); ++perf) {
+            const int cell = cells_[perf];
+            // the cell variables: pressure and two saturations
+            std::array<EvalWell, numEq> cellVars;
+            for (int pv = 0; pv < numEq; ++pv) {
+                cellVars[pv] = Types::variable(cellPressures[cell][pv], pv);
+            }
+            const EvalWell drawdown = cellVars[0] - bhp - Types::constant(0.01 * perf);
+            for (int comp = 0; comp < numEq; ++comp) {
+                const EvalWell mob = cellVars[(comp + 1) % numEq] * cellVars[(comp + 1) % numEq] + Types::constant(0.1);
+                const EvalWell cq = trans_[perf] * mob * drawdown * wellVars[comp % (numWellEq - 1)];
+
+                resWell_[0][comp] += cq.value();
+                for (int pv = 0; pv < numWellEq; ++pv) {
+                    C_[0][cell][pv][comp] -= cq.derivative(pv + numEq);
+                    invD_[0][0][comp][pv] += cq.derivative(pv + numEq);
+                }
+                for (int pv = 0; pv < numEq; ++pv) {
+                    B_[0][cell][comp][pv] += cq.derivative(pv);
+                }
+            }
+        }
+        // the control equation and a well conditioned D
+        for (int i = 0; i < numWellEq; ++i) {
+            invD_[0][0][i][i] += 10.0 * (cells_.size() + 1);
+        }
+        invD_[0][0].invert();
+    }
+
+    // Ax -= C^T D^-1 B x
+    void apply(const Vector& x, Vector& Ax)
+    {
+        B_.mv(x, Bx_);
+        invD_.mv(Bx_, invDBx_);
+        C_.mmtv(invDBx_, Ax);
+    }
+
+private:
+    int wellIdx_;
+    std::vector<int> cells_;
+    std::vector<double> trans_;
+    OffDiagMatWell B_;
+    OffDiagMatWell C_;
+    DiagMatWell invD_;
+    BVectorWell resWell_;
+    BVectorWell Bx_;
+    BVectorWell invDBx_;
+};
+
+struct BenchResult
+{
+    double assembleTime = 0.0;
+    double applyTime = 0.0;
+    Vector Ax;
+};
+
+template <class Types>
+BenchResult benchmark(const int numWells, const int numPerfs, const int repeat)
+{
+    const int numCells = numWells * numPerfs;
+    std::vector<SyntheticWell<Types>> wells;
+    wells.reserve(numWells);
+    for (int w = 0; w < numWells; ++w) {
+        wells.emplace_back(w, numPerfs, numCells);
+    }
+    Vector x(numCells);
+    for (int cell = 0; cell < numCells; ++cell) {
+        for (int k = 0; k < numEq; ++k) {
+            x[cell][k] = 1.0 + 0.5 * std::cos(cell + 0.7 * k);
+        }
+    }
+
+    BenchResult result;
+    result.Ax.resize(numCells);
+    Dune::Timer timer;
+    for (int r = 0; r < repeat; ++r) {
+        for (auto& well : wells) {
+            well.assemble(x);
+        }
+    }
+    result.assembleTime = timer.stop();
+
+    timer.reset();
+    timer.start();
+    for (int r = 0; r < repeat; ++r) {
+        result.Ax = 0.0;
+        for (auto& well : wells) {
+            well.apply(x, result.Ax);
+        }
+    }
+    result.applyTime = timer.stop();
+    return result;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    int repeat = 10;
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.compare(0, 9, "--repeat=") == 0) {
+            repeat = std::max(std::stoi(arg.substr(9)), 1);
+        } else if (arg == "--help" || arg == "-h") {
+            std::cerr << "Usage: " << argv[0] << " [--repeat=<n>] [<number of wells> [<perforations per well>]]\n";
+            return EXIT_SUCCESS;
+        } else {
+            sizes.push_back(std::max(std::stoi(arg), 1));
+        }
+    }
+    const int numWells = sizes.size() > 0 ? sizes[0] : 1000;
+    const int numPerfs = sizes.size() > 1 ? sizes[1] : 20;
+
+    const BenchResult fixed = benchmark<StaticTypes>(numWells, numPerfs, repeat);
+    const BenchResult dynamic = benchmark<DynamicTypes>(numWells, numPerfs, repeat);
+
+    double diff = 0.0;
+    for (std::size_t cell = 0; cell < fixed.Ax.size(); ++cell) {
+        for (int k = 0; k < numEq; ++k) {
+            diff = std::max(diff, std::abs(fixed.Ax[cell][k] - dynamic.Ax[cell][k]));
+        }
+    }
+
+    std::cout << numWells << " wells, " << numPerfs << " perforations, " << repeat << " repetitions\n"
+              << std::setw(10) << "" << std::setw(16) << "assemble [s]" << std::setw(14) << "apply [s]" << "\n"
+              << std::fixed << std::setprecision(6)
+              << std::setw(10) << "static" << std::setw(16) << fixed.assembleTime << std::setw(14) << fixed.applyTime << "\n"
+              << std::setw(10) << "dynamic" << std::setw(16) << dynamic.assembleTime << std::setw(14) << dynamic.applyTime << "\n"
+              << "max diff " << std::scientific << std::setprecision(2) << diff << std::endl;
+
+    return diff < 1e-10 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
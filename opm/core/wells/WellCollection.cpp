@@ -87,7 +87,7 @@ namespace Opm
         }
         parent_as_group->addChild(child);
 
-        leaf_nodes_.push_back(static_cast<WellNode*>(child.get()));
+        addLeafNode(static_cast<WellNode*>(child.get()));
 
         child->setParent(parent);
     }
@@ -123,17 +123,21 @@ namespace Opm
 
     WellNode& WellCollection::findWellNode(const std::string& name) const
     {
-        auto well_node = std::find_if(leaf_nodes_.begin(), leaf_nodes_.end(),
-                    [&] ( WellNode* w) {
-                    return w->name() == name;
-                    });
+        auto well_node = leaf_nodes_by_name_.find(name);
 
         // Does not find the well
-        if (well_node == leaf_nodes_.end()) {
+        if (well_node == leaf_nodes_by_name_.end()) {
             OPM_THROW(std::runtime_error, "Could not find well " << name << " in the well collection!\n");
         }
 
-        return *(*well_node);
+        return *(well_node->second);
+    }
+
+    void WellCollection::addLeafNode(WellNode* well_node)
+    {
+        leaf_nodes_.push_back(well_node);
+        // the first node with a given name is the one found
+        leaf_nodes_by_name_.emplace(well_node->name(), well_node);
     }
 
     /// Adds the child to the collection
@@ -151,7 +155,7 @@ namespace Opm
         assert(!parent->isLeafNode());
         static_cast<WellsGroup*>(parent)->addChild(child_node);
         if (child_node->isLeafNode()) {
-            leaf_nodes_.push_back(static_cast<WellNode*>(child_node.get()));
+            addLeafNode(static_cast<WellNode*>(child_node.get()));
         }
 
     }
@@ -162,7 +166,7 @@ namespace Opm
     {
         roots_.push_back(child_node);
         if (child_node->isLeafNode()) {
-            leaf_nodes_.push_back(static_cast<WellNode*> (child_node.get()));
+            addLeafNode(static_cast<WellNode*>(child_node.get()));
         }
     }
 
@@ -287,6 +291,8 @@ namespace Opm
 
         // TODO: if it gets converged, should we still update targets?
 
+        updateProductionRates(well_rates);
+
         // set the target_updated to be false
         for (WellNode* well_node : leaf_nodes_) {
             well_node->setTargetUpdated(false);
@@ -339,6 +345,8 @@ namespace Opm
 
     bool WellCollection::groupTargetConverged(const std::vector<double>& well_rates) const
     {
+        updateProductionRates(well_rates);
+
         // TODO: eventually, there should be only one root node
         // TODO: we also need to check the injection target, while we have not done that.
         for (const std::shared_ptr<WellsGroupInterface>& root_node : roots_) {
@@ -351,6 +359,20 @@ namespace Opm
 
 
 
+    void WellCollection::updateProductionRates(const std::vector<double>& well_rates) const
+    {
+        for (WellNode* well_node : leaf_nodes_) {
+            if (well_node->updateProductionRates(well_rates) && well_node->getParent() != nullptr) {
+                well_node->getParent()->invalidateProductionRates();
+            }
+        }
+        for (const std::shared_ptr<WellsGroupInterface>& root_node : roots_) {
+            root_node->refreshProductionRates();
+        }
+    }
+
+
+
     void WellCollection::
     setGuideRatesWithPotentials(const Wells* wells,
                                 const PhaseUsage& phase_usage,
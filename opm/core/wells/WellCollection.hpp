@@ -21,6 +21,8 @@
 
 #include <vector>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #include <opm/core/wells/WellsGroup.hpp>
 #include <opm/grid/UnstructuredGrid.h>
@@ -149,6 +151,10 @@ namespace Opm
         // The strategy may need to be adjusted when more complicated multi-layered group control situation applied, not sure about thatyet.
         bool groupTargetConverged(const std::vector<double>& well_rates) const;
 
+        /// Updating the cached production rates of the wells and groups. Only the
+        /// groups containing wells whose rates changed since the last call are summed up again.
+        void updateProductionRates(const std::vector<double>& well_rates) const;
+
 
         /// Setting the guide rates with well potentials
         void setGuideRatesWithPotentials(const Wells* wells,
@@ -165,6 +171,11 @@ namespace Opm
         // This will be used to traverse the bottom nodes.
         std::vector<WellNode*> leaf_nodes_;
 
+        // The leaf nodes by well name, for findWellNode().
+        std::unordered_map<std::string, WellNode*> leaf_nodes_by_name_;
+
+        void addLeafNode(WellNode* well_node);
+
         bool having_vrep_groups_ = false;
 
         bool group_control_active_ = false;
@@ -22,6 +22,7 @@
 #include <opm/core/well_controls.h>
 #include <opm/core/props/phaseUsageFromDeck.hpp>
 
+#include <cassert>
 #include <cmath>
 #include <memory>
 #include <iostream>
@@ -30,6 +31,24 @@ namespace
 {
     static double invalid_alq = -1e100;
     static double invalid_vfp = -2147483647;
+
+    // index of the production control mode in the cached production rates
+    int productionRateIndex(const Opm::ProductionSpecification::ControlMode prod_mode)
+    {
+        switch(prod_mode) {
+        case Opm::ProductionSpecification::LRAT :
+            return 0;
+        case Opm::ProductionSpecification::ORAT :
+            return 1;
+        case Opm::ProductionSpecification::WRAT :
+            return 2;
+        case Opm::ProductionSpecification::GRAT :
+            return 3;
+        default:
+            OPM_THROW(std::runtime_error, "Not supporting type " << Opm::ProductionSpecification::toString(prod_mode) <<
+                                          " for production rate calculation ");
+        }
+    }
 } //Namespace
 
 namespace Opm
@@ -68,6 +87,8 @@ namespace Opm
         : parent_(NULL),
           individual_control_(true), // always begin with individual control
           efficiency_factor_(efficiency_factor),
+          production_rates_{{0.0, 0.0, 0.0, 0.0}},
+          production_rates_valid_(false),
           name_(myname),
           production_specification_(prod_spec),
           injection_specification_(inje_spec),
@@ -255,6 +276,24 @@ namespace Opm
     void WellsGroupInterface::setEfficiencyFactor(const double efficiency_factor)
     {
         efficiency_factor_=efficiency_factor;
+        // the rates of the parent include the efficiency factor
+        if (parent_ != nullptr) {
+            parent_->invalidateProductionRates();
+        }
+    }
+
+    double WellsGroupInterface::productionRate(const ProductionSpecification::ControlMode prod_mode) const
+    {
+        assert(production_rates_valid_);
+        return production_rates_[productionRateIndex(prod_mode)];
+    }
+
+    void WellsGroupInterface::invalidateProductionRates()
+    {
+        // the parents of an outdated node are outdated already
+        for (WellsGroupInterface* node = this; node != nullptr && node->production_rates_valid_; node = node->parent_) {
+            node->production_rates_valid_ = false;
+        }
     }
 
 
@@ -752,7 +791,7 @@ namespace Opm
     }
 
 
-    void WellsGroup::updateWellProductionTargets(const std::vector<double>& well_rates)
+    void WellsGroup::updateWellProductionTargets(const std::vector<double>& /* well_rates */)
     {
         // TODO: currently, we only handle the level of the well groups for the moment, i.e. the level just above wells
         // We believe the relations between groups are similar to the relations between different wells inside the same group.
@@ -789,7 +828,7 @@ namespace Opm
 
         for (size_t i = 0; i < children_.size(); ++i) {
             if (children_[i]->individualControl()) {
-                rate_individual_control += std::abs(children_[i]->getProductionRate(well_rates, prod_mode) * children_[i]->efficiencyFactor());
+                rate_individual_control += std::abs(children_[i]->productionRate(prod_mode) * children_[i]->efficiencyFactor());
             }
         }
 
@@ -807,7 +846,7 @@ namespace Opm
                 // for the well not under group control, we need to update their group control limit
                 // to provide a mechanism for the well to return to group control
                 // putting its own rate back to the rate_for_group_control for redistribution
-                const double rate = std::abs(children_[i]->getProductionRate(well_rates, prod_mode) * children_[i]->efficiencyFactor());
+                const double rate = std::abs(children_[i]->productionRate(prod_mode) * children_[i]->efficiencyFactor());
                 const double temp_rate_for_group_control = rate_for_group_control + rate;
 
                 // TODO: the following might not be the correct thing to do for mutliple-layer group
@@ -860,7 +899,7 @@ namespace Opm
             case ProductionSpecification::WRAT :
             case ProductionSpecification::GRAT :
             {
-                const double production_rate = std::abs(getProductionRate(well_rates, prod_mode));
+                const double production_rate = std::abs(productionRate(prod_mode));
                 const double production_target = std::abs(getTarget(prod_mode));
 
                 // 0.01 is a hard-coded relative tolerance
@@ -913,6 +952,25 @@ namespace Opm
         return total_production_rate;
     }
 
+
+    void WellsGroup::refreshProductionRates()
+    {
+        if (production_rates_valid_) {
+            return;
+        }
+        // summing in the same order as getProductionRate()
+        production_rates_.fill(0.0);
+        const ProductionSpecification::ControlMode modes[] = { ProductionSpecification::LRAT, ProductionSpecification::ORAT,
+                                                               ProductionSpecification::WRAT, ProductionSpecification::GRAT };
+        for (const std::shared_ptr<WellsGroupInterface>& child_node : children_) {
+            child_node->refreshProductionRates();
+            for (const auto mode : modes) {
+                production_rates_[productionRateIndex(mode)] += child_node->productionRate(mode) * child_node->efficiencyFactor();
+            }
+        }
+        production_rates_valid_ = true;
+    }
+
     // ==============    WellNode members   ============
 
 
@@ -1454,6 +1512,30 @@ namespace Opm
         }
     }
 
+    bool WellNode::updateProductionRates(const std::vector<double>& well_rates)
+    {
+        const auto& pu = phaseUsage();
+        const auto rate = [&](const BlackoilPhases::PhaseIndex phase) {
+            return pu.phase_used[phase] ? getTotalProductionFlow(well_rates, phase) : 0.0;
+        };
+        const double oil = rate(BlackoilPhases::Liquid);
+        const double water = rate(BlackoilPhases::Aqua);
+        const double gas = rate(BlackoilPhases::Vapour);
+        const std::array<double, 4> rates = {{ oil + water, oil, water, gas }};
+
+        if (production_rates_valid_ && rates == production_rates_) {
+            return false;
+        }
+        production_rates_ = rates;
+        production_rates_valid_ = true;
+        return true;
+    }
+
+    void WellNode::refreshProductionRates()
+    {
+        // updated by updateProductionRates()
+    }
+
     void WellNode::updateWellProductionTargets(const std::vector<double>& /*well_rates*/)
     {
     }
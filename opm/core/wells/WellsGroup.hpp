@@ -28,6 +28,7 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/Well/Well2.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Group/Group2.hpp>
 
+#include <array>
 #include <string>
 #include <memory>
 
@@ -252,6 +253,16 @@ namespace Opm
 
         void setEfficiencyFactor(const double efficiency_factor);
 
+        /// The production rate for the given control mode, as getProductionRate()
+        /// with the well rates last passed to WellCollection::updateProductionRates().
+        double productionRate(const ProductionSpecification::ControlMode prod_mode) const;
+
+        /// Marks the cached production rates of this node and its parents as outdated.
+        void invalidateProductionRates();
+
+        /// Recomputes the outdated cached production rates in the subtree.
+        virtual void refreshProductionRates() = 0;
+
     protected:
         /// Calculates the correct rate for the given ProductionSpecification::ControlMode
         double rateByMode(const double* res_rates,
@@ -273,6 +284,11 @@ namespace Opm
         // Efficiency factor
         double efficiency_factor_;
 
+        // Cached production rates for LRAT, ORAT, WRAT and GRAT. If they are
+        // outdated, so are the ones of all the parents.
+        std::array<double, 4> production_rates_;
+        bool production_rates_valid_;
+
     private:
         std::string name_;
         ProductionSpecification production_specification_;
@@ -387,6 +403,8 @@ namespace Opm
 
         virtual bool groupProdTargetConverged(const std::vector<double>& well_rates) const;
 
+        virtual void refreshProductionRates();
+
     private:
         std::vector<std::shared_ptr<WellsGroupInterface> > children_;
     };
@@ -524,6 +542,12 @@ namespace Opm
 
         virtual bool groupProdTargetConverged(const std::vector<double>& well_rates) const;
 
+        /// Updates the cached production rates from well_rates.
+        /// \return true if they changed.
+        bool updateProductionRates(const std::vector<double>& well_rates);
+
+        virtual void refreshProductionRates();
+
     private:
         Wells* wells_;
         int self_index_;
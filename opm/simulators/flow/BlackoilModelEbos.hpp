@@ -109,6 +109,9 @@ namespace Opm {
         typedef typename GET_PROP_TYPE(TypeTag, Simulator)         Simulator;
         typedef typename GET_PROP_TYPE(TypeTag, Grid)              Grid;
         typedef typename GET_PROP_TYPE(TypeTag, ElementContext)    ElementContext;
+        typedef typename GET_PROP_TYPE(TypeTag, IntensiveQuantities) IntensiveQuantities;
+        typedef typename GET_PROP_TYPE(TypeTag, GridView)          GridView;
+        typedef typename GridView::template Codim<0>::Entity       Element;
         typedef typename GET_PROP_TYPE(TypeTag, SparseMatrixAdapter) SparseMatrixAdapter;
         typedef typename GET_PROP_TYPE(TypeTag, SolutionVector)    SolutionVector ;
         typedef typename GET_PROP_TYPE(TypeTag, PrimaryVariables)  PrimaryVariables ;
@@ -169,6 +172,7 @@ namespace Opm {
         , terminal_output_ (terminal_output)
         , current_relaxation_(1.0)
         , dx_old_(UgGridHelpers::numCells(grid_))
+        , forcing_term_(param.adaptive_linear_tolerance_max_)
         {
             // compute global sum of number of cells
             global_nc_ = detail::countGlobalCells(grid_);
@@ -302,11 +306,13 @@ namespace Opm {
                     report.linear_solve_setup_time += linear_solve_setup_time_;
                     report.linear_solve_time += perfTimer.stop();
                     report.total_linear_iterations += linearIterationsLastSolve();
+                    addCprTimings(report);
                 }
                 catch (...) {
                     report.linear_solve_setup_time += linear_solve_setup_time_;
                     report.linear_solve_time += perfTimer.stop();
                     report.total_linear_iterations += linearIterationsLastSolve();
+                    addCprTimings(report);
 
                     failureReport_ += report;
                     throw; // re-throw up
@@ -462,6 +468,54 @@ namespace Opm {
             return ebosSimulator_.model().newtonMethod().linearSolver().iterations ();
         }
 
+        /// Add the time the linear solver spent in the CPR preconditioner
+        /// since the last call to the report.
+        void addCprTimings(SimulatorReport& report)
+        {
+            const auto timings = ebosSimulator_.model().newtonMethod().linearSolver().takeCprTimings();
+            report.cpr_setup_time += timings.setup;
+            report.cpr_apply_time += timings.apply;
+        }
+
+        /// Relative linear solver reduction for the current Newton iteration,
+        /// following Eisenstat and Walker (choice 2): the linear system is solved
+        /// loosely as long as the nonlinear residual decreases slowly. The
+        /// residual is measured by the largest CNV of the last entry in
+        /// residual_norms_history_. The linear solver itself ensures that the
+        /// result is not stricter than its configured reduction.
+        double linearSolverForcingTerm()
+        {
+            const double etaMax = param_.adaptive_linear_tolerance_max_;
+            const double gamma = param_.adaptive_linear_tolerance_gamma_;
+            const double alpha = param_.adaptive_linear_tolerance_alpha_;
+            const auto maxNorm = [](const std::vector<double>& norms) {
+                return norms.empty() ? 0.0 : *std::max_element(norms.begin(), norms.end());
+            };
+
+            if (residual_norms_history_.size() < 2) {
+                forcing_term_ = etaMax;
+                return forcing_term_;
+            }
+
+            const double norm = maxNorm(residual_norms_history_.back());
+            const double normOld = maxNorm(residual_norms_history_[residual_norms_history_.size() - 2]);
+            double eta = etaMax;
+            if (normOld > 0.0) {
+                eta = gamma * std::pow(norm / normOld, alpha);
+            }
+            // Do not let the forcing term drop much faster than it did before.
+            const double etaSafe = gamma * std::pow(forcing_term_, alpha);
+            if (etaSafe > 0.1) {
+                eta = std::max(eta, etaSafe);
+            }
+            // No need to solve much more accurately than the nonlinear tolerance requires.
+            if (norm > 0.0) {
+                eta = std::max(eta, 0.5 * param_.tolerance_cnv_ / norm);
+            }
+            forcing_term_ = std::min(eta, etaMax);
+            return forcing_term_;
+        }
+
         /// Solve the Jacobian system Jx = r where J is the Jacobian and
         /// r is the residual.
         void solveJacobianSystem(BVector& x)
@@ -474,6 +528,9 @@ namespace Opm {
             x = 0.0;
 
             auto& ebosSolver = ebosSimulator_.model().newtonMethod().linearSolver();
+            if (param_.use_adaptive_linear_tolerance_) {
+                ebosSolver.setReduction(linearSolverForcingTerm());
+            }
             Dune::Timer perfTimer;
             perfTimer.start();
             ebosSolver.prepare(ebosJac, ebosResid);
@@ -568,6 +625,23 @@ namespace Opm {
             return pvSum;
         }
 
+        // Return the intensive quantities of an element. The ones which have been
+        // computed during the linearization are used if they are still cached by the
+        // model. Only if this is not the case, they are evaluated using the element
+        // context.
+        const IntensiveQuantities& cachedOrUpdatedIntensiveQuantities_(ElementContext& elemCtx,
+                                                                       const Element& elem,
+                                                                       unsigned cellIdx) const
+        {
+            const auto* intQuants = ebosSimulator_.model().cachedIntensiveQuantities(cellIdx, /*timeIdx=*/0);
+            if (intQuants)
+                return *intQuants;
+
+            elemCtx.updatePrimaryStencil(elem);
+            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+            return elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
+        }
+
         // Get reservoir quantities on this process needed for convergence calculations.
         double localConvergenceData(std::vector<Scalar>& R_sum,
                                     std::vector<Scalar>& maxCoeff,
@@ -580,6 +654,7 @@ namespace Opm {
             const auto& ebosResid = ebosSimulator_.model().linearizer().residual();
 
             ElementContext elemCtx(ebosSimulator_);
+            const auto& elemMapper = ebosModel.elementMapper();
             const auto& gridView = ebosSimulator().gridView();
             const auto& elemEndIt = gridView.template end</*codim=*/0, Dune::Interior_Partition>();
 
@@ -588,10 +663,8 @@ namespace Opm {
                  ++elemIt)
             {
                 const auto& elem = *elemIt;
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                const unsigned cell_idx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
+                const unsigned cell_idx = elemMapper.index(elem);
+                const auto& intQuants = cachedOrUpdatedIntensiveQuantities_(elemCtx, elem, cell_idx);
                 const auto& fs = intQuants.fluidState();
 
                 const double pvValue = ebosProblem.referencePorosity(cell_idx, /*timeIdx=*/0) * ebosModel.dofTotalVolume( cell_idx );
@@ -886,6 +959,8 @@ namespace Opm {
         std::vector<std::vector<double>> residual_norms_history_;
         double current_relaxation_;
         BVector dx_old_;
+        /// Forcing term of the previous Newton iteration.
+        double forcing_term_;
 
         std::vector<StepReport> convergence_reports_;
     public:
@@ -48,6 +48,13 @@ NEW_PROP_TAG(SolveWelleqInitially);
 NEW_PROP_TAG(UpdateEquationsScaling);
 NEW_PROP_TAG(UseUpdateStabilization);
 NEW_PROP_TAG(MatrixAddWellContributions);
+NEW_PROP_TAG(UseWellSchurComplement);
+
+// parameters for the adaptive (Eisenstat-Walker) linear tolerance
+NEW_PROP_TAG(UseAdaptiveLinearTolerance);
+NEW_PROP_TAG(AdaptiveLinearToleranceMax);
+NEW_PROP_TAG(AdaptiveLinearToleranceGamma);
+NEW_PROP_TAG(AdaptiveLinearToleranceAlpha);
 
 // parameters for multisegment wells
 NEW_PROP_TAG(TolerancePressureMsWells);
@@ -71,10 +78,15 @@ SET_BOOL_PROP(FlowModelParameters, SolveWelleqInitially, true);
 SET_BOOL_PROP(FlowModelParameters, UpdateEquationsScaling, false);
 SET_BOOL_PROP(FlowModelParameters, UseUpdateStabilization, true);
 SET_BOOL_PROP(FlowModelParameters, MatrixAddWellContributions, false);
+SET_BOOL_PROP(FlowModelParameters, UseWellSchurComplement, false);
 SET_SCALAR_PROP(FlowModelParameters, TolerancePressureMsWells, 0.01 *1e5);
 SET_SCALAR_PROP(FlowModelParameters, MaxPressureChangeMsWells, 1e6);
 SET_BOOL_PROP(FlowModelParameters, UseInnerIterationsMsWells, true);
 SET_INT_PROP(FlowModelParameters, MaxInnerIterMsWells, 100);
+SET_BOOL_PROP(FlowModelParameters, UseAdaptiveLinearTolerance, false);
+SET_SCALAR_PROP(FlowModelParameters, AdaptiveLinearToleranceMax, 0.1);
+SET_SCALAR_PROP(FlowModelParameters, AdaptiveLinearToleranceGamma, 0.9);
+SET_SCALAR_PROP(FlowModelParameters, AdaptiveLinearToleranceAlpha, 2.0);
 
 // if openMP is available, determine the number threads per process automatically.
 #if _OPENMP
@@ -153,6 +165,23 @@ namespace Opm
         // Whether to add influences of wells between cells to the matrix and preconditioner matrix
         bool matrix_add_well_contributions_;
 
+        /// Apply the wells in the linear solver through one operator holding
+        /// the coupling blocks of all standard wells, instead of well by well.
+        bool use_well_schur_complement_;
+
+        /// Choose the linear solver reduction of each Newton iteration from the
+        /// decrease of the nonlinear residual (Eisenstat-Walker, choice 2).
+        bool use_adaptive_linear_tolerance_;
+
+        /// Loosest linear solver reduction used by the adaptive linear tolerance.
+        double adaptive_linear_tolerance_max_;
+
+        /// Factor gamma of the forcing term gamma * (|F_k| / |F_k-1|)^alpha.
+        double adaptive_linear_tolerance_gamma_;
+
+        /// Exponent alpha of the forcing term gamma * (|F_k| / |F_k-1|)^alpha.
+        double adaptive_linear_tolerance_alpha_;
+
         /// Construct from user parameters or defaults.
         BlackoilModelParametersEbos()
         {
@@ -176,6 +205,11 @@ namespace Opm
             update_equations_scaling_ = EWOMS_GET_PARAM(TypeTag, bool, UpdateEquationsScaling);
             use_update_stabilization_ = EWOMS_GET_PARAM(TypeTag, bool, UseUpdateStabilization);
             matrix_add_well_contributions_ = EWOMS_GET_PARAM(TypeTag, bool, MatrixAddWellContributions);
+            use_well_schur_complement_ = EWOMS_GET_PARAM(TypeTag, bool, UseWellSchurComplement);
+            use_adaptive_linear_tolerance_ = EWOMS_GET_PARAM(TypeTag, bool, UseAdaptiveLinearTolerance);
+            adaptive_linear_tolerance_max_ = EWOMS_GET_PARAM(TypeTag, Scalar, AdaptiveLinearToleranceMax);
+            adaptive_linear_tolerance_gamma_ = EWOMS_GET_PARAM(TypeTag, Scalar, AdaptiveLinearToleranceGamma);
+            adaptive_linear_tolerance_alpha_ = EWOMS_GET_PARAM(TypeTag, Scalar, AdaptiveLinearToleranceAlpha);
 
             deck_file_name_ = EWOMS_GET_PARAM(TypeTag, std::string, EclDeckFileName);
         }
@@ -202,6 +236,11 @@ namespace Opm
             EWOMS_REGISTER_PARAM(TypeTag, bool, UpdateEquationsScaling, "Update scaling factors for mass balance equations during the run");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseUpdateStabilization, "Try to detect and correct oscillations or stagnation during the Newton method");
             EWOMS_REGISTER_PARAM(TypeTag, bool, MatrixAddWellContributions, "Explicitly specify the influences of wells between cells in the Jacobian and preconditioner matrices");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, UseWellSchurComplement, "Apply the wells in the linear solver through one operator assembled from all standard wells");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, UseAdaptiveLinearTolerance, "Adapt the linear solver reduction of each Newton iteration to the decrease of the nonlinear residual (Eisenstat-Walker)");
+            EWOMS_REGISTER_PARAM(TypeTag, Scalar, AdaptiveLinearToleranceMax, "Loosest linear solver reduction used with the adaptive linear tolerance");
+            EWOMS_REGISTER_PARAM(TypeTag, Scalar, AdaptiveLinearToleranceGamma, "Factor gamma of the adaptive linear tolerance gamma*(|F_k|/|F_k-1|)^alpha");
+            EWOMS_REGISTER_PARAM(TypeTag, Scalar, AdaptiveLinearToleranceAlpha, "Exponent alpha of the adaptive linear tolerance gamma*(|F_k|/|F_k-1|)^alpha");
         }
     };
 } // namespace Opm
@@ -982,7 +982,8 @@ private:
 template<typename O, typename S, typename C,
          typename P, std::size_t COMPONENT_INDEX, std::size_t VARIABLE_INDEX>
 class BlackoilAmg
-    : public Dune::Preconditioner<typename O::domain_type, typename O::range_type>
+    : public Dune::Preconditioner<typename O::domain_type, typename O::range_type>,
+      public Dune::Amg::TwoLevelMethodTimingsProvider
 {
 public:
     /** \brief The type of the operator (encapsulating a BCRSMatrix). */
@@ -1050,7 +1051,7 @@ public:
           scaledMatrixOperator_(Detail::createOperator(fineOperator, *scaledMatrix_, comm)),
           smoother_( Detail::constructSmoother<Smoother>(*scaledMatrixOperator_, smargs, comm)),
           levelTransferPolicy_(criterion, comm, param.cpr_pressure_aggregation_),
-          coarseSolverPolicy_(&param, smargs, criterion),
+          coarseSolverPolicy_(&param, coarseLevelSmootherArgs(smargs), criterion),
           twoLevelMethod_(*scaledMatrixOperator_, smoother_,
                           levelTransferPolicy_, coarseSolverPolicy_, 0, 1)
     {
@@ -1074,6 +1075,11 @@ public:
         Detail::scaleVectorDRS(scaledD, COMPONENT_INDEX, param_, weights_);
         twoLevelMethod_.apply(v, scaledD);
     }
+
+    Dune::Amg::TwoLevelMethodTimings takeTimings() override
+    {
+        return twoLevelMethod_.takeTimings();
+    }
 private:
     const CPRParameter& param_;
     const typename TwoLevelMethod::FineDomainType& weights_;
@@ -58,7 +58,8 @@ namespace Opm
     template<typename O, typename S, typename SC, typename C,
              typename P, std::size_t COMPONENT_INDEX, std::size_t VARIABLE_INDEX>
     class BlackoilAmgCpr
-        : public Dune::Preconditioner<typename O::domain_type, typename O::range_type>
+        : public Dune::Preconditioner<typename O::domain_type, typename O::range_type>,
+          public Dune::Amg::TwoLevelMethodTimingsProvider
     {
     public:
         /** \brief The type of the operator (encapsulating a BCRSMatrix). */
@@ -128,7 +129,7 @@ namespace Opm
               smoother_(Detail::constructSmoother<Smoother>(*scaledMatrixOperator_,
                                                             smargs, comm)),
               levelTransferPolicy_(criterion, comm, param.cpr_pressure_aggregation_),
-              coarseSolverPolicy_(&param, smargs, criterion),
+              coarseSolverPolicy_(&param, coarseLevelSmootherArgs(smargs), criterion),
               twoLevelMethod_(*scaledMatrixOperator_,
                               smoother_,
                               levelTransferPolicy_,
@@ -166,6 +167,11 @@ namespace Opm
             twoLevelMethod_.apply(v, scaledD);
         }
 
+        Dune::Amg::TwoLevelMethodTimings takeTimings() override
+        {
+            return twoLevelMethod_.takeTimings();
+        }
+
     private:
         const CPRParameter& param_;
         const typename TwoLevelMethod::FineDomainType& weights_;
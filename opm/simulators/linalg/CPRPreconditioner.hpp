@@ -25,6 +25,7 @@
 #define OPM_CPRPRECONDITIONER_HEADER_INCLUDED
 
 #include <memory>
+#include <stdexcept>
 #include <type_traits>
 
 #include <opm/common/utility/platform_dependent/disable_warnings.h>
@@ -87,6 +88,22 @@ template<class S, class P>
 void setILUParameters(S&, const P&)
 {}
 
+/// \brief Set the ordering of the fine level smoother of CPR.
+/// \param cache The orderings kept by the solver, may be null.
+template<class T>
+void setILUOrdering(Opm::ParallelOverlappingILU0Args<T>& args,
+                    const CPRParameter& params,
+                    std::shared_ptr<Opm::detail::OrderingCache> cache)
+{
+    args.setOrdering(params.cpr_ilu_redblack_, params.cpr_ilu_reorder_sphere_,
+                     params.cpr_ilu_reorder_rcm_, params.cpr_ilu_speculative_coloring_);
+    args.setOrderingCache(std::move(cache));
+}
+
+template<class S>
+void setILUOrdering(S&, const CPRParameter&, std::shared_ptr<Opm::detail::OrderingCache>)
+{}
+
 template<class S, class P>
 void setILUParameters(S&, bool, int)
 {}
@@ -189,12 +206,31 @@ createEllipticPreconditionerPointer(const M& Ae, double relax,
     return EllipticPreconditionerPointer(new ParallelPreconditioner(Ae, comm, relax, milu));
 }
 
+/// \brief Converts the value of the CprAccumulate parameter to the
+/// accumulation mode of the AMG.
+/// \throws std::invalid_argument if the value is not 0, 1 or 2.
+inline Dune::Amg::AccumulationMode cprAccumulationMode(const int accumulate)
+{
+    switch (accumulate) {
+    case 0:
+        return Dune::Amg::noAccu;
+    case 1:
+        return Dune::Amg::atOnceAccu;
+    case 2:
+        return Dune::Amg::successiveAccu;
+    default:
+        break;
+    }
+    OPM_THROW(std::invalid_argument, "Invalid value " << accumulate << " for CprAccumulate, must be 0, 1 or 2");
+}
+
 template < class C, class Op, class P, class S, std::size_t PressureEqnIndex, std::size_t PressureVarIndex, class Vector>
 inline void
 createAMGPreconditionerPointer(Op& opA, const double relax, const P& comm,
                                std::unique_ptr< BlackoilAmg<Op,S,C,P,PressureEqnIndex,PressureVarIndex> >& amgPtr,
                                const CPRParameter& params,
-                               const Vector& weights)
+                               const Vector& weights,
+                               std::shared_ptr<Opm::detail::OrderingCache> orderingCache = nullptr)
 {
     using AMG = BlackoilAmg<Op,S,C,P,PressureEqnIndex,PressureVarIndex>;
     int verbosity = 0;
@@ -209,6 +245,7 @@ createAMGPreconditionerPointer(Op& opA, const double relax, const P& comm,
     criterion.setDefaultValuesIsotropic(2);
     criterion.setNoPostSmoothSteps( 1 );
     criterion.setNoPreSmoothSteps( 1 );
+    criterion.setAccumulate( cprAccumulationMode(params.cpr_accumulate_) );
 
     // Since DUNE 2.2 we also need to pass the smoother args instead of steps directly
     typedef typename AMG::Smoother Smoother;
@@ -217,6 +254,7 @@ createAMGPreconditionerPointer(Op& opA, const double relax, const P& comm,
     smootherArgs.iterations = 1;
     smootherArgs.relaxationFactor = relax;
     setILUParameters(smootherArgs, params);
+    setILUOrdering(smootherArgs, params, std::move(orderingCache));
 
     amgPtr.reset( new AMG( params, weights, opA, criterion, smootherArgs, comm ) );
 }
@@ -21,6 +21,7 @@
 #ifndef OPM_FLEXIBLE_SOLVER_HEADER_INCLUDED
 #define OPM_FLEXIBLE_SOLVER_HEADER_INCLUDED
 
+#include <opm/simulators/linalg/FusedBiCGSTABSolver.hpp>
 #include <opm/simulators/linalg/PreconditionerFactory.hpp>
 
 #include <dune/common/fmatrix.hh>
@@ -45,17 +46,22 @@ public:
     using MatrixType = MatrixTypeT;
     using VectorType = VectorTypeT;
 
+    /// Data kept by the owner of the solver between preconditioner setups.
+    using SetupDataPtr = std::shared_ptr<Opm::PreconditionerSetupData>;
+
     /// Create a sequential solver.
-    FlexibleSolver(const boost::property_tree::ptree& prm, const MatrixType& matrix)
+    FlexibleSolver(const boost::property_tree::ptree& prm, const MatrixType& matrix,
+                   const SetupDataPtr& setupData = SetupDataPtr())
     {
-        init(prm, matrix, Dune::Amg::SequentialInformation());
+        init(prm, matrix, Dune::Amg::SequentialInformation(), setupData);
     }
 
     /// Create a parallel solver (if Comm is e.g. OwnerOverlapCommunication).
     template <class Comm>
-    FlexibleSolver(const boost::property_tree::ptree& prm, const MatrixType& matrix, const Comm& comm)
+    FlexibleSolver(const boost::property_tree::ptree& prm, const MatrixType& matrix, const Comm& comm,
+                   const SetupDataPtr& setupData = SetupDataPtr())
     {
-        init(prm, matrix, comm);
+        init(prm, matrix, comm, setupData);
     }
 
     virtual void apply(VectorType& x, VectorType& rhs, Dune::InverseOperatorResult& res) override
@@ -89,28 +95,31 @@ private:
 
     // Machinery for making sequential or parallel operators/preconditioners/scalar products.
     template <class Comm>
-    void initOpPrecSp(const MatrixType& matrix, const boost::property_tree::ptree& prm, const Comm& comm)
+    void initOpPrecSp(const MatrixType& matrix, const boost::property_tree::ptree& prm, const Comm& comm,
+                      const SetupDataPtr& setupData)
     {
         // Parallel case.
         using ParOperatorType = Dune::OverlappingSchwarzOperator<MatrixType, VectorType, VectorType, Comm>;
         auto linop = std::make_shared<ParOperatorType>(matrix, comm);
         linearoperator_ = linop;
         preconditioner_
-            = Dune::PreconditionerFactory<ParOperatorType, Comm>::create(*linop, prm.get_child("preconditioner"), comm);
+            = Dune::PreconditionerFactory<ParOperatorType, Comm>::create(*linop, prm.get_child("preconditioner"), comm, setupData);
         scalarproduct_ = Dune::createScalarProduct<VectorType, Comm>(comm, linearoperator_->category());
     }
 
-    void initOpPrecSp(const MatrixType& matrix, const boost::property_tree::ptree& prm, const Dune::Amg::SequentialInformation&)
+    void initOpPrecSp(const MatrixType& matrix, const boost::property_tree::ptree& prm, const Dune::Amg::SequentialInformation&,
+                      const SetupDataPtr& setupData)
     {
         // Sequential case.
         using SeqOperatorType = Dune::MatrixAdapter<MatrixType, VectorType, VectorType>;
         auto linop = std::make_shared<SeqOperatorType>(matrix);
         linearoperator_ = linop;
-        preconditioner_ = Dune::PreconditionerFactory<SeqOperatorType>::create(*linop, prm.get_child("preconditioner"));
+        preconditioner_ = Dune::PreconditionerFactory<SeqOperatorType>::create(*linop, prm.get_child("preconditioner"), setupData);
         scalarproduct_ = std::make_shared<Dune::SeqScalarProduct<VectorType>>();
     }
 
-    void initSolver(const boost::property_tree::ptree& prm)
+    template <class Comm>
+    void initSolver(const boost::property_tree::ptree& prm, const Comm& comm)
     {
         const double tol = prm.get<double>("tol");
         const int maxiter = prm.get<int>("maxiter");
@@ -123,6 +132,13 @@ private:
                                                                   tol, // desired residual reduction factor
                                                                   maxiter, // maximum number of iterations
                                                                   verbosity));
+        } else if (solver_type == "fusedbicgstab") {
+            linsolver_.reset(new Opm::FusedBiCGSTABSolver<VectorType, Comm>(*linearoperator_,
+                                                                            *preconditioner_,
+                                                                            comm,
+                                                                            tol, // desired residual reduction factor
+                                                                            maxiter, // maximum number of iterations
+                                                                            verbosity));
         } else if (solver_type == "loopsolver") {
             linsolver_.reset(new Dune::LoopSolver<VectorType>(*linearoperator_,
                                                               *scalarproduct_,
@@ -155,10 +171,11 @@ private:
     // Main initialization routine.
     // Call with Comm == Dune::Amg::SequentialInformation to get a serial solver.
     template <class Comm>
-    void init(const boost::property_tree::ptree& prm, const MatrixType& matrix, const Comm& comm)
+    void init(const boost::property_tree::ptree& prm, const MatrixType& matrix, const Comm& comm,
+              const SetupDataPtr& setupData)
     {
-        initOpPrecSp(matrix, prm, comm);
-        initSolver(prm);
+        initOpPrecSp(matrix, prm, comm, setupData);
+        initSolver(prm, comm);
     }
 
     std::shared_ptr<AbstractOperatorType> linearoperator_;
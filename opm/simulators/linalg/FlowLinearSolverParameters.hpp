@@ -47,12 +47,16 @@ NEW_PROP_TAG(LinearSolverReduction);
 NEW_PROP_TAG(IluRelaxation);
 NEW_PROP_TAG(LinearSolverMaxIter);
 NEW_PROP_TAG(LinearSolverRestart);
+NEW_PROP_TAG(LinearSolverRecycleSize);
 NEW_PROP_TAG(FlowLinearSolverVerbosity);
 NEW_PROP_TAG(IluFillinLevel);
 NEW_PROP_TAG(MiluVariant);
 NEW_PROP_TAG(IluRedblack);
 NEW_PROP_TAG(IluReorderSpheres);
+NEW_PROP_TAG(IluReorderRcm);
+NEW_PROP_TAG(IluSpeculativeColoring);
 NEW_PROP_TAG(UseGmres);
+NEW_PROP_TAG(UseFusedBicgstab);
 NEW_PROP_TAG(LinearSolverRequireFullSparsityPattern);
 NEW_PROP_TAG(LinearSolverIgnoreConvergenceFailure);
 NEW_PROP_TAG(UseAmg);
@@ -66,18 +70,25 @@ NEW_PROP_TAG(CprUseDrs);
 NEW_PROP_TAG(CprMaxEllIter);
 NEW_PROP_TAG(CprEllSolvetype);
 NEW_PROP_TAG(CprReuseSetup);
+NEW_PROP_TAG(CprAccumulate);
 NEW_PROP_TAG(LinearSolverConfigurationJsonFile);
+NEW_PROP_TAG(LinearSolverDumpPrefix);
+NEW_PROP_TAG(LinearSolverDumpInterval);
 
 SET_SCALAR_PROP(FlowIstlSolverParams, LinearSolverReduction, 1e-2);
 SET_SCALAR_PROP(FlowIstlSolverParams, IluRelaxation, 0.9);
 SET_INT_PROP(FlowIstlSolverParams, LinearSolverMaxIter, 200);
 SET_INT_PROP(FlowIstlSolverParams, LinearSolverRestart, 40);
+SET_INT_PROP(FlowIstlSolverParams, LinearSolverRecycleSize, 0);
 SET_INT_PROP(FlowIstlSolverParams, FlowLinearSolverVerbosity, 0);
 SET_INT_PROP(FlowIstlSolverParams, IluFillinLevel, 0);
 SET_STRING_PROP(FlowIstlSolverParams, MiluVariant, "ILU");
 SET_BOOL_PROP(FlowIstlSolverParams, IluRedblack, false);
 SET_BOOL_PROP(FlowIstlSolverParams, IluReorderSpheres, false);
+SET_BOOL_PROP(FlowIstlSolverParams, IluReorderRcm, false);
+SET_BOOL_PROP(FlowIstlSolverParams, IluSpeculativeColoring, false);
 SET_BOOL_PROP(FlowIstlSolverParams, UseGmres, false);
+SET_BOOL_PROP(FlowIstlSolverParams, UseFusedBicgstab, false);
 SET_BOOL_PROP(FlowIstlSolverParams, LinearSolverRequireFullSparsityPattern, false);
 SET_BOOL_PROP(FlowIstlSolverParams, LinearSolverIgnoreConvergenceFailure, false);
 SET_BOOL_PROP(FlowIstlSolverParams, UseAmg, false);
@@ -91,7 +102,10 @@ SET_BOOL_PROP(FlowIstlSolverParams, CprUseDrs, false);
 SET_INT_PROP(FlowIstlSolverParams, CprMaxEllIter, 20);
 SET_INT_PROP(FlowIstlSolverParams, CprEllSolvetype, 0);
 SET_INT_PROP(FlowIstlSolverParams, CprReuseSetup, 0);
+SET_INT_PROP(FlowIstlSolverParams, CprAccumulate, 0);
 SET_STRING_PROP(FlowIstlSolverParams, LinearSolverConfigurationJsonFile, "none");
+SET_STRING_PROP(FlowIstlSolverParams, LinearSolverDumpPrefix, "");
+SET_INT_PROP(FlowIstlSolverParams, LinearSolverDumpInterval, 1);
 
 
 
@@ -111,6 +125,8 @@ namespace Opm
         MILU_VARIANT cpr_ilu_milu_;
         bool cpr_ilu_redblack_;
         bool cpr_ilu_reorder_sphere_;
+        bool cpr_ilu_reorder_rcm_;
+        bool cpr_ilu_speculative_coloring_;
         bool cpr_use_drs_;
         int cpr_max_ell_iter_;
         int cpr_ell_solvetype_;
@@ -119,6 +135,7 @@ namespace Opm
         int cpr_solver_verbose_;
         bool cpr_pressure_aggregation_;
         int cpr_reuse_setup_;
+        int cpr_accumulate_;
         CPRParameter() { reset(); }
 
         void reset()
@@ -128,6 +145,8 @@ namespace Opm
             cpr_ilu_milu_             = MILU_VARIANT::ILU;
             cpr_ilu_redblack_         = false;
             cpr_ilu_reorder_sphere_   = true;
+            cpr_ilu_reorder_rcm_      = false;
+            cpr_ilu_speculative_coloring_ = false;
             cpr_max_ell_iter_         = 25;
             cpr_ell_solvetype_        = 0;
             cpr_use_drs_              = false;
@@ -136,6 +155,7 @@ namespace Opm
             cpr_solver_verbose_       = 0;
             cpr_pressure_aggregation_ = false;
             cpr_reuse_setup_          = 0;
+            cpr_accumulate_           = 0;
         }
     };
 
@@ -150,12 +170,16 @@ namespace Opm
         double ilu_relaxation_;
         int    linear_solver_maxiter_;
         int    linear_solver_restart_;
+        int    linear_solver_recycle_size_;
         int    linear_solver_verbosity_;
         int    ilu_fillin_level_;
         Opm::MILU_VARIANT   ilu_milu_;
         bool   ilu_redblack_;
         bool   ilu_reorder_sphere_;
+        bool   ilu_reorder_rcm_;
+        bool   ilu_speculative_coloring_;
         bool   newton_use_gmres_;
+        bool   use_fused_bicgstab_;
         bool   require_full_sparsity_pattern_;
         bool   ignoreConvergenceFailure_;
         bool   linear_solver_use_amg_;
@@ -163,6 +187,8 @@ namespace Opm
         std::string system_strategy_;
         bool scale_linear_system_;
         std::string linear_solver_configuration_json_file_;
+        std::string linear_solver_dump_prefix_;
+        int linear_solver_dump_interval_;
 
         template <class TypeTag>
         void init()
@@ -172,12 +198,21 @@ namespace Opm
             ilu_relaxation_ = EWOMS_GET_PARAM(TypeTag, double, IluRelaxation);
             linear_solver_maxiter_ = EWOMS_GET_PARAM(TypeTag, int, LinearSolverMaxIter);
             linear_solver_restart_ = EWOMS_GET_PARAM(TypeTag, int, LinearSolverRestart);
+            linear_solver_recycle_size_ = EWOMS_GET_PARAM(TypeTag, int, LinearSolverRecycleSize);
             linear_solver_verbosity_ = EWOMS_GET_PARAM(TypeTag, int, FlowLinearSolverVerbosity);
             ilu_fillin_level_ = EWOMS_GET_PARAM(TypeTag, int, IluFillinLevel);
             ilu_milu_ = convertString2Milu(EWOMS_GET_PARAM(TypeTag, std::string, MiluVariant));
             ilu_redblack_ = EWOMS_GET_PARAM(TypeTag, bool, IluRedblack);
             ilu_reorder_sphere_ = EWOMS_GET_PARAM(TypeTag, bool, IluReorderSpheres);
+            ilu_reorder_rcm_ = EWOMS_GET_PARAM(TypeTag, bool, IluReorderRcm);
+            ilu_speculative_coloring_ = EWOMS_GET_PARAM(TypeTag, bool, IluSpeculativeColoring);
+            // the fine level smoother of CPR is ordered like the ILU preconditioner
+            cpr_ilu_redblack_ = ilu_redblack_;
+            cpr_ilu_reorder_sphere_ = ilu_reorder_sphere_;
+            cpr_ilu_reorder_rcm_ = ilu_reorder_rcm_;
+            cpr_ilu_speculative_coloring_ = ilu_speculative_coloring_;
             newton_use_gmres_ = EWOMS_GET_PARAM(TypeTag, bool, UseGmres);
+            use_fused_bicgstab_ = EWOMS_GET_PARAM(TypeTag, bool, UseFusedBicgstab);
             require_full_sparsity_pattern_ = EWOMS_GET_PARAM(TypeTag, bool, LinearSolverRequireFullSparsityPattern);
             ignoreConvergenceFailure_ = EWOMS_GET_PARAM(TypeTag, bool, LinearSolverIgnoreConvergenceFailure);
             linear_solver_use_amg_ = EWOMS_GET_PARAM(TypeTag, bool, UseAmg);
@@ -189,7 +224,10 @@ namespace Opm
             cpr_max_ell_iter_  =  EWOMS_GET_PARAM(TypeTag, int, CprMaxEllIter);
             cpr_ell_solvetype_  =  EWOMS_GET_PARAM(TypeTag, int, CprEllSolvetype);
             cpr_reuse_setup_  =  EWOMS_GET_PARAM(TypeTag, int, CprReuseSetup);
+            cpr_accumulate_  =  EWOMS_GET_PARAM(TypeTag, int, CprAccumulate);
             linear_solver_configuration_json_file_ = EWOMS_GET_PARAM(TypeTag, std::string, LinearSolverConfigurationJsonFile);
+            linear_solver_dump_prefix_ = EWOMS_GET_PARAM(TypeTag, std::string, LinearSolverDumpPrefix);
+            linear_solver_dump_interval_ = EWOMS_GET_PARAM(TypeTag, int, LinearSolverDumpInterval);
         }
 
         template <class TypeTag>
@@ -199,12 +237,16 @@ namespace Opm
             EWOMS_REGISTER_PARAM(TypeTag, double, IluRelaxation, "The relaxation factor of the linear solver's ILU preconditioner");
             EWOMS_REGISTER_PARAM(TypeTag, int, LinearSolverMaxIter, "The maximum number of iterations of the linear solver");
             EWOMS_REGISTER_PARAM(TypeTag, int, LinearSolverRestart, "The number of iterations after which GMRES is restarted");
+            EWOMS_REGISTER_PARAM(TypeTag, int, LinearSolverRecycleSize, "The number of previous solutions used to deflate the following linear solves (0 disables recycling). Each needs the memory of two solution vectors");
             EWOMS_REGISTER_PARAM(TypeTag, int, FlowLinearSolverVerbosity, "The verbosity level of the linear solver (0: off, 2: all)");
             EWOMS_REGISTER_PARAM(TypeTag, int, IluFillinLevel, "The fill-in level of the linear solver's ILU preconditioner");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, MiluVariant, "Specify which variant of the modified-ILU preconditioner ought to be used. Possible variants are: ILU (default, plain ILU), MILU_1 (lump diagonal with dropped row entries), MILU_2 (lump diagonal with the sum of the absolute values of the dropped row  entries), MILU_3 (if diagonal is positive add sum of dropped row entrires. Otherwise substract them), MILU_4 (if diagonal is positive add sum of dropped row entrires. Otherwise do nothing");
             EWOMS_REGISTER_PARAM(TypeTag, bool, IluRedblack, "Use red-black partioning for the ILU preconditioner");
             EWOMS_REGISTER_PARAM(TypeTag, bool, IluReorderSpheres, "Whether to reorder the entries of the matrix in the red-black ILU preconditioner in spheres starting at an edge. If false the original ordering is preserved in each color. Otherwise why try to ensure D4 ordering (in a 2D structured grid, the diagonal elements are consecutive).");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, IluReorderRcm, "Reorder the matrix with reverse Cuthill-McKee for the ILU preconditioner (ignored if red-black partitioning is used). This reduces the bandwidth of the factors.");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, IluSpeculativeColoring, "Color the matrix for the red-black ILU preconditioner in parallel with a speculative greedy coloring instead of the sequential Welsh-Powell coloring. It may need more colors for dense stencils.");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseGmres, "Use GMRES as the linear solver");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, UseFusedBicgstab, "Use a BiCGSTAB variant which combines the global reductions of each iteration into two (ignored if GMRES is used)");
             EWOMS_REGISTER_PARAM(TypeTag, bool, LinearSolverRequireFullSparsityPattern, "Produce the full sparsity pattern for the linear solver");
             EWOMS_REGISTER_PARAM(TypeTag, bool, LinearSolverIgnoreConvergenceFailure, "Continue with the simulation like nothing happened after the linear solver did not converge");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseAmg, "Use AMG as the linear solver's preconditioner");
@@ -216,7 +258,10 @@ namespace Opm
             EWOMS_REGISTER_PARAM(TypeTag, int, CprMaxEllIter, "MaxIterations of the elliptic pressure part of the cpr solver");
             EWOMS_REGISTER_PARAM(TypeTag, int, CprEllSolvetype, "Solver type of elliptic pressure solve (0: bicgstab, 1: cg, 2: only amg preconditioner)");
             EWOMS_REGISTER_PARAM(TypeTag, int, CprReuseSetup, "Reuse Amg Setup");
+            EWOMS_REGISTER_PARAM(TypeTag, int, CprAccumulate, "Gather the coarse levels of the cpr AMG onto fewer processes in parallel runs (0: off, 1: onto one process with a direct coarse solve, 2: successively onto fewer processes)");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, LinearSolverConfigurationJsonFile, "Filename of JSON configuration for flexible linear solver system.");
+            EWOMS_REGISTER_PARAM(TypeTag, std::string, LinearSolverDumpPrefix, "Write the linear systems to files starting with this prefix, for replay with flow_linsolve_bench (empty: no output)");
+            EWOMS_REGISTER_PARAM(TypeTag, int, LinearSolverDumpInterval, "Only write every n-th linear system if --linear-solver-dump-prefix is given");
         }
 
         FlowLinearSolverParameters() { reset(); }
@@ -226,9 +271,11 @@ namespace Opm
         {
             use_cpr_     = false;
             newton_use_gmres_        = false;
+            use_fused_bicgstab_      = false;
             linear_solver_reduction_ = 1e-2;
             linear_solver_maxiter_   = 150;
             linear_solver_restart_   = 40;
+            linear_solver_recycle_size_ = 0;
             linear_solver_verbosity_ = 0;
             require_full_sparsity_pattern_ = false;
             ignoreConvergenceFailure_ = false;
@@ -238,6 +285,11 @@ namespace Opm
             ilu_milu_                 = MILU_VARIANT::ILU;
             ilu_redblack_             = false;
             ilu_reorder_sphere_       = true;
+            ilu_reorder_rcm_          = false;
+            ilu_speculative_coloring_ = false;
+            linear_solver_configuration_json_file_ = "none";
+            linear_solver_dump_prefix_ = "";
+            linear_solver_dump_interval_ = 1;
         }
     };
 
@@ -0,0 +1,311 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_FUSEDBICGSTABSOLVER_HEADER_INCLUDED
+#define OPM_FUSEDBICGSTABSOLVER_HEADER_INCLUDED
+
+#include <dune/common/timer.hh>
+#include <dune/common/version.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/owneroverlapcopy.hh>
+#include <dune/istl/paamg/pinfo.hh>
+#include <dune/istl/preconditioner.hh>
+#include <dune/istl/solver.hh>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+/// \brief BiCGSTAB with fused global reductions.
+///
+/// The standard BiCGSTAB needs five global reductions per iteration
+/// (rho, alpha, the two for omega and the defect norms), each of which is
+/// a blocking allreduce in parallel runs. This variant computes all inner
+/// products needed at a synchronization point in a single pass over the
+/// vectors and sums them with a single collective call, which leaves two
+/// reductions per iteration:
+///  - (r~,v), (r,r), (r,v) and (v,v) after the first matrix-vector product, and
+///  - (t,s), (t,t), (s,s), (r~,s) and (r~,t) after the second one.
+/// The defect norms of s and of the new r and the next rho are obtained
+/// from these by expanding the vector updates. As this is subject to
+/// cancellation, convergence is always confirmed with a true defect norm.
+///
+/// \tparam X The vector type.
+/// \tparam Comm The parallel information, e.g. Dune::OwnerOverlapCopyCommunication
+///              or Dune::Amg::SequentialInformation.
+template <class X, class Comm>
+class FusedBiCGSTABSolver : public Dune::InverseOperator<X, X>
+{
+public:
+    using domain_type = X;
+    using range_type = X;
+    using field_type = typename X::field_type;
+
+    /// \param op The (parallel) linear operator.
+    /// \param prec The (parallel) preconditioner.
+    /// \param comm The parallel information, only used during construction.
+    /// \param reduction The relative defect reduction to achieve.
+    /// \param maxit The maximum number of iterations.
+    /// \param verbose The verbosity level (0: silent, 1: summary, 2: every iteration).
+    FusedBiCGSTABSolver(Dune::LinearOperator<X, X>& op,
+                        Dune::Preconditioner<X, X>& prec,
+                        const Comm& comm,
+                        double reduction, int maxit, int verbose)
+        : op_(op)
+        , prec_(prec)
+        , reduction_(reduction)
+        , maxit_(maxit)
+        , verbose_(verbose)
+    {
+        setupCommunication_(comm);
+    }
+
+    virtual void apply(X& x, X& b, Dune::InverseOperatorResult& res) override
+    {
+        apply(x, b, reduction_, res);
+    }
+
+    virtual void apply(X& x, X& b, double reduction, Dune::InverseOperatorResult& res) override
+    {
+        using std::abs;
+        const double eps = std::numeric_limits<double>::min();
+        Dune::Timer watch;
+        res.clear();
+        buildOwnerMask_(b.size());
+
+        // r = b - A x, overwriting b.
+        X& r = b;
+        op_.applyscaleadd(-1.0, x, r);
+
+        X rt(r), p(r), v(r), y(r), z(r), t(r);
+        p = 0.0;
+        v = 0.0;
+
+        const double def0 = std::sqrt(globalDots_<1>({{{&r, &r}}})[0]);
+        if (verbose_ > 0) {
+            std::cout << "=== FusedBiCGSTABSolver" << std::endl;
+            if (verbose_ > 1) {
+                printOutput_(0.0, def0, def0);
+            }
+        }
+        if (def0 < 1e-30) {
+            res.converged = true;
+            res.iterations = 0;
+            res.reduction = 0.0;
+            res.conv_rate = 0.0;
+            res.elapsed = watch.elapsed();
+            return;
+        }
+
+        double rho = 1.0;
+        double alpha = 1.0;
+        double omega = 1.0;
+        double rhoNew = def0 * def0; // (r~, r) with r~ = r
+        double def = def0;
+        double it = 0.0;
+        bool converged = false;
+
+        for (it = 0.5; it < maxit_; it += 0.5) {
+            if (abs(rho) < eps || abs(omega) < eps) {
+                breakdown_("rho or omega", res, watch, def0, def, it);
+                return;
+            }
+            const double beta = (rhoNew / rho) * (alpha / omega);
+            rho = rhoNew;
+
+            // p = r + beta (p - omega v)
+            p.axpy(-omega, v);
+            p *= beta;
+            p += r;
+
+            // v = A M^{-1} p
+            y = 0.0;
+            prec_.apply(y, p);
+            op_.apply(y, v);
+
+            const auto dotsV = globalDots_<4>({{{&rt, &v}, {&r, &r}, {&r, &v}, {&v, &v}}});
+            if (abs(dotsV[0]) < eps) {
+                breakdown_("(r~, v)", res, watch, def0, def, it);
+                return;
+            }
+            alpha = rho / dotsV[0];
+
+            // s = r - alpha v, stored in r
+            x.axpy(alpha, y);
+            r.axpy(-alpha, v);
+            def = std::sqrt(std::max(dotsV[1] - 2.0 * alpha * dotsV[2] + alpha * alpha * dotsV[3], 0.0));
+            if (verbose_ > 1) {
+                printOutput_(it, def, def0);
+            }
+            if (checkConvergence_(r, def, def0, reduction)) {
+                converged = true;
+                break;
+            }
+
+            // t = A M^{-1} s
+            it += 0.5;
+            z = 0.0;
+            prec_.apply(z, r);
+            op_.apply(z, t);
+
+            const auto dotsT = globalDots_<5>({{{&t, &r}, {&t, &t}, {&r, &r}, {&rt, &r}, {&rt, &t}}});
+            if (dotsT[1] < eps) {
+                breakdown_("(t, t)", res, watch, def0, def, it);
+                return;
+            }
+            omega = dotsT[0] / dotsT[1];
+
+            // r = s - omega t
+            x.axpy(omega, z);
+            r.axpy(-omega, t);
+            def = std::sqrt(std::max(dotsT[2] - 2.0 * omega * dotsT[0] + omega * omega * dotsT[1], 0.0));
+            rhoNew = dotsT[3] - omega * dotsT[4];
+            if (verbose_ > 1) {
+                printOutput_(it, def, def0);
+            }
+            if (checkConvergence_(r, def, def0, reduction)) {
+                converged = true;
+                break;
+            }
+        }
+
+        it = std::min(it, static_cast<double>(maxit_));
+        res.converged = converged;
+        res.iterations = static_cast<int>(std::ceil(it));
+        res.reduction = def / def0;
+        res.conv_rate = std::pow(res.reduction, 1.0 / it);
+        res.elapsed = watch.elapsed();
+
+        if (verbose_ > 0) {
+            std::cout << "=== rate=" << res.conv_rate << ", T=" << res.elapsed
+                      << ", TIT=" << res.elapsed / it << ", IT=" << it << std::endl;
+        }
+    }
+
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
+    virtual Dune::SolverCategory::Category category() const override
+    {
+        return op_.category();
+    }
+#endif
+
+private:
+    using VectorPair = std::pair<const X*, const X*>;
+
+    template <class C>
+    void setupCommunication_(const C& comm)
+    {
+        // Only the owner entries contribute to the inner products.
+        for (const auto& index : comm.indexSet()) {
+            if (index.local().attribute() != Dune::OwnerOverlapCopyAttributeSet::owner) {
+                nonOwnerIndices_.push_back(index.local().local());
+            }
+        }
+        auto collective = comm.communicator();
+        globalSum_ = [collective](double* values, int n) { collective.sum(values, n); };
+    }
+
+    void setupCommunication_(const Dune::Amg::SequentialInformation&)
+    {
+        globalSum_ = [](double*, int) {};
+    }
+
+    void buildOwnerMask_(std::size_t size)
+    {
+        if (nonOwnerIndices_.empty() || ownerMask_.size() == size) {
+            return;
+        }
+        ownerMask_.assign(size, 1.0);
+        for (const auto index : nonOwnerIndices_) {
+            ownerMask_[index] = 0.0;
+        }
+    }
+
+    /// Compute N inner products in one sweep and one global reduction.
+    template <int N>
+    std::array<double, N> globalDots_(const std::array<VectorPair, N>& pairs) const
+    {
+        std::array<double, N> sums;
+        sums.fill(0.0);
+        const std::size_t size = pairs[0].first->size();
+        for (std::size_t i = 0; i < size; ++i) {
+            if (!ownerMask_.empty() && ownerMask_[i] == 0.0) {
+                continue;
+            }
+            for (int k = 0; k < N; ++k) {
+                sums[k] += (*pairs[k].first)[i] * (*pairs[k].second)[i];
+            }
+        }
+        globalSum_(sums.data(), N);
+        return sums;
+    }
+
+    /// If the defect from the recurrence indicates convergence, replace
+    /// it by the true defect and check again.
+    bool checkConvergence_(const X& r, double& def, double def0, double reduction) const
+    {
+        if (def >= def0 * reduction) {
+            return false;
+        }
+        def = std::sqrt(globalDots_<1>({{{&r, &r}}})[0]);
+        return def < def0 * reduction;
+    }
+
+    void breakdown_(const char* what, Dune::InverseOperatorResult& res, const Dune::Timer& watch,
+                    double def0, double def, double it) const
+    {
+        if (verbose_ > 0) {
+            std::cout << "=== FusedBiCGSTABSolver: breakdown in " << what << std::endl;
+        }
+        res.converged = false;
+        res.iterations = static_cast<int>(std::ceil(it));
+        res.reduction = def / def0;
+        res.conv_rate = std::pow(res.reduction, 1.0 / std::max(it, 0.5));
+        res.elapsed = watch.elapsed();
+    }
+
+    void printOutput_(double it, double def, double def0) const
+    {
+        std::cout << std::setw(5) << it << "  "
+                  << std::setw(12) << std::scientific << def << "  "
+                  << std::setw(12) << def / def0 << std::defaultfloat << std::endl;
+    }
+
+    Dune::LinearOperator<X, X>& op_;
+    Dune::Preconditioner<X, X>& prec_;
+    double reduction_;
+    int maxit_;
+    int verbose_;
+    std::vector<std::size_t> nonOwnerIndices_;
+    std::vector<double> ownerMask_;
+    std::function<void(double*, int)> globalSum_;
+};
+
+} // namespace Opm
+
+#endif // OPM_FUSEDBICGSTABSOLVER_HEADER_INCLUDED
@@ -24,7 +24,9 @@
 #include <tuple>
 #include <algorithm>
 #include <numeric>
+#include <map>
 #include <queue>
+#include <limits>
 #include <cstddef>
 
 namespace Opm
@@ -103,6 +105,166 @@ std::size_t breadthFirstSearch(const Graph& graph, typename Graph::VertexDescrip
     }
     return noVisited;
 }
+
+/// \brief Find a pseudo-peripheral vertex in the component of root.
+///
+/// Uses the heuristic of George and Liu: Repeatedly start a level
+/// structure at the vertex of minimum degree in the last level until the
+/// eccentricity does not grow any more.
+/// \param level Work array with an entry of -1 for each vertex. Only the
+///        entries of the component of root are used, and they are reset
+///        to -1 before returning.
+template<class Graph>
+typename Graph::VertexDescriptor
+pseudoPeripheralVertex(const Graph& graph, typename Graph::VertexDescriptor root,
+                       const std::vector<std::size_t>& degrees,
+                       std::vector<int>& level)
+{
+    using Vertex = typename Graph::VertexDescriptor;
+    std::vector<Vertex> touched;
+    int eccentricity = -1;
+    auto resetLevels = [&level, &touched]()
+        {
+            for ( auto vertex: touched )
+            {
+                level[vertex] = -1;
+            }
+            touched.clear();
+        };
+
+    while ( true )
+    {
+        resetLevels();
+        touched.push_back(root);
+        level[root] = 0;
+
+        for ( std::size_t next = 0; next < touched.size(); ++next )
+        {
+            auto current = touched[next];
+            for(auto edge = graph.beginEdges(current),
+                    endEdge = graph.endEdges(current);
+                edge != endEdge; ++edge)
+            {
+                if ( level[edge.target()] < 0 )
+                {
+                    level[edge.target()] = level[current] + 1;
+                    touched.push_back(edge.target());
+                }
+            }
+        }
+
+        const int lastLevel = level[touched.back()];
+        if ( lastLevel <= eccentricity )
+        {
+            resetLevels();
+            return root;
+        }
+        eccentricity = lastLevel;
+
+        // vertices are stored level by level, hence the last level is a suffix.
+        Vertex candidate = touched.back();
+        for ( auto vertex = touched.rbegin();
+              vertex != touched.rend() && level[*vertex] == lastLevel; ++vertex )
+        {
+            if ( degrees[*vertex] < degrees[candidate] )
+            {
+                candidate = *vertex;
+            }
+        }
+        if ( candidate == root )
+        {
+            resetLevels();
+            return root;
+        }
+        root = candidate;
+    }
+}
+
+/// \brief Swap the colors 0 and 1 in parts of the graph that were colored
+/// independently, such that few edges between the parts connect vertices
+/// of the same color.
+///
+/// Coloring a connected bipartite part in breadth first order gives a
+/// checkerboard with one of two phases. Aligning the phases removes most
+/// of the conflicts that would need additional colors.
+/// \param component The smallest vertex of the part of each vertex.
+/// \param blockSize The vertices of a part lie in the same block of
+///        consecutive vertices of this size.
+template<class Graph>
+void alignComponentColors(const Graph& graph, std::vector<int>& colors,
+                          const std::vector<typename Graph::VertexDescriptor>& component,
+                          std::size_t blockSize)
+{
+    using Vertex = typename Graph::VertexDescriptor;
+    const std::ptrdiff_t noVertices = colors.size();
+    const std::ptrdiff_t noBlocks = (noVertices + blockSize - 1) / blockSize;
+    // For each part and each preceding neighbouring part the number of
+    // edges in conflict if both keep their colors, and if one of them swaps.
+    using Count = std::pair<std::size_t, std::size_t>;
+    std::vector<std::map<std::pair<Vertex, Vertex>, Count> > conflicts(noBlocks);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for ( std::ptrdiff_t b = 0; b < noBlocks; ++b )
+    {
+        const std::ptrdiff_t end = std::min((b + 1) * std::ptrdiff_t(blockSize), noVertices);
+        for ( std::ptrdiff_t vertex = b * blockSize; vertex < end; ++vertex )
+        {
+            if ( colors[vertex] > 1 )
+            {
+                continue;
+            }
+            for(auto edge = graph.beginEdges(vertex),
+                    endEdge = graph.endEdges(vertex);
+                edge != endEdge; ++edge)
+            {
+                const auto target = edge.target();
+                if ( component[target] < component[vertex] && colors[target] <= 1 )
+                {
+                    auto& count = conflicts[b][std::make_pair(component[vertex], component[target])];
+                    if ( colors[target] == colors[vertex] )
+                    {
+                        ++count.first;
+                    }
+                    else
+                    {
+                        ++count.second;
+                    }
+                }
+            }
+        }
+    }
+
+    // Decide in the order of the parts, the map is sorted by part.
+    std::vector<char> swapped(noVertices, false);
+    for ( const auto& blockConflicts: conflicts )
+    {
+        for ( auto entry = blockConflicts.begin(); entry != blockConflicts.end(); )
+        {
+            const Vertex part = entry->first.first;
+            std::size_t keep = 0, swap = 0;
+            for ( ; entry != blockConflicts.end() && entry->first.first == part; ++entry )
+            {
+                const bool other = swapped[entry->first.second];
+                keep += other ? entry->second.second : entry->second.first;
+                swap += other ? entry->second.first : entry->second.second;
+            }
+            swapped[part] = swap < keep;
+        }
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for ( std::ptrdiff_t vertex = 0; vertex < noVertices; ++vertex )
+    {
+        if ( swapped[component[vertex]] && colors[vertex] <= 1 )
+        {
+            colors[vertex] = 1 - colors[vertex];
+        }
+    }
+}
 } // end namespace Detail
 
 
@@ -179,6 +341,218 @@ colorVerticesWelshPowell(const Graph& graph)
     return std::make_tuple(colors, color, verticesPerColor);
 }
 
+/// \brief Color the vertices of graph in parallel.
+///
+/// Speculative greedy coloring with conflict resolution (Gebremedhin and
+/// Manne). The pending vertices are split into blocks of consecutive
+/// vertices, and the blocks are colored concurrently by first fit in
+/// breadth first order. While doing so only colors fixed in earlier rounds
+/// and colors of the same block are taken into account. After the first
+/// round the colors 0 and 1 of the independently colored parts are aligned
+/// with Detail::alignComponentColors. Then a vertex that has the same color
+/// as a smaller neighbour of another block is uncolored again and handled
+/// in the next round. As the first block never has conflicts every round
+/// makes progress.
+///
+/// The result does not depend on the number of threads. For bipartite
+/// graphs, like the ones of two point flux matrices on structured grids,
+/// it is a checkerboard like the one of colorVerticesWelshPowell. For
+/// denser stencils the block boundaries cost some additional colors.
+/// \param graph The graph to color. Must adhere to the graph interface of dune-istl
+///              and have the vertices 0, ..., maxVertex().
+/// \param blockSize The number of vertices colored sequentially by one thread.
+///        Zero selects a 64th of the vertices, but at least 4096.
+/// \return The same as colorVerticesWelshPowell.
+template<class Graph>
+std::tuple<std::vector<int>, int, std::vector<std::size_t> >
+colorVerticesSpeculative(const Graph& graph, std::size_t blockSize = 0)
+{
+    using Vertex = typename Graph::VertexDescriptor;
+    const std::size_t noVertices = graph.maxVertex() + 1;
+    if ( blockSize == 0 )
+    {
+        blockSize = std::max(noVertices / 64, std::size_t(4096));
+    }
+    std::vector<int> colors(noVertices, -1);
+    // Block of the vertex in the current round, -1 if its color is fixed.
+    std::vector<std::ptrdiff_t> block(noVertices, -1);
+    std::vector<char> conflict(noVertices, false);
+    // Smallest vertex of the connected part of the block of the vertex, and
+    // the parity of the level of the vertex in a breadth first search of it.
+    std::vector<Vertex> component(noVertices);
+    std::vector<char> parity(noVertices, 0);
+    std::vector<Vertex> pending(noVertices);
+    std::iota(pending.begin(), pending.end(), Vertex(0));
+
+    while ( !pending.empty() )
+    {
+        const std::ptrdiff_t noPending = pending.size();
+        const std::ptrdiff_t noBlocks = (noPending + blockSize - 1) / blockSize;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for ( std::ptrdiff_t i = 0; i < noPending; ++i )
+        {
+            block[pending[i]] = i / blockSize;
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            // forbidden[c] == vertex + 1 if color c is used by a neighbour of vertex
+            std::vector<std::size_t> forbidden;
+            std::vector<Vertex> queue;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+            for ( std::ptrdiff_t b = 0; b < noBlocks; ++b )
+            {
+                const std::ptrdiff_t end = std::min((b + 1) * std::ptrdiff_t(blockSize), noPending);
+                // Breadth first search in the block, starting a new part at
+                // each vertex not yet reached. Reached vertices are marked
+                // with color -2.
+                for ( std::ptrdiff_t i = b * blockSize; i < end; ++i )
+                {
+                    if ( colors[pending[i]] != -1 )
+                    {
+                        continue;
+                    }
+                    queue.clear();
+                    queue.push_back(pending[i]);
+                    colors[pending[i]] = -2;
+                    parity[pending[i]] = 0;
+                    bool bipartite = true;
+                    for ( std::size_t next = 0; next < queue.size(); ++next )
+                    {
+                        const Vertex vertex = queue[next];
+                        component[vertex] = pending[i];
+                        for(auto edge = graph.beginEdges(vertex),
+                                endEdge = graph.endEdges(vertex);
+                            edge != endEdge; ++edge)
+                        {
+                            const auto target = edge.target();
+                            if ( block[target] != b || target == vertex )
+                            {
+                                continue;
+                            }
+                            if ( colors[target] == -1 )
+                            {
+                                colors[target] = -2;
+                                parity[target] = !parity[vertex];
+                                queue.push_back(target);
+                            }
+                            else if ( parity[target] == parity[vertex] )
+                            {
+                                bipartite = false;
+                            }
+                        }
+                    }
+                    if ( !bipartite )
+                    {
+                        for ( auto vertex: queue )
+                        {
+                            parity[vertex] = 0;
+                        }
+                    }
+                }
+
+                // First fit in vertex order. In bipartite parts the parity of
+                // the level in the search is preferred, which gives two colors
+                // even if the part was entered at several places.
+                for ( std::ptrdiff_t i = b * blockSize; i < end; ++i )
+                {
+                    const Vertex vertex = pending[i];
+                    const std::size_t stamp = vertex + 1;
+                    for(auto edge = graph.beginEdges(vertex),
+                            endEdge = graph.endEdges(vertex);
+                        edge != endEdge; ++edge)
+                    {
+                        const auto target = edge.target();
+                        if ( target == vertex ||
+                             ( block[target] >= 0 && block[target] != b ) )
+                        {
+                            continue; // being colored concurrently
+                        }
+                        const int color = colors[target];
+                        if ( color >= 0 )
+                        {
+                            if ( std::size_t(color) >= forbidden.size() )
+                            {
+                                forbidden.resize(color + 1, 0);
+                            }
+                            forbidden[color] = stamp;
+                        }
+                    }
+                    int color = parity[vertex];
+                    if ( std::size_t(color) < forbidden.size() && forbidden[color] == stamp )
+                    {
+                        color = 0;
+                        while ( std::size_t(color) < forbidden.size() && forbidden[color] == stamp )
+                        {
+                            ++color;
+                        }
+                    }
+                    colors[vertex] = color;
+                }
+            }
+        }
+
+        if ( noPending == std::ptrdiff_t(noVertices) )
+        {
+            Detail::alignComponentColors(graph, colors, component, blockSize);
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for ( std::ptrdiff_t i = 0; i < noPending; ++i )
+        {
+            const Vertex vertex = pending[i];
+            conflict[vertex] = false;
+            for(auto edge = graph.beginEdges(vertex),
+                    endEdge = graph.endEdges(vertex);
+                edge != endEdge; ++edge)
+            {
+                const auto target = edge.target();
+                if ( target < vertex && block[target] >= 0 &&
+                     block[target] != block[vertex] &&
+                     colors[target] == colors[vertex] )
+                {
+                    conflict[vertex] = true;
+                    break;
+                }
+            }
+        }
+
+        auto newEnd = std::remove_if(pending.begin(), pending.end(),
+                                     [&](const Vertex& vertex)
+                                     {
+                                         if ( conflict[vertex] )
+                                         {
+                                             colors[vertex] = -1;
+                                             return false;
+                                         }
+                                         block[vertex] = -1;
+                                         return true;
+                                     });
+        pending.resize(newEnd - pending.begin());
+    }
+
+    int noColors = 0;
+    for ( auto color: colors )
+    {
+        noColors = std::max(noColors, color + 1);
+    }
+    std::vector<std::size_t> verticesPerColor(noColors, 0);
+    for ( auto color: colors )
+    {
+        ++verticesPerColor[color];
+    }
+    return std::make_tuple(colors, noColors, verticesPerColor);
+}
+
 /// \! Reorder colored graph preserving order of vertices with the same color.
 template<class Graph>
 std::vector<std::size_t>
@@ -241,5 +615,89 @@ reorderVerticesSpheres(const std::vector<int>& colors, int noColors,
     }
     return indices;
 }
+
+/// \brief Reorder the vertices with the reverse Cuthill-McKee algorithm.
+///
+/// This reduces the bandwidth (and profile) of the matrix, which
+/// usually improves data locality of the triangular solves and the
+/// quality of a subsequent incomplete factorization.
+/// \param graph The graph to reorder. Must adhere to the graph interface of dune-istl.
+/// \param clusterKeys Optional key per vertex (e.g. a region number). If not empty,
+///        the neighbours added to the same level are sorted by key first and
+///        degree second, such that vertices with the same key stay close together.
+/// \return The new index of each vertex.
+template<class Graph>
+std::vector<std::size_t>
+reorderVerticesReverseCuthillMcKee(const Graph& graph,
+                                   const std::vector<int>& clusterKeys = std::vector<int>())
+{
+    using Vertex = typename Graph::VertexDescriptor;
+    const std::size_t noVertices = graph.maxVertex() + 1;
+    std::vector<std::size_t> degrees(noVertices, 0);
+
+    for(auto vertex: graph)
+    {
+        for(auto edge = graph.beginEdges(vertex),
+                endEdge = graph.endEdges(vertex);
+            edge != endEdge; ++edge)
+        {
+            ++degrees[vertex];
+        }
+    }
+
+    auto less = [&degrees, &clusterKeys](const Vertex& v1, const Vertex& v2)
+        {
+            if ( !clusterKeys.empty() && clusterKeys[v1] != clusterKeys[v2] )
+            {
+                return clusterKeys[v1] < clusterKeys[v2];
+            }
+            return degrees[v1] < degrees[v2];
+        };
+
+    std::vector<Vertex> order;
+    order.reserve(noVertices);
+    std::vector<bool> visited(noVertices, false);
+    std::vector<Vertex> neighbours;
+    std::vector<int> level(noVertices, -1);
+
+    for(auto start: graph)
+    {
+        if ( visited[start] )
+        {
+            continue;
+        }
+        // start every connected component at a pseudo-peripheral vertex
+        auto root = Detail::pseudoPeripheralVertex(graph, Vertex(start), degrees, level);
+        std::size_t next = order.size();
+        order.push_back(root);
+        visited[root] = true;
+
+        for ( ; next < order.size(); ++next )
+        {
+            auto current = order[next];
+            neighbours.clear();
+            for(auto edge = graph.beginEdges(current),
+                    endEdge = graph.endEdges(current);
+                edge != endEdge; ++edge)
+            {
+                if ( ! visited[edge.target()] )
+                {
+                    visited[edge.target()] = true;
+                    neighbours.push_back(edge.target());
+                }
+            }
+            std::stable_sort(neighbours.begin(), neighbours.end(), less);
+            order.insert(order.end(), neighbours.begin(), neighbours.end());
+        }
+    }
+
+    std::vector<std::size_t> indices(noVertices);
+    std::size_t newIndex = order.size();
+    for(auto vertex: order)
+    {
+        indices[vertex] = --newIndex;
+    }
+    return indices;
+}
 } // end namespace Opm
 #endif
@@ -23,11 +23,15 @@
 
 #include <opm/simulators/linalg/MatrixBlock.hpp>
 #include <opm/simulators/linalg/BlackoilAmg.hpp>
+#include <opm/simulators/linalg/FusedBiCGSTABSolver.hpp>
+#include <opm/simulators/linalg/LinearSystemIO.hpp>
+#include <opm/simulators/linalg/RecycledKrylovSpace.hpp>
 #include <opm/simulators/linalg/CPRPreconditioner.hpp>
 #include <opm/simulators/linalg/ParallelRestrictedAdditiveSchwarz.hpp>
 #include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
 #include <opm/simulators/linalg/ExtractParallelGridInformationToISTL.hpp>
 #include <opm/simulators/linalg/findOverlapRowsAndColumns.hpp>
+#include <opm/simulators/linalg/iluClusterKeys.hpp>
 #include <opm/common/Exceptions.hpp>
 #include <opm/simulators/linalg/ParallelIstlInformation.hpp>
 #include <opm/common/utility/platform_dependent/disable_warnings.h>
@@ -35,6 +39,7 @@
 
 #include <ewoms/common/parametersystem.hh>
 #include <ewoms/common/propertysystem.hh>
+#include <ewoms/parallel/threadedentityiterator.hh>
 
 #include <dune/istl/scalarproducts.hh>
 #include <dune/istl/operators.hh>
@@ -45,6 +50,11 @@
 
 #include <opm/common/utility/platform_dependent/reenable_warnings.h>
 
+#include <algorithm>
+#include <exception>
+#include <set>
+#include <vector>
+
 BEGIN_PROPERTIES
 
 NEW_TYPE_TAG(FlowIstlSolver, INHERITS_FROM(FlowIstlSolverParams));
@@ -239,65 +249,115 @@ protected:
               converged_(false)
         {
             parameters_.template init<TypeTag>();
+            reduction_ = parameters_.linear_solver_reduction_;
+            recycledSpace_.setMaxSize(parameters_.linear_solver_recycle_size_);
+            dumper_ = LinearSystemDumper(parameters_.linear_solver_dump_prefix_,
+                                         parameters_.linear_solver_dump_interval_,
+                                         simulator_.gridView().comm().rank());
             extractParallelGridInformationToISTL(simulator_.vanguard().grid(), parallelInformation_);
             detail::findOverlapRowsAndColumns(simulator_.vanguard().grid(),overlapRowAndColumns_);
         }
 
-        // nothing to clean here
         void eraseMatrix() {
             matrix_for_preconditioner_.reset();
+            forgetMatrixTopology();
         }
 
         void prepare(const SparseMatrixAdapter& M, Vector& b)
         {
+            checkMatrixTopology(M.istlMatrix());
             matrix_.reset(new Matrix(M.istlMatrix()));
             rhs_ = &b;
-            this->scaleSystem();
+            this->scaleAndDumpSystem();
+        }
+
+        /// Forget everything derived from the sparsity pattern of the
+        /// matrix if the simulator handed over a different matrix than
+        /// before. The matrix is copied in prepare(), so the pattern is
+        /// identified by the address and the size of the source matrix.
+        void checkMatrixTopology(const Matrix& source)
+        {
+            if (&source != sourceMatrix_ || source.N() != sourceSize_ || source.nonzeroes() != sourceNonzeroes_) {
+                forgetMatrixTopology();
+                if (parameters_.ilu_reorder_rcm_) {
+                    // keep the cells of a region together in the ILU ordering
+                    iluOrderingCache_->setClusterKeys(detail::iluClusterKeys(simulator_.problem(), source.N()));
+                }
+                sourceMatrix_ = &source;
+                sourceSize_ = source.N();
+                sourceNonzeroes_ = source.nonzeroes();
+            }
+        }
+
+        void forgetMatrixTopology()
+        {
+            iluOrderingCache_->clear();
+            diagonalOffsets_.clear();
+            sourceMatrix_ = nullptr;
+        }
+
+        /// Scale the system and write it to file if requested.
+        void scaleAndDumpSystem()
+        {
+            const bool dump = dumper_.due();
+            const bool matrix_cont_added = EWOMS_GET_PARAM(TypeTag, bool, MatrixAddWellContributions);
+            if (dump && !matrix_cont_added) {
+                // The well contributions are not scaled, so write before scaling.
+                const Matrix A = matrixWithWellContributions();
+                dumper_.write(A, *rhs_, quasiImpesWeights(A));
+            }
+            scaleSystem();
+            if (dump && matrix_cont_added) {
+                // The weights of the system strategy, if it has any.
+                const bool haveWeights = weights_.size() == rhs_->size();
+                dumper_.write(*matrix_, *rhs_, haveWeights ? weights_ : quasiImpesWeights(*matrix_));
+            }
         }
 
         void scaleSystem()
         {
             const bool matrix_cont_added = EWOMS_GET_PARAM(TypeTag, bool, MatrixAddWellContributions);
 
+            // Weights not computed in advance are computed by scaleRows().
+            WeightsSource source = WeightsSource::Given;
+            BlockVector constantWeights(0.0);
+            bool form_cpr = false;
             if (matrix_cont_added) {
-                bool form_cpr = true;
+                form_cpr = true;
                 if (parameters_.system_strategy_ == "quasiimpes") {
-                    weights_ = getQuasiImpesWeights();
+                    source = WeightsSource::QuasiImpes;
                 } else if (parameters_.system_strategy_ == "trueimpes") {
                     weights_ = getStorageWeights();
                 } else if (parameters_.system_strategy_ == "simple") {
-                    BlockVector bvec(1.0);
-                    weights_ = getSimpleWeights(bvec);
+                    source = WeightsSource::Constant;
+                    constantWeights = 1.0;
                 } else if (parameters_.system_strategy_ == "original") {
-                    BlockVector bvec(0.0);
-                    bvec[pressureEqnIndex] = 1;
-                    weights_ = getSimpleWeights(bvec);
+                    source = WeightsSource::Constant;
+                    constantWeights[pressureEqnIndex] = 1;
                 } else {
                     if (parameters_.system_strategy_ != "none") {
                         OpmLog::warning("unknown_system_strategy", "Unknown linear solver system strategy: '" + parameters_.system_strategy_ + "', applying 'none' strategy.");
                     }
                     form_cpr = false;
                 }
-                if (parameters_.scale_linear_system_) {
-                    // also scale weights
-                    this->scaleEquationsAndVariables(weights_);
-                }
-                if (form_cpr && !(parameters_.cpr_use_drs_)) {
-                    scaleMatrixAndRhs(weights_);
-                }
-                if (weights_.size() == 0) {
-                    // if weights are not set cpr_use_drs_=false;
-                    parameters_.cpr_use_drs_ = false;
-                }
             } else {
                 if (parameters_.use_cpr_ && parameters_.cpr_use_drs_) {
                    OpmLog::warning("DRS_DISABLE", "Disabling DRS as matrix does not contain well contributions");
                 }
                 parameters_.cpr_use_drs_ = false;
-                if (parameters_.scale_linear_system_) {
-                    // also scale weights
-                    this->scaleEquationsAndVariables(weights_);
-                }
+            }
+
+            if (source != WeightsSource::Given && weights_.size() != rhs_->size()) {
+                weights_ = Vector(rhs_->size());
+            }
+            const bool form_pressure_eq = form_cpr && !(parameters_.cpr_use_drs_);
+            if (source != WeightsSource::Given || parameters_.scale_linear_system_ || form_pressure_eq) {
+                // also scales the weights
+                scaleRows(source, constantWeights, parameters_.scale_linear_system_, form_pressure_eq);
+            }
+            if (matrix_cont_added && weights_.size() == 0) {
+                // if weights are not set cpr_use_drs_=false;
+                parameters_.cpr_use_drs_ = false;
             }
         }
 
@@ -357,6 +417,29 @@ protected:
         /// \copydoc NewtonIterationBlackoilInterface::iterations
         int iterations () const { return iterations_; }
 
+        /// \brief Set the relative residual reduction for the following solves.
+        ///
+        /// Used by inexact Newton methods. The reduction is never made stricter
+        /// than the configured LinearSolverReduction.
+        void setReduction(double reduction)
+        {
+            reduction_ = std::max(reduction, parameters_.linear_solver_reduction_);
+        }
+
+        /// The relative residual reduction the linear solver currently targets.
+        double reduction() const { return reduction_; }
+
+        /// \brief Time spent in the CPR setup and apply since the last call.
+        ///
+        /// The CPR preconditioner is rebuilt for every solve, so its times
+        /// are collected here after each solve.
+        Dune::Amg::TwoLevelMethodTimings takeCprTimings()
+        {
+            const auto timings = cpr_timings_;
+            cpr_timings_ = Dune::Amg::TwoLevelMethodTimings();
+            return timings;
+        }
+
         /// \copydoc NewtonIterationBlackoilInterface::parallelInformation
         const boost::any& parallelInformation() const { return parallelInformation_; }
 
@@ -418,7 +501,11 @@ protected:
                     constructAMGPrecond<Criterion>( linearOperator, parallelInformation_arg, amg, opA, relax, ilu_milu );
 
                     // Solve.
-                    solve(linearOperator, x, istlb, *sp, *amg, result);
+                    solve(linearOperator, x, istlb, *sp, *amg, parallelInformation_arg, result);
+
+                    const auto timings = amg->takeTimings();
+                    cpr_timings_.setup += timings.setup;
+                    cpr_timings_.apply += timings.apply;
                 }
                 else
                 {
@@ -429,7 +516,7 @@ protected:
                     constructAMGPrecond( linearOperator, parallelInformation_arg, amg, opA, relax, ilu_milu );
 
                     // Solve.
-                    solve(linearOperator, x, istlb, *sp, *amg, result);
+                    solve(linearOperator, x, istlb, *sp, *amg, parallelInformation_arg, result);
                 }
             }
             else
@@ -439,7 +526,7 @@ protected:
                 auto precond = constructPrecond(linearOperator, parallelInformation_arg);
 
                 // Solve.
-                solve(linearOperator, x, istlb, *sp, *precond, result);
+                solve(linearOperator, x, istlb, *sp, *precond, parallelInformation_arg, result);
             }
         }
 
@@ -461,7 +548,10 @@ protected:
             const MILU_VARIANT ilu_milu  = parameters_.ilu_milu_;
             const bool ilu_redblack = parameters_.ilu_redblack_;
             const bool ilu_reorder_spheres = parameters_.ilu_reorder_sphere_;
-            std::unique_ptr<SeqPreconditioner> precond(new SeqPreconditioner(opA.getmat(), ilu_fillin, relax, ilu_milu, ilu_redblack, ilu_reorder_spheres));
+            const bool ilu_reorder_rcm = parameters_.ilu_reorder_rcm_;
+            const bool ilu_speculative_coloring = parameters_.ilu_speculative_coloring_;
+            std::unique_ptr<SeqPreconditioner> precond(new SeqPreconditioner(opA.getmat(), ilu_fillin, relax, ilu_milu, ilu_redblack, ilu_reorder_spheres, ilu_reorder_rcm,
+                                                                             ilu_speculative_coloring, iluOrderingCache_));
             return precond;
         }
 
@@ -483,10 +573,14 @@ protected:
         {
             typedef std::unique_ptr<ParPreconditioner> Pointer;
             const double relax  = parameters_.ilu_relaxation_;
+            const int ilu_fillin = parameters_.ilu_fillin_level_;
             const MILU_VARIANT ilu_milu  = parameters_.ilu_milu_;
             const bool ilu_redblack = parameters_.ilu_redblack_;
             const bool ilu_reorder_spheres = parameters_.ilu_reorder_sphere_;
-            return Pointer(new ParPreconditioner(opA.getmat(), comm, relax, ilu_milu, ilu_redblack, ilu_reorder_spheres));
+            const bool ilu_reorder_rcm = parameters_.ilu_reorder_rcm_;
+            const bool ilu_speculative_coloring = parameters_.ilu_speculative_coloring_;
+            return Pointer(new ParPreconditioner(opA.getmat(), comm, ilu_fillin, relax, ilu_milu, ilu_redblack, ilu_reorder_spheres, ilu_reorder_rcm,
+                                                  ilu_speculative_coloring, iluOrderingCache_));
         }
 #endif
 
@@ -504,13 +598,15 @@ protected:
                             const MILU_VARIANT /* milu */ ) const
         {
             ISTLUtility::template createAMGPreconditionerPointer<C>( *opA, relax,
-                                                                     comm, amg, parameters_, weights_ );
+                                                                     comm, amg, parameters_, weights_,
+                                                                     iluOrderingCache_ );
         }
 
 
         /// \brief Solve the system using the given preconditioner and scalar product.
-        template <class Operator, class ScalarProd, class Precond>
-        void solve(Operator& opA, Vector& x, Vector& istlb, ScalarProd& sp, Precond& precond, Dune::InverseOperatorResult& result) const
+        template <class Operator, class ScalarProd, class Precond, class POrComm>
+        void solve(Operator& opA, Vector& x, Vector& istlb, ScalarProd& sp, Precond& precond,
+                   const POrComm& comm, Dune::InverseOperatorResult& result) const
         {
             // TODO: Revise when linear solvers interface opm-core is done
             // Construct linear solver.
@@ -519,23 +615,65 @@ protected:
             if (simulator_.gridView().comm().rank() == 0)
                 verbosity = parameters_.linear_solver_verbosity_;
 
+            double reduction = reduction_;
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
+            // Deflate the solutions of previous solves, if requested.
+            std::unique_ptr<DeflatedPreconditioner<Vector, ScalarProd>> deflated;
+            if (parameters_.linear_solver_recycle_size_ > 0) {
+                recycledSpace_.update(opA, sp);
+                if (!recycledSpace_.empty()) {
+                    Vector residual(istlb);
+                    opA.applyscaleadd(-1.0, x, residual);
+                    const double defect = sp.norm(residual);
+                    recycledSpace_.project(x, residual, sp);
+                    // The requested reduction is relative to the defect
+                    // before the projection.
+                    const double projectedDefect = sp.norm(residual);
+                    if (projectedDefect > 0.0) {
+                        reduction = std::min(1.0, reduction_ * defect / projectedDefect);
+                    }
+                    deflated.reset(new DeflatedPreconditioner<Vector, ScalarProd>(precond, recycledSpace_, sp));
+                }
+            }
+            Dune::Preconditioner<Vector, Vector>& prec = deflated
+                ? static_cast<Dune::Preconditioner<Vector, Vector>&>(*deflated)
+                : static_cast<Dune::Preconditioner<Vector, Vector>&>(precond);
+#else
+            Precond& prec = precond;
+#endif
+
             if ( parameters_.newton_use_gmres_ ) {
-                Dune::RestartedGMResSolver<Vector> linsolve(opA, sp, precond,
-                          parameters_.linear_solver_reduction_,
+                Dune::RestartedGMResSolver<Vector> linsolve(opA, sp, prec,
+                          reduction,
                           parameters_.linear_solver_restart_,
                           parameters_.linear_solver_maxiter_,
                           verbosity);
                 // Solve system.
                 linsolve.apply(x, istlb, result);
             }
+            else if ( parameters_.use_fused_bicgstab_ ) {
+                // BiCGstab with fewer global reductions
+                FusedBiCGSTABSolver<Vector, POrComm> linsolve(opA, prec, comm,
+                          reduction,
+                          parameters_.linear_solver_maxiter_,
+                          verbosity);
+                // Solve system.
+                linsolve.apply(x, istlb, result);
+            }
             else { // BiCGstab solver
-                Dune::BiCGSTABSolver<Vector> linsolve(opA, sp, precond,
-                          parameters_.linear_solver_reduction_,
+                Dune::BiCGSTABSolver<Vector> linsolve(opA, sp, prec,
+                          reduction,
                           parameters_.linear_solver_maxiter_,
                           verbosity);
                 // Solve system.
                 linsolve.apply(x, istlb, result);
             }
+
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
+            if (parameters_.linear_solver_recycle_size_ > 0 && result.converged) {
+                recycledSpace_.add(x);
+            }
+#endif
         }
 
 
@@ -671,6 +809,8 @@ protected:
             }
         }
 
+        enum class WeightsSource { Given, QuasiImpes, Constant };
+
         // Weights to make approximate pressure equations.
         // Calculated from the storage terms (only) of the
         // conservation equations, ignoring all other terms.
@@ -679,78 +819,223 @@ protected:
             Vector weights(rhs_->size());
             BlockVector rhs(0.0);
             rhs[pressureVarIndex] = 1.0;
-            int index = 0;
-            ElementContext elemCtx(simulator_);
             const auto& vanguard = simulator_.vanguard();
-            auto elemIt = vanguard.gridView().template begin</*codim=*/0>();
-            const auto& elemEndIt = vanguard.gridView().template end</*codim=*/0>();
-            for (; elemIt != elemEndIt; ++elemIt) {
-                const Element& elem = *elemIt;
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                Dune::FieldVector<Evaluation, numEq> storage;
-                unsigned threadId = ThreadManager::threadId();
-                simulator_.model().localLinearizer(threadId).localResidual().computeStorage(storage,elemCtx,/*spaceIdx=*/0, /*timeIdx=*/0);
-                Scalar extrusionFactor = elemCtx.intensiveQuantities(0, /*timeIdx=*/0).extrusionFactor();
-                Scalar scvVolume = elemCtx.stencil(/*timeIdx=*/0).subControlVolume(0).volume() * extrusionFactor;
-                Scalar storage_scale = scvVolume / elemCtx.simulator().timeStepSize();
-                MatrixBlockType block;
-                double pressure_scale = 50e5;
-                for (int ii = 0; ii < numEq; ++ii) {
-                    for (int jj = 0; jj < numEq; ++jj) {
-                        block[ii][jj] = storage[ii].derivative(jj)/storage_scale;
-                        if (jj == pressureVarIndex) {
-                            block[ii][jj] *= pressure_scale;
+            Ewoms::ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(vanguard.gridView());
+            std::exception_ptr exceptionPtr;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+            {
+                // The intensive quantities are taken from the model's cache if
+                // it is enabled, so this only evaluates the storage terms.
+                ElementContext elemCtx(simulator_);
+                const unsigned threadId = ThreadManager::threadId();
+                const auto& localResidual = simulator_.model().localLinearizer(threadId).localResidual();
+                auto elemIt = threadedElemIt.beginParallel();
+                for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
+                    try {
+                        const Element& elem = *elemIt;
+                        elemCtx.updatePrimaryStencil(elem);
+                        elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                        Dune::FieldVector<Evaluation, numEq> storage;
+                        localResidual.computeStorage(storage,elemCtx,/*spaceIdx=*/0, /*timeIdx=*/0);
+                        Scalar extrusionFactor = elemCtx.intensiveQuantities(0, /*timeIdx=*/0).extrusionFactor();
+                        Scalar scvVolume = elemCtx.stencil(/*timeIdx=*/0).subControlVolume(0).volume() * extrusionFactor;
+                        Scalar storage_scale = scvVolume / elemCtx.simulator().timeStepSize();
+                        MatrixBlockType block;
+                        double pressure_scale = 50e5;
+                        for (int ii = 0; ii < numEq; ++ii) {
+                            for (int jj = 0; jj < numEq; ++jj) {
+                                block[ii][jj] = storage[ii].derivative(jj)/storage_scale;
+                                if (jj == pressureVarIndex) {
+                                    block[ii][jj] *= pressure_scale;
+                                }
+                            }
                         }
+                        BlockVector bweights;
+                        MatrixBlockType block_transpose = Opm::transposeDenseMatrix(block);
+                        block_transpose.solve(bweights, rhs);
+                        bweights /= 1000.0; // given normal densities this scales weights to about 1.
+                        weights[elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0)] = bweights;
+                    }
+                    catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                        exceptionPtr = std::current_exception();
                     }
                 }
-                BlockVector bweights;
-                MatrixBlockType block_transpose = Opm::transposeDenseMatrix(block);
-                block_transpose.solve(bweights, rhs);
-                bweights /= 1000.0; // given normal densities this scales weights to about 1.
-                weights[index] = bweights;
-                ++index;
+            }
+            if (exceptionPtr) {
+                std::rethrow_exception(exceptionPtr);
             }
             return weights;
         }
 
-        // Interaction between the CPR weights (the function argument 'weights')
-        // and the variable and equation weights from
-        // simulator_.model().primaryVarWeight() and
-        // simulator_.model().eqWeight() is nontrivial and does not work
-        // at the moment. Possibly refactoring of ewoms weight treatment
-        // is needed. In the meantime this function shows what needs to be
-        // done to integrate the weights properly.
-        void scaleEquationsAndVariables(Vector& weights)
+        /// Quasi-IMPES weights of all rows of A, zero for the rows whose
+        /// diagonal block is missing or singular.
+        static Vector quasiImpesWeights(const Matrix& A)
         {
-            // loop over primary variables
-            const auto endi = matrix_->end();
-            for (auto i = matrix_->begin(); i != endi; ++i) {
-                const auto endj = (*i).end();
-                BlockVector& brhs = (*rhs_)[i.index()];
-                for (auto j = (*i).begin(); j != endj; ++j) {
-                    MatrixBlockType& block = *j;
-                    for (std::size_t ii = 0; ii < block.rows; ii++ ) {
-                        for (std::size_t jj = 0; jj < block.cols; jj++) {
-                            double var_scale = simulator_.model().primaryVarWeight(i.index(),jj);
-                            block[ii][jj] /= var_scale;
-                            block[ii][jj] *= simulator_.model().eqWeight(i.index(), ii);
-                        }
+            Vector weights(A.N());
+            weights = 0.0;
+            for (auto row = A.begin(); row != A.end(); ++row) {
+                const auto diag = row->find(row.index());
+                if (diag == row->end()) {
+                    continue;
+                }
+                try {
+                    weights[row.index()] = getQuasiImpesWeights(*diag);
+                } catch (...) {
+                    weights[row.index()] = 0.0;
+                }
+            }
+            return weights;
+        }
+
+        static BlockVector getQuasiImpesWeights(const MatrixBlockType& diag_block)
+        {
+            BlockVector rhs(0.0);
+            rhs[pressureVarIndex] = 1;
+            BlockVector bweights(0.0);
+            auto diag_block_transpose = Opm::transposeDenseMatrix(diag_block);
+            diag_block_transpose.solve(bweights, rhs);
+            double abs_max =
+                *std::max_element(bweights.begin(), bweights.end(), [](double a, double b){ return std::abs(a) < std::abs(b); } );
+            bweights /= std::abs(abs_max);
+            return bweights;
+        }
+
+        /// Position of the diagonal block in each row of the matrix. As it
+        /// only depends on the sparsity pattern, the offsets are cached
+        /// until forgetMatrixTopology() is called for a new matrix.
+        const std::vector<int>& diagonalOffsets()
+        {
+            const Matrix& A = *matrix_;
+            const int numRows = A.N();
+            if (diagonalOffsets_.size() == A.N() && diagonalNonzeroes_ == A.nonzeroes()) {
+                return diagonalOffsets_;
+            }
+            diagonalOffsets_.assign(numRows, -1);
+            diagonalNonzeroes_ = A.nonzeroes();
+            int missing = -1;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(max:missing)
+#endif
+            for (int rowIdx = 0; rowIdx < numRows; ++rowIdx) {
+                const auto& row = A[rowIdx];
+                int offset = 0;
+                for (auto col = row.begin(); col != row.end(); ++col, ++offset) {
+                    if (static_cast<int>(col.index()) == rowIdx) {
+                        diagonalOffsets_[rowIdx] = offset;
+                        break;
                     }
                 }
-                for (std::size_t ii = 0; ii < brhs.size(); ii++) {
-                    brhs[ii] *= simulator_.model().eqWeight(i.index(), ii);
+                if (diagonalOffsets_[rowIdx] < 0) {
+                    missing = std::max(missing, rowIdx);
                 }
-                if (weights.size() == matrix_->N()) {
-                    BlockVector& bw = weights[i.index()];
+            }
+            if (missing >= 0) {
+                diagonalOffsets_.clear();
+                OPM_THROW(std::logic_error, "Matrix is missing diagonal for row " << missing);
+            }
+            return diagonalOffsets_;
+        }
+
+        /// Single pass over the rows of the system which
+        ///  - computes the CPR weights unless they are given,
+        ///  - scales equations and variables (and the weights) if scaleEquations is true,
+        ///  - replaces the pressure equation by the weighted sum of the
+        ///    equations if formPressureEquation is true.
+        ///
+        /// Interaction between the CPR weights and the variable and equation
+        /// weights from simulator_.model().primaryVarWeight() and
+        /// simulator_.model().eqWeight() is nontrivial and does not work
+        /// at the moment. Possibly refactoring of ewoms weight treatment
+        /// is needed. In the meantime this function shows what needs to be
+        /// done to integrate the weights properly.
+        void scaleRows(const WeightsSource source, const BlockVector& constantWeights,
+                       const bool scaleEquations, const bool formPressureEquation)
+        {
+            Matrix& A = *matrix_;
+            const std::vector<int>* diagonal = nullptr;
+            if (source == WeightsSource::QuasiImpes) {
+                diagonal = &diagonalOffsets();
+            }
+            const auto& model = simulator_.model();
+            const bool haveWeights = weights_.size() == A.N();
+            const int numRows = A.N();
+            std::exception_ptr exceptionPtr;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+            for (int rowIdx = 0; rowIdx < numRows; ++rowIdx) {
+                auto& row = A[rowIdx];
+                BlockVector& brhs = (*rhs_)[rowIdx];
+                try {
+                    if (source == WeightsSource::QuasiImpes) {
+                        weights_[rowIdx] = getQuasiImpesWeights(row.getptr()[(*diagonal)[rowIdx]]);
+                    } else if (source == WeightsSource::Constant) {
+                        weights_[rowIdx] = constantWeights;
+                    }
+                }
+                catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                    exceptionPtr = std::current_exception();
+                    weights_[rowIdx] = 0.0;
+                }
+
+                if (scaleEquations) {
+                    for (auto j = row.begin(); j != row.end(); ++j) {
+                        MatrixBlockType& block = *j;
+                        for (std::size_t ii = 0; ii < block.rows; ii++ ) {
+                            for (std::size_t jj = 0; jj < block.cols; jj++) {
+                                double var_scale = model.primaryVarWeight(rowIdx,jj);
+                                block[ii][jj] /= var_scale;
+                                block[ii][jj] *= model.eqWeight(rowIdx, ii);
+                            }
+                        }
+                    }
                     for (std::size_t ii = 0; ii < brhs.size(); ii++) {
-                        bw[ii] /= simulator_.model().eqWeight(i.index(), ii);
+                        brhs[ii] *= model.eqWeight(rowIdx, ii);
                     }
-                    double abs_max =
-                        *std::max_element(bw.begin(), bw.end(), [](double a, double b){ return std::abs(a) < std::abs(b); } );
-                    bw /= abs_max;
+                    if (haveWeights) {
+                        BlockVector& bw = weights_[rowIdx];
+                        for (std::size_t ii = 0; ii < brhs.size(); ii++) {
+                            bw[ii] /= model.eqWeight(rowIdx, ii);
+                        }
+                        double abs_max =
+                            *std::max_element(bw.begin(), bw.end(), [](double a, double b){ return std::abs(a) < std::abs(b); } );
+                        if (abs_max != 0.0) {
+                            bw /= abs_max;
+                        }
+                    }
+                }
+
+                if (formPressureEquation) {
+                    const BlockVector& bweights = weights_[rowIdx];
+                    for (auto j = row.begin(); j != row.end(); ++j) {
+                        // assume it is something on all rows
+                        MatrixBlockType& block = *j;
+                        BlockVector neweq(0.0);
+                        for (std::size_t ii = 0; ii < block.rows; ii++) {
+                            for (std::size_t jj = 0; jj < block.cols; jj++) {
+                                neweq[jj] += bweights[ii]*block[ii][jj];
+                            }
+                        }
+                        block[pressureEqnIndex] = neweq;
+                    }
+                    Scalar newrhs(0.0);
+                    for (std::size_t ii = 0; ii < brhs.size(); ii++) {
+                        newrhs += bweights[ii]*brhs[ii];
+                    }
+                    brhs[pressureEqnIndex] = newrhs;
                 }
             }
+            if (exceptionPtr) {
+                std::rethrow_exception(exceptionPtr);
+            }
         }
 
         void scaleSolution(Vector& x)
@@ -764,67 +1049,45 @@ protected:
             }
         }
 
-        Vector getQuasiImpesWeights()
+        /// Copy of the matrix with the explicit well contributions added. Its
+        /// sparsity pattern is extended by the couplings between the perforated
+        /// cells of each well. Only wells that implement addWellContributions()
+        /// (i.e. standard wells) are included.
+        Matrix matrixWithWellContributions() const
         {
-            Matrix& A = *matrix_;
-            Vector weights(rhs_->size());
-            BlockVector rhs(0.0);
-            rhs[pressureVarIndex] = 1;
-            const auto endi = A.end();
-            for (auto i = A.begin(); i!=endi; ++i) {
-                const auto endj = (*i).end();
-                MatrixBlockType diag_block(0.0);
-                for (auto j=(*i).begin(); j!=endj; ++j) {
-                    if (i.index() == j.index()) {
-                        diag_block = (*j);
-                        break;
-                    }
+            const Matrix& A = *matrix_;
+            const auto& wellModel = simulator_.problem().wellModel();
+
+            std::vector<std::set<int>> pattern(A.N());
+            for (auto row = A.begin(); row != A.end(); ++row) {
+                for (auto col = row->begin(); col != row->end(); ++col) {
+                    pattern[row.index()].insert(col.index());
                 }
-                BlockVector bweights;
-                auto diag_block_transpose = Opm::transposeDenseMatrix(diag_block);
-                diag_block_transpose.solve(bweights, rhs);
-                double abs_max =
-                    *std::max_element(bweights.begin(), bweights.end(), [](double a, double b){ return std::abs(a) < std::abs(b); } );
-                bweights /= std::abs(abs_max);
-                weights[i.index()] = bweights;
             }
-            return weights;
-        }
-
-        Vector getSimpleWeights(const BlockVector& rhs)
-        {
-            Vector weights(rhs_->size(), 0);
-            for (auto& bw : weights) {
-                bw = rhs;
+            for (const auto& cells : wellModel.wellCells()) {
+                for (const int cell : cells) {
+                    pattern[cell].insert(cells.begin(), cells.end());
+                }
+            }
+            std::size_t nnz = 0;
+            for (const auto& columns : pattern) {
+                nnz += columns.size();
             }
-            return weights;
-        }
 
-        void scaleMatrixAndRhs(const Vector& weights)
-        {
-            using Block = typename Matrix::block_type;
-            const auto endi = matrix_->end();
-            for (auto i = matrix_->begin(); i !=endi; ++i) {
-                const BlockVector& bweights = weights[i.index()];
-                BlockVector& brhs = (*rhs_)[i.index()];
-                const auto endj = (*i).end();
-                for (auto j = (*i).begin(); j != endj; ++j) {
-                    // assume it is something on all rows
-                    Block& block = (*j);
-                    BlockVector neweq(0.0);
-                    for (std::size_t ii = 0; ii < block.rows; ii++) {
-                        for (std::size_t jj = 0; jj < block.cols; jj++) {
-                            neweq[jj] += bweights[ii]*block[ii][jj];
-                        }
-                    }
-                    block[pressureEqnIndex] = neweq;
+            Matrix full(A.N(), A.M(), nnz, Matrix::row_wise);
+            for (auto row = full.createbegin(); row != full.createend(); ++row) {
+                for (const int col : pattern[row.index()]) {
+                    row.insert(col);
                 }
-                Scalar newrhs(0.0);
-                for (std::size_t ii = 0; ii < brhs.size(); ii++) {
-                    newrhs += bweights[ii]*brhs[ii];
+            }
+            full = 0.0;
+            for (auto row = A.begin(); row != A.end(); ++row) {
+                for (auto col = row->begin(); col != row->end(); ++col) {
+                    full[row.index()][col.index()] = *col;
                 }
-                brhs[pressureEqnIndex] = newrhs;
             }
+            wellModel.addWellContributions(full);
+            return full;
         }
 
         static void multBlocksInMatrix(Matrix& ebosJac, const MatrixBlockType& trans, const bool left = true)
@@ -862,6 +1125,9 @@ protected:
         const Simulator& simulator_;
         mutable int iterations_;
         mutable bool converged_;
+        double reduction_;
+        mutable RecycledKrylovSpace<Vector> recycledSpace_;
+        LinearSystemDumper dumper_;
         boost::any parallelInformation_;
 
         std::unique_ptr<Matrix> matrix_;
@@ -871,7 +1137,16 @@ protected:
         std::vector<std::pair<int,std::vector<int>>> overlapRowAndColumns_;
         FlowLinearSolverParameters parameters_;
         Vector weights_;
+        std::vector<int> diagonalOffsets_;
+        std::size_t diagonalNonzeroes_ = 0;
         bool scale_variables_;
+        mutable Dune::Amg::TwoLevelMethodTimings cpr_timings_;
+        // orderings of the ILU0 preconditioners built by this solver
+        std::shared_ptr<detail::OrderingCache> iluOrderingCache_ = std::make_shared<detail::OrderingCache>();
+        // the matrix last passed to prepare(), see checkMatrixTopology()
+        const Matrix* sourceMatrix_ = nullptr;
+        std::size_t sourceSize_ = 0;
+        std::size_t sourceNonzeroes_ = 0;
     }; // end ISTLSolver
 
 } // namespace Opm
@@ -107,6 +107,7 @@ namespace Opm
             if (oldMat != nullptr)
                 std::cout << "old was "<<oldMat<<" new is "<<&M.istlMatrix()<<std::endl;
             oldMat = &M.istlMatrix();
+            this->checkMatrixTopology(M.istlMatrix());
             int newton_iteration = this->simulator_.model().newtonMethod().numIterations();
             if (newton_iteration < 1 or not(this->parameters_.cpr_reuse_setup_)) {
                 SuperClass::matrix_.reset(new Matrix(M.istlMatrix()));
@@ -114,7 +115,7 @@ namespace Opm
                 *SuperClass::matrix_ = M.istlMatrix();
             }
             SuperClass::rhs_ = &b;
-            SuperClass::scaleSystem();
+            SuperClass::scaleAndDumpSystem();
             const WellModel& wellModel = this->simulator_.problem().wellModel();
 
 #if HAVE_MPI
@@ -224,6 +225,7 @@ namespace Opm
             criterion.setDefaultValuesIsotropic(2);
             criterion.setNoPostSmoothSteps( 1 );
             criterion.setNoPreSmoothSteps( 1 );
+            criterion.setAccumulate( ISTLUtility::cprAccumulationMode(this->parameters_.cpr_accumulate_) );
             //new guesses by hmbn
             //criterion.setAlpha(0.01); // criterion for connection strong 1/3 is default
             //criterion.setMaxLevel(2); //
@@ -244,6 +246,7 @@ namespace Opm
             smootherArgs.relaxationFactor = relax;
             const Opm::CPRParameter& params(this->parameters_); // strange conversion
             ISTLUtility::setILUParameters(smootherArgs, ilu_milu);
+            ISTLUtility::setILUOrdering(smootherArgs, params, this->iluOrderingCache_);
 
             auto& opARef = reinterpret_cast<OperatorType&>(*opA_);
             int newton_iteration = this->simulator_.model().newtonMethod().numIterations();
@@ -291,7 +294,7 @@ namespace Opm
             // Solve system.
             Dune::InverseOperatorResult result;
             Vector& istlb = *(this->rhs_);
-            linsolve_->apply(x, istlb, result);
+            linsolve_->apply(x, istlb, this->reduction(), result);
             SuperClass::checkConvergence(result);
             if (this->parameters_.scale_linear_system_) {
                 this->scaleSolution(x);
@@ -299,6 +302,13 @@ namespace Opm
 	    return this->converged_;
         }
 
+        /// \brief Time spent in the CPR setup and apply since the last call.
+        Dune::Amg::TwoLevelMethodTimings takeCprTimings()
+        {
+            auto* timed = dynamic_cast<Dune::Amg::TwoLevelMethodTimingsProvider*>(amg_.get());
+            return timed ? timed->takeTimings() : Dune::Amg::TwoLevelMethodTimings();
+        }
+
 
     protected:
 
@@ -23,8 +23,13 @@
 #include <ewoms/linear/matrixblock.hh>
 #include <opm/simulators/linalg/findOverlapRowsAndColumns.hpp>
 #include <opm/simulators/linalg/FlexibleSolver.hpp>
+#include <opm/simulators/linalg/LinearSystemIO.hpp>
+#include <opm/simulators/linalg/PreconditionerSetupData.hpp>
+#include <opm/simulators/linalg/getQuasiImpesWeights.hpp>
+#include <opm/simulators/linalg/iluClusterKeys.hpp>
 #include <opm/simulators/linalg/setupPropertyTree.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -35,6 +40,7 @@ NEW_TYPE_TAG(FlowIstlSolverFlexible, INHERITS_FROM(FlowIstlSolverParams));
 NEW_PROP_TAG(GlobalEqVector);
 NEW_PROP_TAG(SparseMatrixAdapter);
 NEW_PROP_TAG(Simulator);
+NEW_PROP_TAG(Indices);
 
 END_PROPERTIES
 
@@ -63,6 +69,7 @@ class ISTLSolverEbosFlexible
     using Communication = Dune::OwnerOverlapCopyCommunication<int, int>;
 #endif
     using SolverType = Dune::FlexibleSolver<MatrixType, VectorType>;
+    using Indices = typename GET_PROP_TYPE(TypeTag, Indices);
 
 
 public:
@@ -73,9 +80,15 @@ public:
 
     explicit ISTLSolverEbosFlexible(const Simulator& simulator)
         : simulator_(simulator)
+        , setupData_(std::make_shared<PreconditionerSetupData>())
     {
         parameters_.template init<TypeTag>();
         prm_ = setupPropertyTree(parameters_);
+        // The configuration file may override LinearSolverReduction.
+        reduction_ = prm_.get<double>("tol");
+        dumper_ = LinearSystemDumper(parameters_.linear_solver_dump_prefix_,
+                                     parameters_.linear_solver_dump_interval_,
+                                     simulator_.gridView().comm().rank());
         extractParallelGridInformationToISTL(simulator_.vanguard().grid(), parallelInformation_);
         detail::findOverlapRowsAndColumns(simulator_.vanguard().grid(), overlapRowAndColumns_);
 #if HAVE_MPI
@@ -90,6 +103,7 @@ public:
 
     void eraseMatrix()
     {
+        setupData_->clear();
     }
 
     void prepare(SparseMatrixAdapter& mat, VectorType& b)
@@ -106,6 +120,28 @@ public:
         }
         makeOverlapRowsInvalid(mat.istlMatrix());
 #endif
+        if (dumper_.due()) {
+            // The weights a CPR preconditioner computes for this system.
+            const int pressureVarIndex = prm_.get<int>("preconditioner.pressure_var_index", Indices::pressureSwitchIdx);
+            const bool transpose = prm_.get<std::string>("preconditioner.type") == "cprt";
+            const auto weights = Opm::Amg::getQuasiImpesWeights<MatrixType, VectorType>(
+                mat.istlMatrix(), pressureVarIndex, transpose);
+            dumper_.write(mat.istlMatrix(), b, weights);
+        }
+        // What the preconditioners keep between setups is only valid for
+        // the sparsity pattern it was computed for.
+        const auto& matrix = mat.istlMatrix();
+        const bool new_matrix = &matrix != matrix_
+            || matrix.N() != matrix_size_ || matrix.nonzeroes() != matrix_nonzeroes_;
+        if (new_matrix) {
+            setupData_->clear();
+            // The configuration decides whether an ILU0 uses the reverse
+            // Cuthill-McKee ordering, which keeps the cells of a region together.
+            setupData_->iluOrderings->setClusterKeys(detail::iluClusterKeys(simulator_.problem(), matrix.N()));
+            matrix_ = &matrix;
+            matrix_size_ = matrix.N();
+            matrix_nonzeroes_ = matrix.nonzeroes();
+        }
         // Decide if we should recreate the solver or just do
         // a minimal preconditioner update.
         const int newton_iteration = this->simulator_.model().newtonMethod().numIterations();
@@ -129,13 +165,13 @@ public:
             // Never recreate solver.
         }
 
-        if (recreate_solver || !solver_) {
+        if (recreate_solver || new_matrix || !solver_) {
             if (isParallel()) {
 #if HAVE_MPI
-                solver_.reset(new SolverType(prm_, mat.istlMatrix(), *comm_));
+                solver_.reset(new SolverType(prm_, mat.istlMatrix(), *comm_, setupData_));
 #endif
             } else {
-                solver_.reset(new SolverType(prm_, mat.istlMatrix()));
+                solver_.reset(new SolverType(prm_, mat.istlMatrix(), setupData_));
             }
             rhs_ = b;
         } else {
@@ -146,7 +182,11 @@ public:
 
     bool solve(VectorType& x)
     {
-        solver_->apply(x, rhs_, res_);
+        if (adaptive_reduction_) {
+            solver_->apply(x, rhs_, reduction_, res_);
+        } else {
+            solver_->apply(x, rhs_, res_);
+        }
         return res_.converged;
     }
 
@@ -164,6 +204,27 @@ public:
         return res_.iterations;
     }
 
+    /// Set the relative residual reduction for the following solves.
+    /// It is never made stricter than the tolerance of the solver configuration.
+    /// Until this is called, the solves use that tolerance.
+    void setReduction(double reduction)
+    {
+        reduction_ = std::max(reduction, prm_.get<double>("tol"));
+        adaptive_reduction_ = true;
+    }
+
+    double reduction() const
+    {
+        return reduction_;
+    }
+
+    /// Time spent in the CPR setup and apply since the last call.
+    Dune::Amg::TwoLevelMethodTimings takeCprTimings()
+    {
+        auto* timed = solver_ ? dynamic_cast<Dune::Amg::TwoLevelMethodTimingsProvider*>(&solver_->preconditioner()) : nullptr;
+        return timed ? timed->takeTimings() : Dune::Amg::TwoLevelMethodTimings();
+    }
+
     void setResidual(VectorType& /* b */)
     {
         // rhs_ = &b; // Must be handled in prepare() instead.
@@ -204,7 +265,14 @@ protected:
     const Simulator& simulator_;
 
     std::unique_ptr<SolverType> solver_;
+    std::shared_ptr<PreconditionerSetupData> setupData_;
+    const MatrixType* matrix_ = nullptr;
+    std::size_t matrix_size_ = 0;
+    std::size_t matrix_nonzeroes_ = 0;
     FlowLinearSolverParameters parameters_;
+    double reduction_;
+    bool adaptive_reduction_ = false;
+    LinearSystemDumper dumper_;
     boost::property_tree::ptree prm_;
     VectorType rhs_;
     Dune::InverseOperatorResult res_;
@@ -0,0 +1,295 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_LINEARSYSTEMIO_HEADER_INCLUDED
+#define OPM_LINEARSYSTEMIO_HEADER_INCLUDED
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+/// \file
+///
+/// Binary storage of block linear systems, used to capture the systems of
+/// a simulation and replay them with flow_linsolve_bench.
+///
+/// Layout (native byte order, all integers unsigned):
+///   char[8]   magic "OPMLSYS"
+///   uint32    format version (1)
+///   uint32    block size b
+///   uint64    number of block rows n
+///   uint64    number of nonzero blocks nnz
+///   uint64    number of weight blocks (0 or n)
+///   uint64    row start offsets, n + 1 entries
+///   uint32    column indices, nnz entries
+///   double    matrix values, nnz * b * b entries, row major per block
+///   double    right hand side, n * b entries
+///   double    CPR weights, (0 or n) * b entries
+
+namespace LinearSystemIODetail
+{
+    constexpr char magic[8] = "OPMLSYS";
+    constexpr std::uint32_t version = 1;
+
+    struct Header
+    {
+        std::uint32_t blockSize;
+        std::uint64_t rows;
+        std::uint64_t nonZeros;
+        std::uint64_t weightRows;
+    };
+
+    template <class T>
+    void write(std::ostream& os, const T* data, std::size_t count)
+    {
+        os.write(reinterpret_cast<const char*>(data), sizeof(T) * count);
+    }
+
+    template <class T>
+    void read(std::istream& is, T* data, std::size_t count)
+    {
+        is.read(reinterpret_cast<char*>(data), sizeof(T) * count);
+        if (!is) {
+            throw std::runtime_error("Unexpected end of linear system file");
+        }
+    }
+
+    inline Header readHeader(std::istream& is)
+    {
+        char fileMagic[8];
+        read(is, fileMagic, 8);
+        if (std::memcmp(fileMagic, magic, 8) != 0) {
+            throw std::runtime_error("Not a linear system file");
+        }
+        std::uint32_t fileVersion;
+        read(is, &fileVersion, 1);
+        if (fileVersion != version) {
+            throw std::runtime_error("Unsupported linear system file version " + std::to_string(fileVersion));
+        }
+        Header header;
+        read(is, &header.blockSize, 1);
+        read(is, &header.rows, 1);
+        read(is, &header.nonZeros, 1);
+        read(is, &header.weightRows, 1);
+        return header;
+    }
+
+    template <class Vector>
+    void writeVector(std::ostream& os, const Vector& v)
+    {
+        for (const auto& block : v) {
+            for (const auto& value : block) {
+                const double d = value;
+                write(os, &d, 1);
+            }
+        }
+    }
+
+    template <class Vector>
+    void readVector(std::istream& is, Vector& v, std::size_t rows)
+    {
+        v.resize(rows);
+        for (auto& block : v) {
+            for (auto& value : block) {
+                double d;
+                read(is, &d, 1);
+                value = d;
+            }
+        }
+    }
+} // namespace LinearSystemIODetail
+
+
+/// Write the system A x = rhs and, if non-empty, the CPR weights to a file.
+template <class Matrix, class Vector>
+void writeLinearSystem(const std::string& filename, const Matrix& A, const Vector& rhs, const Vector& weights)
+{
+    using namespace LinearSystemIODetail;
+    constexpr int b = Matrix::block_type::rows;
+    static_assert(b == static_cast<int>(Matrix::block_type::cols), "Only square blocks are supported");
+
+    std::ofstream os(filename, std::ios::binary);
+    if (!os) {
+        throw std::runtime_error("Could not open " + filename + " for writing");
+    }
+
+    const std::uint32_t blockSize = b;
+    const std::uint64_t rows = A.N();
+    const std::uint64_t nonZeros = A.nonzeroes();
+    const std::uint64_t weightRows = weights.size();
+    if (rhs.size() != A.N() || (weightRows != 0 && weightRows != rows)) {
+        throw std::logic_error("Inconsistent linear system sizes");
+    }
+    write(os, magic, 8);
+    write(os, &version, 1);
+    write(os, &blockSize, 1);
+    write(os, &rows, 1);
+    write(os, &nonZeros, 1);
+    write(os, &weightRows, 1);
+
+    std::vector<std::uint64_t> rowStart;
+    std::vector<std::uint32_t> columns;
+    rowStart.reserve(rows + 1);
+    columns.reserve(nonZeros);
+    rowStart.push_back(0);
+    for (auto row = A.begin(); row != A.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            columns.push_back(col.index());
+        }
+        rowStart.push_back(columns.size());
+    }
+    write(os, rowStart.data(), rowStart.size());
+    write(os, columns.data(), columns.size());
+
+    std::vector<double> values(b * b);
+    for (auto row = A.begin(); row != A.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            for (int i = 0; i < b; ++i) {
+                for (int j = 0; j < b; ++j) {
+                    values[i * b + j] = (*col)[i][j];
+                }
+            }
+            write(os, values.data(), values.size());
+        }
+    }
+    writeVector(os, rhs);
+    writeVector(os, weights);
+
+    if (!os) {
+        throw std::runtime_error("Failed to write linear system to " + filename);
+    }
+}
+
+
+/// Return the block size of the system stored in a file.
+inline int readLinearSystemBlockSize(const std::string& filename)
+{
+    std::ifstream is(filename, std::ios::binary);
+    if (!is) {
+        throw std::runtime_error("Could not open " + filename);
+    }
+    return LinearSystemIODetail::readHeader(is).blockSize;
+}
+
+
+/// Read a system written by writeLinearSystem(). The block size of the
+/// matrix type must match the one in the file. If no weights are stored,
+/// weights is left empty.
+template <class Matrix, class Vector>
+void readLinearSystem(const std::string& filename, Matrix& A, Vector& rhs, Vector& weights)
+{
+    using namespace LinearSystemIODetail;
+    constexpr int b = Matrix::block_type::rows;
+
+    std::ifstream is(filename, std::ios::binary);
+    if (!is) {
+        throw std::runtime_error("Could not open " + filename);
+    }
+    const Header header = readHeader(is);
+    if (static_cast<int>(header.blockSize) != b) {
+        throw std::runtime_error("Block size mismatch: file has " + std::to_string(header.blockSize)
+                                 + ", expected " + std::to_string(b));
+    }
+
+    std::vector<std::uint64_t> rowStart(header.rows + 1);
+    std::vector<std::uint32_t> columns(header.nonZeros);
+    read(is, rowStart.data(), rowStart.size());
+    read(is, columns.data(), columns.size());
+
+    A.setBuildMode(Matrix::row_wise);
+    A.setSize(header.rows, header.rows, header.nonZeros);
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        const auto i = row.index();
+        for (auto k = rowStart[i]; k < rowStart[i + 1]; ++k) {
+            row.insert(columns[k]);
+        }
+    }
+
+    std::vector<double> values(b * b);
+    for (auto row = A.begin(); row != A.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            read(is, values.data(), values.size());
+            for (int i = 0; i < b; ++i) {
+                for (int j = 0; j < b; ++j) {
+                    (*col)[i][j] = values[i * b + j];
+                }
+            }
+        }
+    }
+    readVector(is, rhs, header.rows);
+    readVector(is, weights, header.weightRows);
+}
+
+
+/// Writes every n-th of the systems passed to it to the files
+/// <prefix>_<rank>_<count>.opmls, where count counts all systems.
+class LinearSystemDumper
+{
+public:
+    LinearSystemDumper()
+        : LinearSystemDumper("", 1, 0)
+    {
+    }
+
+    LinearSystemDumper(const std::string& prefix, int interval, int rank)
+        : prefix_(prefix)
+        , interval_(std::max(interval, 1))
+        , rank_(rank)
+        , count_(-1)
+    {
+    }
+
+    bool active() const
+    {
+        return !prefix_.empty();
+    }
+
+    /// Advance to the next system and return whether it should be written.
+    bool due()
+    {
+        ++count_;
+        return active() && count_ % interval_ == 0;
+    }
+
+    /// Write the current system.
+    template <class Matrix, class Vector>
+    void write(const Matrix& A, const Vector& rhs, const Vector& weights) const
+    {
+        const std::string filename = prefix_ + "_" + std::to_string(rank_) + "_"
+            + std::to_string(count_) + ".opmls";
+        writeLinearSystem(filename, A, rhs, weights);
+    }
+
+private:
+    std::string prefix_;
+    int interval_;
+    int rank_;
+    long count_;
+};
+
+} // namespace Opm
+
+#endif // OPM_LINEARSYSTEMIO_HEADER_INCLUDED
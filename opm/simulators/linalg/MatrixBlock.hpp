@@ -364,6 +364,47 @@ static inline void invertMatrix(Dune::DynamicMatrix<K>& matrix)
 
 } // end ISTLUtility
 
+namespace Detail {
+
+//! Matrix-vector kernels for small dense blocks.
+//!
+//! Plain loops with trip counts known at compile time let the compiler
+//! fully unroll and vectorize them, which the iterator based generic
+//! DenseMatrix code does not reliably achieve. The rows are accessed
+//! through operator[] only, a FieldMatrix is an array of FieldVector
+//! rows and not one contiguous array.
+template <class K, int n, int m>
+struct BlockKernels
+{
+    //! y = A x
+    static inline void mv(const FieldMatrix<K,n,m>& A, const FieldVector<K,m>& x, FieldVector<K,n>& y)
+    {
+        for (int i = 0; i < n; ++i) {
+            const auto& row = A[i];
+            K sum = 0.0;
+            for (int j = 0; j < m; ++j) {
+                sum += row[j] * x[j];
+            }
+            y[i] = sum;
+        }
+    }
+
+    //! y += alpha A x
+    static inline void usmv(const K alpha, const FieldMatrix<K,n,m>& A, const FieldVector<K,m>& x, FieldVector<K,n>& y)
+    {
+        for (int i = 0; i < n; ++i) {
+            const auto& row = A[i];
+            K sum = 0.0;
+            for (int j = 0; j < m; ++j) {
+                sum += row[j] * x[j];
+            }
+            y[i] += alpha * sum;
+        }
+    }
+};
+
+} // end Detail
+
 template <class Scalar, int n, int m>
 class MatrixBlock : public Dune::FieldMatrix<Scalar, n, m>
 {
@@ -373,11 +414,43 @@ public:
     using BaseType :: operator= ;
     using BaseType :: rows;
     using BaseType :: cols;
+    using BaseType :: mv;
+    using BaseType :: umv;
+    using BaseType :: mmv;
+    using BaseType :: usmv;
     explicit MatrixBlock( const Scalar scalar = 0 ) : BaseType( scalar ) {}
     void invert()
     {
         ISTLUtility::invertMatrix( *this );
     }
+
+    // Specializations of the matrix-vector products for the vector types
+    // used in the linear solvers, see Detail::BlockKernels.
+
+    //! y = A x
+    void mv(const FieldVector<Scalar, m>& x, FieldVector<Scalar, n>& y) const
+    {
+        Detail::BlockKernels<Scalar, n, m>::mv(*this, x, y);
+    }
+
+    //! y += A x
+    void umv(const FieldVector<Scalar, m>& x, FieldVector<Scalar, n>& y) const
+    {
+        Detail::BlockKernels<Scalar, n, m>::usmv(1.0, *this, x, y);
+    }
+
+    //! y -= A x
+    void mmv(const FieldVector<Scalar, m>& x, FieldVector<Scalar, n>& y) const
+    {
+        Detail::BlockKernels<Scalar, n, m>::usmv(-1.0, *this, x, y);
+    }
+
+    //! y += alpha A x
+    void usmv(const Scalar alpha, const FieldVector<Scalar, m>& x, FieldVector<Scalar, n>& y) const
+    {
+        Detail::BlockKernels<Scalar, n, m>::usmv(alpha, *this, x, y);
+    }
+
     const BaseType& asBase() const { return static_cast< const BaseType& > (*this); }
     BaseType& asBase() { return static_cast< BaseType& > (*this); }
 };
@@ -476,6 +549,25 @@ namespace Detail
         }
     }
 
+    //! calculates ret = A * B
+    template< class K, int m, int n, int p >
+    static inline void multMatrix(const Dune::FieldMatrix< K, m, n >& A,
+                                  const Dune::FieldMatrix< K, n, p >& B,
+                                  Dune::FieldMatrix< K, m, p >& ret )
+    {
+        typedef typename Dune::FieldMatrix< K, m, p > :: size_type size_type;
+
+        for( size_type i = 0; i < m; ++i )
+        {
+            for( size_type j = 0; j < p; ++j )
+            {
+                ret[ i ][ j ] = K( 0 );
+                for( size_type k = 0; k < n; ++k )
+                    ret[ i ][ j ] += A[ i ][ k ] * B[ k ][ j ];
+            }
+        }
+    }
+
     //! calculates ret = A * B
     template< class K>
     static inline void multMatrix(const Dune::DynamicMatrix<K>& A,
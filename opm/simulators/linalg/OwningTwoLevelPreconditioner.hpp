@@ -58,20 +58,23 @@ template <class OperatorType,
           class VectorType,
           bool transpose = false,
           class Communication = Dune::Amg::SequentialInformation>
-class OwningTwoLevelPreconditioner : public Dune::PreconditionerWithUpdate<VectorType, VectorType>
+class OwningTwoLevelPreconditioner : public Dune::PreconditionerWithUpdate<VectorType, VectorType>,
+                                     public Dune::Amg::TwoLevelMethodTimingsProvider
 {
 public:
     using pt = boost::property_tree::ptree;
     using MatrixType = typename OperatorType::matrix_type;
     using PrecFactory = PreconditionerFactory<OperatorType, Communication>;
+    using SetupDataPtr = std::shared_ptr<Opm::PreconditionerSetupData>;
 
-    OwningTwoLevelPreconditioner(const OperatorType& linearoperator, const pt& prm)
+    /// \param setupData Data kept by the solver between preconditioner setups, may be null.
+    OwningTwoLevelPreconditioner(const OperatorType& linearoperator, const pt& prm,
+                                 const SetupDataPtr& setupData = SetupDataPtr())
         : linear_operator_(linearoperator)
-        , finesmoother_(PrecFactory::create(linearoperator, prm.get_child("finesmoother")))
+        , finesmoother_(PrecFactory::create(linearoperator, prm.get_child("finesmoother"), setupData))
         , comm_(nullptr)
-        , weights_(Opm::Amg::getQuasiImpesWeights<MatrixType, VectorType>(
-              linearoperator.getmat(), prm.get<int>("pressure_var_index"), transpose))
-        , levelTransferPolicy_(dummy_comm_, weights_, prm.get<int>("pressure_var_index"))
+        , weights_(initialWeights(linearoperator.getmat(), prm, setupData))
+        , levelTransferPolicy_(dummy_comm_, weights_, prm.get<int>("pressure_var_index"), setupData)
         , coarseSolverPolicy_(prm.get_child("coarsesolver"))
         , twolevel_method_(linearoperator,
                            finesmoother_,
@@ -80,6 +83,7 @@ public:
                            transpose ? 1 : 0,
                            transpose ? 0 : 1)
         , prm_(prm)
+        , setupData_(setupData)
     {
         if (prm.get<int>("verbosity") > 10) {
             std::ofstream outfile(prm.get<std::string>("weights_filename"));
@@ -90,13 +94,13 @@ public:
         }
     }
 
-    OwningTwoLevelPreconditioner(const OperatorType& linearoperator, const pt& prm, const Communication& comm)
+    OwningTwoLevelPreconditioner(const OperatorType& linearoperator, const pt& prm, const Communication& comm,
+                                 const SetupDataPtr& setupData = SetupDataPtr())
         : linear_operator_(linearoperator)
-        , finesmoother_(PrecFactory::create(linearoperator, prm.get_child("finesmoother"), comm))
+        , finesmoother_(PrecFactory::create(linearoperator, prm.get_child("finesmoother"), comm, setupData))
         , comm_(&comm)
-        , weights_(Opm::Amg::getQuasiImpesWeights<MatrixType, VectorType>(
-              linearoperator.getmat(), prm.get<int>("pressure_var_index"), transpose))
-        , levelTransferPolicy_(*comm_, weights_, prm.get<int>("pressure_var_index"))
+        , weights_(initialWeights(linearoperator.getmat(), prm, setupData))
+        , levelTransferPolicy_(*comm_, weights_, prm.get<int>("pressure_var_index"), setupData)
         , coarseSolverPolicy_(prm.get_child("coarsesolver"))
         , twolevel_method_(linearoperator,
                            finesmoother_,
@@ -105,6 +109,7 @@ public:
                            transpose ? 1 : 0,
                            transpose ? 0 : 1)
         , prm_(prm)
+        , setupData_(setupData)
     {
         if (prm.get<int>("verbosity") > 10) {
             std::ofstream outfile(prm.get<std::string>("weights_filename"));
@@ -132,8 +137,10 @@ public:
 
     virtual void update() override
     {
-        Opm::Amg::getQuasiImpesWeights<MatrixType, VectorType>(
-            linear_operator_.getmat(), prm_.get<int>("pressure_var_index"), transpose, weights_);
+        if (!hasFixedWeights(setupData_)) {
+            Opm::Amg::getQuasiImpesWeights<MatrixType, VectorType>(
+                linear_operator_.getmat(), prm_.get<int>("pressure_var_index"), transpose, weights_);
+        }
         updateImpl(comm_);
     }
 
@@ -142,6 +149,11 @@ public:
         return linear_operator_.category();
     }
 
+    virtual Dune::Amg::TwoLevelMethodTimings takeTimings() override
+    {
+        return twolevel_method_.takeTimings();
+    }
+
 private:
     using PressureMatrixType = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>>;
     using PressureVectorType = Dune::BlockVector<Dune::FieldVector<double, 1>>;
@@ -158,19 +170,46 @@ private:
     using TwoLevelMethod
         = Dune::Amg::TwoLevelMethodCpr<OperatorType, CoarseSolverPolicy, Dune::Preconditioner<VectorType, VectorType>>;
 
+    static bool hasFixedWeights(const SetupDataPtr& setupData)
+    {
+        return setupData && !setupData->cprWeights.empty();
+    }
+
+    // The fixed weights of the setup data if there are any, else the
+    // quasi-IMPES weights of the matrix.
+    static VectorType initialWeights(const MatrixType& matrix, const pt& prm, const SetupDataPtr& setupData)
+    {
+        if (!hasFixedWeights(setupData)) {
+            return Opm::Amg::getQuasiImpesWeights<MatrixType, VectorType>(
+                matrix, prm.get<int>("pressure_var_index"), transpose);
+        }
+        const auto& fixed = setupData->cprWeights;
+        constexpr int bs = VectorType::block_type::dimension;
+        if (fixed.size() != matrix.N() * bs) {
+            throw std::runtime_error("CPR weights do not match the size of the matrix");
+        }
+        VectorType weights(matrix.N());
+        for (std::size_t row = 0; row < matrix.N(); ++row) {
+            for (int i = 0; i < bs; ++i) {
+                weights[row][i] = fixed[row * bs + i];
+            }
+        }
+        return weights;
+    }
+
     // Handling parallel vs serial instantiation of preconditioner factory.
     template <class Comm>
     void updateImpl(const Comm*)
     {
         // Parallel case.
-        finesmoother_ = PrecFactory::create(linear_operator_, prm_.get_child("finesmoother"), *comm_);
+        finesmoother_ = PrecFactory::create(linear_operator_, prm_.get_child("finesmoother"), *comm_, setupData_);
         twolevel_method_.updatePreconditioner(finesmoother_, coarseSolverPolicy_);
     }
 
     void updateImpl(const Dune::Amg::SequentialInformation*)
     {
         // Serial case.
-        finesmoother_ = PrecFactory::create(linear_operator_, prm_.get_child("finesmoother"));
+        finesmoother_ = PrecFactory::create(linear_operator_, prm_.get_child("finesmoother"), setupData_);
         twolevel_method_.updatePreconditioner(finesmoother_, coarseSolverPolicy_);
     }
 
@@ -182,6 +221,7 @@ private:
     CoarseSolverPolicy coarseSolverPolicy_;
     TwoLevelMethod twolevel_method_;
     boost::property_tree::ptree prm_;
+    SetupDataPtr setupData_;
     Communication dummy_comm_;
 };
 
@@ -23,16 +23,22 @@
 #include <opm/simulators/linalg/GraphColoring.hpp>
 #include <opm/common/Exceptions.hpp>
 #include <opm/common/ErrorMacros.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
 #include <dune/common/version.hh>
 #include <dune/istl/preconditioner.hh>
 #include <dune/istl/paamg/smoother.hh>
 #include <dune/istl/paamg/graph.hh>
 #include <dune/istl/paamg/pinfo.hh>
+#include <dune/istl/owneroverlapcopy.hh>
 
 #include <type_traits>
 #include <numeric>
 #include <limits>
 #include <cstddef>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <sstream>
 #include <string>
 
 namespace Opm
@@ -43,6 +49,11 @@ namespace Opm
 template<class Matrix, class Domain, class Range, class ParallelInfo = Dune::Amg::SequentialInformation>
 class ParallelOverlappingILU0;
 
+namespace detail
+{
+class OrderingCache;
+}
+
 enum class MILU_VARIANT{
     /// \brief Do not perform modified ILU
     ILU = 0,
@@ -79,7 +90,7 @@ class ParallelOverlappingILU0Args
 {
  public:
     ParallelOverlappingILU0Args(MILU_VARIANT milu = MILU_VARIANT::ILU )
-        : milu_(milu)
+        : milu_(milu), n_(0)
     {}
     void setMilu(MILU_VARIANT milu)
     {
@@ -97,10 +108,66 @@ class ParallelOverlappingILU0Args
     {
         return n_;
     }
+    /// \brief Set the reordering, see the constructor of ParallelOverlappingILU0.
+    void setOrdering(bool redBlack, bool reorderSphere, bool reorderRcm, bool speculativeColoring)
+    {
+        redBlack_ = redBlack;
+        reorderSphere_ = reorderSphere;
+        reorderRcm_ = reorderRcm;
+        speculativeColoring_ = speculativeColoring;
+    }
+    bool getRedBlack() const
+    {
+        return redBlack_;
+    }
+    bool getReorderSphere() const
+    {
+        return reorderSphere_;
+    }
+    bool getReorderRcm() const
+    {
+        return reorderRcm_;
+    }
+    bool getSpeculativeColoring() const
+    {
+        return speculativeColoring_;
+    }
+    void setOrderingCache(std::shared_ptr<detail::OrderingCache> cache)
+    {
+        orderingCache_ = std::move(cache);
+    }
+    const std::shared_ptr<detail::OrderingCache>& getOrderingCache() const
+    {
+        return orderingCache_;
+    }
  private:
     MILU_VARIANT milu_;
     int n_;
+    bool redBlack_ = false;
+    bool reorderSphere_ = true;
+    bool reorderRcm_ = false;
+    bool speculativeColoring_ = false;
+    std::shared_ptr<detail::OrderingCache> orderingCache_;
 };
+
+/// \brief The smoother arguments for the levels below the fine level.
+///
+/// The matrices of the coarser levels depend on the values of the fine
+/// matrix, so the orderings are only set up (and cached) on the fine level.
+template<class Args>
+const Args& coarseLevelSmootherArgs(const Args& args)
+{
+    return args;
+}
+
+template<class F>
+ParallelOverlappingILU0Args<F> coarseLevelSmootherArgs(const ParallelOverlappingILU0Args<F>& args)
+{
+    ParallelOverlappingILU0Args<F> coarseArgs(args);
+    coarseArgs.setOrdering(false, true, false, false);
+    coarseArgs.setOrderingCache(nullptr);
+    return coarseArgs;
+}
 } // end namespace Opm
 
 namespace Dune
@@ -141,7 +208,12 @@ struct ConstructionTraits<Opm::ParallelOverlappingILU0<Matrix,Domain,Range,Paral
                       args.getComm(),
                       args.getArgs().getN(),
                       args.getArgs().relaxationFactor,
-                      args.getArgs().getMilu()) );
+                      args.getArgs().getMilu(),
+                      args.getArgs().getRedBlack(),
+                      args.getArgs().getReorderSphere(),
+                      args.getArgs().getReorderRcm(),
+                      args.getArgs().getSpeculativeColoring(),
+                      args.getArgs().getOrderingCache()) );
     }
 
 #if ! DUNE_VERSION_NEWER(DUNE_ISTL, 2, 7)
@@ -190,6 +262,87 @@ namespace Opm
         const std::vector<std::size_t>* ordering_;
     };
 
+    /// \brief Orderings of the unknowns computed for sparsity patterns.
+    ///
+    /// Coloring and reordering only depend on the sparsity pattern, which
+    /// usually does not change between the rebuilds of the preconditioner.
+    /// One entry is kept per number of rows, such that the preconditioners
+    /// of different systems of a solver do not evict each other. Entries are
+    /// only told apart by the number of rows and nonzeros, so the solver
+    /// owning the cache must call clear() whenever the sparsity pattern of
+    /// its matrix may have changed. The preconditioners using the cache must
+    /// be set up one after another, never concurrently.
+    ///
+    /// The cache also holds the cluster keys of the rows (e.g. the PVTNUM and
+    /// SATNUM regions of the cells) for the reverse Cuthill-McKee ordering.
+    class OrderingCache
+    {
+    public:
+        /// \brief Set one key per row of the matrices of the solver, which are
+        /// passed to reorderVerticesReverseCuthillMcKee(). Unlike the orderings
+        /// they are not dropped by clear().
+        void setClusterKeys(std::vector<int> keys)
+        {
+            if ( keys != clusterKeys_ )
+            {
+                clusterKeys_ = std::move(keys);
+                entries_.clear();
+            }
+        }
+
+        /// \brief The cluster keys if there is one for each row of A, else none.
+        template<class M>
+        const std::vector<int>& clusterKeys(const M& A) const
+        {
+            static const std::vector<int> noKeys;
+            return clusterKeys_.size() == A.N() ? clusterKeys_ : noKeys;
+        }
+
+        /// \brief Return the ordering stored for the pattern of A, or nullptr.
+        template<class M>
+        const std::vector<std::size_t>* find(const M& A, int kind) const
+        {
+            auto entry = entries_.find(A.N());
+            if ( entry == entries_.end() || entry->second.kind != kind ||
+                 entry->second.nonzeroes != A.nonzeroes() )
+            {
+                return nullptr;
+            }
+            return &entry->second.ordering;
+        }
+
+        template<class M>
+        void insert(const M& A, int kind, const std::vector<std::size_t>& ordering)
+        {
+            if ( entries_.size() >= maxEntries && entries_.find(A.N()) == entries_.end() )
+            {
+                entries_.clear();
+            }
+            auto& entry = entries_[A.N()];
+            entry.kind = kind;
+            entry.nonzeroes = A.nonzeroes();
+            entry.ordering = ordering;
+        }
+
+        /// \brief Forget all orderings, e.g. because the topology changed.
+        void clear()
+        {
+            entries_.clear();
+        }
+
+    private:
+        static constexpr std::size_t maxEntries = 8;
+
+        struct Entry
+        {
+            int kind;
+            std::size_t nonzeroes;
+            std::vector<std::size_t> ordering;
+        };
+        std::map<std::size_t, Entry> entries_;
+        std::vector<int> clusterKeys_;
+    };
+
     struct IdentityFunctor
     {
         template<class T>
@@ -338,61 +491,143 @@ namespace Opm
                             diagonal);
     }
 
+    /// \brief Mark the rows owned by this process, or return an empty
+    /// vector if all rows are owned.
+    template<class Comm>
+    std::vector<bool> ownerRows(const Comm* comm, std::size_t size)
+    {
+        std::vector<bool> owner;
+        if ( comm )
+        {
+            for ( const auto& index : comm->indexSet() )
+            {
+                if ( index.local().attribute() != Dune::OwnerOverlapCopyAttributeSet::owner )
+                {
+                    owner.resize(size, true);
+                    owner[index.local().local()] = false;
+                }
+            }
+        }
+        return owner;
+    }
+
+    inline std::vector<bool> ownerRows(const Dune::Amg::SequentialInformation*, std::size_t)
+    {
+        return std::vector<bool>();
+    }
+
+    /// \brief The sparsity pattern of an ILU(n) factorization in CRS format.
+    struct ILUPattern
+    {
+        std::vector<std::size_t> rowStart;
+        std::vector<std::size_t> columns;
+
+        std::size_t nonzeroes() const
+        {
+            return columns.size();
+        }
+    };
+
+    /// \brief Compute the pattern of the ILU(n) factors of the reordered matrix A.
+    ///
+    /// Entries of A have level 0. Eliminating row i with row k creates the
+    /// entry (i,j) with level lev(i,k) + lev(k,j) + 1, which is kept if it
+    /// does not exceed n.
+    /// \param interior If not empty, fill-in is only created between rows
+    ///        and columns marked true (in the original numbering), e.g. the
+    ///        owner rows of a parallel run. The overlap rows keep the pattern
+    ///        of A, such that the factor of the owner rows does not depend on
+    ///        the size of the overlap of a process.
     template<class M>
-    void milun_decomposition(const M& A, int n, MILU_VARIANT milu, M& ILU,
-                             Reorderer& ordering, Reorderer& inverseOrdering)
+    ILUPattern iluk_pattern(const M& A, int n, const Reorderer& ordering,
+                            const Reorderer& inverseOrdering,
+                            const std::vector<bool>& interior)
     {
-        using Map = std::map<std::size_t, int>;
+        ILUPattern pattern;
+        pattern.rowStart.reserve(A.N() + 1);
+        pattern.rowStart.push_back(0);
+        pattern.columns.reserve(A.nonzeroes());
+        std::vector<int> levels;
+        levels.reserve(A.nonzeroes());
+        // position of the diagonal of each row in columns
+        std::vector<std::size_t> diagonal(A.N());
+        auto isInterior = [&](std::size_t newIndex)
+            {
+                return interior.empty() || interior[inverseOrdering[newIndex]];
+            };
 
-        auto iluRow = ILU.createbegin();
+        using Map = std::map<std::size_t, int>;
+        Map rowPattern;
 
         for(std::size_t i = 0, iend = A.N(); i < iend; ++i)
         {
-            auto& orow = A[inverseOrdering[i]];
-
-            Map rowPattern;
+            const auto& orow = A[inverseOrdering[i]];
+            rowPattern.clear();
             for ( auto col = orow.begin(), cend = orow.end(); col != cend; ++col)
             {
                 rowPattern[ordering[col.index()]] = 0;
             }
 
-            for(auto ik = rowPattern.begin(); ik->first < i; ++ik)
+            if ( isInterior(i) )
             {
-                if ( ik->second < n )
+                // entries inserted right of ik are visited later on.
+                for(auto ik = rowPattern.begin(); ik != rowPattern.end() && ik->first < i; ++ik)
                 {
-                    auto& rowk = ILU[ik->first];
-
-                    for ( auto kj = rowk.find(ik->first), endk = rowk.end();
-                          kj != endk; ++kj)
+                    const int levelIk = ik->second;
+                    if ( levelIk >= n )
                     {
-                        // Assume double and block_type FieldMatrix
-                        // first element is misused to store generation number
-                        int generation = (*kj)[0][0];
-                        if(generation < n)
+                        continue;
+                    }
+                    const std::size_t k = ik->first;
+                    for ( std::size_t kj = diagonal[k] + 1; kj < pattern.rowStart[k + 1]; ++kj)
+                    {
+                        const int level = levelIk + levels[kj] + 1;
+                        if ( level > n )
                         {
-                            auto ij = rowPattern.find(kj.index());
-                            if ( ij == rowPattern.end() )
-                            {
-                                rowPattern[ordering[kj.index()]] = generation + 1;
-                            }
+                            continue;
+                        }
+                        const std::size_t j = pattern.columns[kj];
+                        auto ij = rowPattern.find(j);
+                        if ( ij != rowPattern.end() )
+                        {
+                            ij->second = std::min(ij->second, level);
+                        }
+                        else if ( isInterior(j) )
+                        {
+                            rowPattern.emplace(j, level);
                         }
                     }
                 }
             }
-            // create the row
-            for(const auto entry: rowPattern)
+
+            for(const auto& entry: rowPattern)
             {
-                iluRow.insert(entry.first);
+                if ( entry.first == i )
+                {
+                    diagonal[i] = pattern.columns.size();
+                }
+                pattern.columns.push_back(entry.first);
+                levels.push_back(entry.second);
             }
-            ++iluRow;
+            pattern.rowStart.push_back(pattern.columns.size());
+        }
+        return pattern;
+    }
 
-            // write generation to newly created row.
-            auto generationPair = rowPattern.begin();
-            for ( auto col = ILU[i].begin(), cend = ILU[i].end(); col != cend;
-                  ++col, ++generationPair)
+    /// \brief Compute the ILU(n) or MILU(n) factorization of the reordered matrix A.
+    /// \param pattern The pattern of ILU computed by iluk_pattern.
+    template<class M>
+    void milun_decomposition(const M& A, const ILUPattern& pattern, MILU_VARIANT milu, M& ILU,
+                             Reorderer& ordering)
+    {
+        ILU.setBuildMode(M::row_wise);
+        ILU.setSize(A.N(), A.M(), pattern.nonzeroes());
+        for(auto iluRow = ILU.createbegin(), iend = ILU.createend(); iluRow != iend; ++iluRow)
+        {
+            const auto i = iluRow.index();
+            for ( auto k = pattern.rowStart[i]; k < pattern.rowStart[i + 1]; ++k )
             {
-                assert(col.index() == generationPair->first);
-                (*col)[0][0] = generationPair->second;
+                iluRow.insert(pattern.columns[k]);
             }
         }
 
@@ -400,7 +635,7 @@ namespace Opm
         for(auto iter=A.begin(), iend = A.end(); iter != iend; ++iter)
         {
             auto& newRow = ILU[ordering[iter.index()]];
-            // reset stored generation
+            // fill-in starts with zero
             for ( auto& col: newRow)
             {
                 col = 0;
@@ -625,7 +860,7 @@ public:
 
       Constructor gets all parameters to operate the prec.
       \param A The matrix to operate on.
-      \param n ILU fill in level (for testing). This does not work in parallel.
+      \param n ILU fill in level. In parallel fill-in is only created between owner rows.
       \param w The relaxation factor.
       \param milu The modified ILU variant to use. 0 means traditional ILU. \see MILU_VARIANT.
       \param redblack Whether to use a red-black ordering.
@@ -633,28 +868,38 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param reorder_rcm Whether to use a reverse Cuthill-McKee ordering if no
+                         red-black ordering is requested.
+      \param speculative_coloring Whether to color the vertices for the red-black
+                                  ordering in parallel with colorVerticesSpeculative
+                                  instead of colorVerticesWelshPowell.
+      \param ordering_cache Orderings computed by earlier preconditioners, which
+                            are reused if the sparsity pattern is the same.
     */
     template<class BlockType, class Alloc>
     ParallelOverlappingILU0 (const Dune::BCRSMatrix<BlockType,Alloc>& A,
                              const int n, const field_type w,
                              MILU_VARIANT milu, bool redblack=false,
-                             bool reorder_sphere=true)
+                             bool reorder_sphere=true, bool reorder_rcm=false,
+                             bool speculative_coloring=false,
+                             std::shared_ptr<detail::OrderingCache> ordering_cache = nullptr)
         : lower_(),
           upper_(),
           inv_(),
           comm_(nullptr), w_(w),
-          relaxation_( std::abs( w - 1.0 ) > 1e-15 )
+          relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
+          orderingCache_( std::move(ordering_cache) )
     {
         // BlockMatrix is a Subclass of FieldMatrix that just adds
         // methods. Therefore this cast should be safe.
         init( reinterpret_cast<const Matrix&>(A), n, milu, redblack,
-              reorder_sphere  );
+              reorder_sphere, reorder_rcm, speculative_coloring );
     }
 
     /*! \brief Constructor gets all parameters to operate the prec.
       \param A The matrix to operate on.
       \param comm   communication object, e.g. Dune::OwnerOverlapCopyCommunication
-      \param n ILU fill in level (for testing). This does not work in parallel.
+      \param n ILU fill in level. In parallel fill-in is only created between owner rows.
       \param w The relaxation factor.
       \param milu The modified ILU variant to use. 0 means traditional ILU. \see MILU_VARIANT.
       \param redblack Whether to use a red-black ordering.
@@ -662,22 +907,32 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param reorder_rcm Whether to use a reverse Cuthill-McKee ordering if no
+                         red-black ordering is requested.
+      \param speculative_coloring Whether to color the vertices for the red-black
+                                  ordering in parallel with colorVerticesSpeculative
+                                  instead of colorVerticesWelshPowell.
+      \param ordering_cache Orderings computed by earlier preconditioners, which
+                            are reused if the sparsity pattern is the same.
     */
     template<class BlockType, class Alloc>
     ParallelOverlappingILU0 (const Dune::BCRSMatrix<BlockType,Alloc>& A,
                              const ParallelInfo& comm, const int n, const field_type w,
                              MILU_VARIANT milu, bool redblack=false,
-                             bool reorder_sphere=true)
+                             bool reorder_sphere=true, bool reorder_rcm=false,
+                             bool speculative_coloring=false,
+                             std::shared_ptr<detail::OrderingCache> ordering_cache = nullptr)
         : lower_(),
           upper_(),
           inv_(),
           comm_(&comm), w_(w),
-          relaxation_( std::abs( w - 1.0 ) > 1e-15 )
+          relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
+          orderingCache_( std::move(ordering_cache) )
     {
         // BlockMatrix is a Subclass of FieldMatrix that just adds
         // methods. Therefore this cast should be safe.
         init( reinterpret_cast<const Matrix&>(A), n, milu, redblack,
-              reorder_sphere );
+              reorder_sphere, reorder_rcm, speculative_coloring );
     }
 
     /*! \brief Constructor.
@@ -691,12 +946,22 @@ public:
                   The vertices on each layer aound it (same distance) are
                   ordered consecutivly. If false, we preserver the order of
                   the vertices with the same color.
+      \param reorder_rcm Whether to use a reverse Cuthill-McKee ordering if no
+                         red-black ordering is requested.
+      \param speculative_coloring Whether to color the vertices for the red-black
+                                  ordering in parallel with colorVerticesSpeculative
+                                  instead of colorVerticesWelshPowell.
+      \param ordering_cache Orderings computed by earlier preconditioners, which
+                            are reused if the sparsity pattern is the same.
     */
     template<class BlockType, class Alloc>
     ParallelOverlappingILU0 (const Dune::BCRSMatrix<BlockType,Alloc>& A,
                              const field_type w, MILU_VARIANT milu, bool redblack=false,
-                             bool reorder_sphere=true)
-        : ParallelOverlappingILU0( A, 0, w, milu, redblack, reorder_sphere )
+                             bool reorder_sphere=true, bool reorder_rcm=false,
+                             bool speculative_coloring=false,
+                             std::shared_ptr<detail::OrderingCache> ordering_cache = nullptr)
+        : ParallelOverlappingILU0( A, 0, w, milu, redblack, reorder_sphere, reorder_rcm,
+                                   speculative_coloring, std::move(ordering_cache) )
     {
     }
 
@@ -712,22 +977,32 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param reorder_rcm Whether to use a reverse Cuthill-McKee ordering if no
+                         red-black ordering is requested.
+      \param speculative_coloring Whether to color the vertices for the red-black
+                                  ordering in parallel with colorVerticesSpeculative
+                                  instead of colorVerticesWelshPowell.
+      \param ordering_cache Orderings computed by earlier preconditioners, which
+                            are reused if the sparsity pattern is the same.
     */
     template<class BlockType, class Alloc>
     ParallelOverlappingILU0 (const Dune::BCRSMatrix<BlockType,Alloc>& A,
                              const ParallelInfo& comm, const field_type w,
                              MILU_VARIANT milu, bool redblack=false,
-                             bool reorder_sphere=true)
+                             bool reorder_sphere=true, bool reorder_rcm=false,
+                             bool speculative_coloring=false,
+                             std::shared_ptr<detail::OrderingCache> ordering_cache = nullptr)
         : lower_(),
           upper_(),
           inv_(),
           comm_(&comm), w_(w),
-          relaxation_( std::abs( w - 1.0 ) > 1e-15 )
+          relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
+          orderingCache_( std::move(ordering_cache) )
     {
         // BlockMatrix is a Subclass of FieldMatrix that just adds
         // methods. Therefore this cast should be safe.
         init( reinterpret_cast<const Matrix&>(A), 0, milu, redblack,
-              reorder_sphere );
+              reorder_sphere, reorder_rcm, speculative_coloring );
     }
 
     /*!
@@ -823,7 +1098,8 @@ public:
     }
 
 protected:
-    void init( const Matrix& A, const int iluIteration, MILU_VARIANT milu, bool redBlack, bool reorderSpheres )
+    void init( const Matrix& A, const int iluIteration, MILU_VARIANT milu, bool redBlack, bool reorderSpheres,
+               bool reorderRcm, bool speculativeColoring )
     {
         // (For older DUNE versions the communicator might be
         // invalid if redistribution in AMG happened on the coarset level.
@@ -847,11 +1123,22 @@ protected:
 
         std::unique_ptr< Matrix > ILU;
 
-        if ( redBlack )
+        // 1: red-black in spheres, 2: red-black preserving, 3: reverse Cuthill-McKee,
+        // 4 and 5: red-black as 1 and 2 with the speculative coloring
+        const int orderingKind = redBlack ? ( reorderSpheres ? 1 : 2 ) + ( speculativeColoring ? 3 : 0 )
+                                          : ( reorderRcm ? 3 : 0 );
+        const auto* cachedOrdering = ( orderingKind && orderingCache_ ) ? orderingCache_->find(A, orderingKind) : nullptr;
+
+        if ( cachedOrdering )
+        {
+            ordering_ = *cachedOrdering;
+        }
+        else if ( redBlack )
         {
             using Graph = Dune::Amg::MatrixGraph<const Matrix>;
             Graph graph(A);
-            auto colorsTuple = colorVerticesWelshPowell(graph);
+            auto colorsTuple = speculativeColoring ? colorVerticesSpeculative(graph)
+                                                   : colorVerticesWelshPowell(graph);
             const auto& colors = std::get<0>(colorsTuple);
             const auto& verticesPerColor = std::get<2>(colorsTuple);
             auto noColors = std::get<1>(colorsTuple);
@@ -866,6 +1153,18 @@ protected:
                                                       graph);
             }
         }
+        else if ( reorderRcm )
+        {
+            using Graph = Dune::Amg::MatrixGraph<const Matrix>;
+            Graph graph(A);
+            ordering_ = orderingCache_ ? reorderVerticesReverseCuthillMcKee(graph, orderingCache_->clusterKeys(A))
+                                       : reorderVerticesReverseCuthillMcKee(graph);
+        }
+
+        if ( orderingKind && orderingCache_ && !cachedOrdering )
+        {
+            orderingCache_->insert(A, orderingKind, ordering_);
+        }
 
         std::vector<std::size_t> inverseOrdering(ordering_.size());
         std::size_t index = 0;
@@ -930,7 +1229,7 @@ protected:
             }
             else {
                 // create ILU-n decomposition
-                ILU.reset( new Matrix( A.N(), A.M(), Matrix::row_wise) );
+                ILU.reset( new Matrix() );
                 std::unique_ptr<detail::Reorderer> reorderer, inverseReorderer;
                 if ( ordering_.empty() )
                 {
@@ -943,7 +1242,10 @@ protected:
                     inverseReorderer.reset(new detail::RealReorderer(inverseOrdering));
                 }
 
-                milun_decomposition( A, iluIteration, milu, *ILU, *reorderer, *inverseReorderer );
+                const auto pattern = detail::iluk_pattern( A, iluIteration, *reorderer, *inverseReorderer,
+                                                           detail::ownerRows( comm_, A.N() ) );
+                reportFactorSize( A, pattern, iluIteration, rank );
+                detail::milun_decomposition( A, pattern, milu, *ILU, *reorderer );
             }
         }
         catch (const Dune::MatrixBlockError& error)
@@ -967,6 +1269,28 @@ protected:
         detail::convertToCRS( *ILU, lower_, upper_, inv_ );
     }
 
+    /// \brief Log the size of the ILU(n) factors of all processes before allocating them.
+    void reportFactorSize( const Matrix& A, const detail::ILUPattern& pattern, int n, int rank ) const
+    {
+        std::size_t sizes[2] = { A.nonzeroes(), pattern.nonzeroes() };
+        if ( comm_ )
+        {
+            comm_->communicator().sum( sizes, 2 );
+        }
+        if ( rank == 0 )
+        {
+            // The factors are held twice during the setup: in the matrix
+            // and in the CRS storage used by apply.
+            const double megabytes = 2.0 * sizes[1] * ( sizeof( block_type ) + sizeof( size_type ) )
+                / ( 1024.0 * 1024.0 );
+            std::ostringstream message;
+            message << "ILU(" << n << ") factors: " << sizes[1] << " nonzero blocks, "
+                    << std::setprecision(3) << double( sizes[1] ) / std::max( sizes[0], std::size_t(1) )
+                    << " times the matrix, about " << megabytes << " MB";
+            OpmLog::debug( message.str() );
+        }
+    }
+
     /// \brief Reorder D if needed and return a reference to it.
     Range& reorderD(const Range& d)
     {
@@ -1036,6 +1360,8 @@ protected:
     //! \brief The relaxation factor to use.
     const field_type w_;
     const bool relaxation_;
+    //! \brief The orderings of earlier matrices, if any.
+    std::shared_ptr<detail::OrderingCache> orderingCache_;
 
 };
 
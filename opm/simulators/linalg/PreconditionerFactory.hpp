@@ -25,6 +25,7 @@
 #include <opm/simulators/linalg/OwningBlockPreconditioner.hpp>
 #include <opm/simulators/linalg/OwningTwoLevelPreconditioner.hpp>
 #include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
+#include <opm/simulators/linalg/PreconditionerSetupData.hpp>
 #include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
 #include <opm/simulators/linalg/amgcpr.hh>
 
@@ -60,23 +61,30 @@ public:
     using Creator = std::function<PrecPtr(const Operator&, const boost::property_tree::ptree&)>;
     using ParCreator = std::function<PrecPtr(const Operator&, const boost::property_tree::ptree&, const Comm&)>;
 
+    /// The type of the data a solver keeps for the preconditioners it creates.
+    using SetupDataPtr = std::shared_ptr<Opm::PreconditionerSetupData>;
+
     /// Create a new serial preconditioner and return a pointer to it.
     /// \param op    operator to be preconditioned.
     /// \param prm   parameters for the preconditioner, in particular its type.
+    /// \param data  data kept by the solver between preconditioner setups, may be null.
     /// \return      (smart) pointer to the created preconditioner.
-    static PrecPtr create(const Operator& op, const boost::property_tree::ptree& prm)
+    static PrecPtr create(const Operator& op, const boost::property_tree::ptree& prm,
+                          const SetupDataPtr& data = SetupDataPtr())
     {
-        return instance().doCreate(op, prm);
+        return instance().doCreate(op, prm, data);
     }
 
     /// Create a new parallel preconditioner and return a pointer to it.
     /// \param op    operator to be preconditioned.
     /// \param prm   parameters for the preconditioner, in particular its type.
     /// \param comm  communication object (typically OwnerOverlapCopyCommunication).
+    /// \param data  data kept by the solver between preconditioner setups, may be null.
     /// \return      (smart) pointer to the created preconditioner.
-    static PrecPtr create(const Operator& op, const boost::property_tree::ptree& prm, const Comm& comm)
+    static PrecPtr create(const Operator& op, const boost::property_tree::ptree& prm, const Comm& comm,
+                          const SetupDataPtr& data = SetupDataPtr())
     {
-        return instance().doCreate(op, prm, comm);
+        return instance().doCreate(op, prm, comm, data);
     }
 
     /// Add a creator for a serial preconditioner to the PreconditionerFactory.
@@ -104,6 +112,12 @@ public:
     }
 
 private:
+    // Creators that also get the setup data. All creators are stored as such.
+    using SetupCreator
+        = std::function<PrecPtr(const Operator&, const boost::property_tree::ptree&, const SetupDataPtr&)>;
+    using ParSetupCreator = std::function<PrecPtr(
+        const Operator&, const boost::property_tree::ptree&, const Comm&, const SetupDataPtr&)>;
+
     using CriterionBase
         = Dune::Amg::AggregationCriterion<Dune::Amg::SymmetricMatrixDependency<Matrix, Dune::Amg::FirstDiagonal>>;
     using Criterion = Dune::Amg::CoarsenCriterion<CriterionBase>;
@@ -118,9 +132,34 @@ private:
         criterion.setMaxLevel(prm.get<int>("maxlevel"));
         criterion.setSkipIsolated(false);
         criterion.setDebugLevel(prm.get<int>("verbosity"));
+        // Agglomeration of the coarse levels onto fewer processes. Once the
+        // unknowns of a level become few compared to coarsenTarget the
+        // hierarchy redistributes it, either onto a single process (where
+        // the coarse system is then solved directly) or successively onto
+        // fewer processes. The aggregate sizes determine how many processes
+        // are kept when accumulating successively.
+        criterion.setAccumulate(amgAccumulation(prm.get<std::string>("accumulate", "none")));
+        criterion.setMinCoarsenRate(prm.get<double>("mincoarsenrate", criterion.minCoarsenRate()));
+        criterion.setMinAggregateSize(prm.get<int>("minaggregatesize", criterion.minAggregateSize()));
+        criterion.setMaxAggregateSize(prm.get<int>("maxaggregatesize", criterion.maxAggregateSize()));
         return criterion;
     }
 
+    static Dune::Amg::AccumulationMode amgAccumulation(const std::string& mode)
+    {
+        if (mode == "none") {
+            return Dune::Amg::noAccu;
+        } else if (mode == "atonce") {
+            return Dune::Amg::atOnceAccu;
+        } else if (mode == "successive") {
+            return Dune::Amg::successiveAccu;
+        } else {
+            std::string msg("No such accumulation mode: ");
+            msg += mode;
+            throw std::runtime_error(msg);
+        }
+    }
+
     template <typename Smoother>
     static auto amgSmootherArgs(const boost::property_tree::ptree& prm)
     {
@@ -142,6 +181,12 @@ private:
         return std::make_shared<Dune::Amg::AMGCPR<Operator, Vector, Smoother>>(op, crit, sargs);
     }
 
+    // The ordering cache of the solver for an ILU0 preconditioner, if any.
+    static std::shared_ptr<Opm::detail::OrderingCache> iluOrderings(const SetupDataPtr& data)
+    {
+        return data ? data->iluOrderings : nullptr;
+    }
+
     // Add a useful default set of preconditioners to the factory.
     // This is the default template, used for parallel preconditioners.
     // (Serial specialization below).
@@ -158,11 +203,15 @@ private:
             const double w = prm.get<double>("relaxation");
             return wrapBlockPreconditioner<DummyUpdatePreconditioner<SeqILU0<M, V, V>>>(comm, op.getmat(), w);
         });
-        doAddCreator("ParOverILU0", [](const O& op, const P& prm, const C& comm) {
+        doAddSetupCreator("ParOverILU0", [](const O& op, const P& prm, const C& comm, const SetupDataPtr& data) {
             const double w = prm.get<double>("relaxation");
+            const int n = prm.get<int>("ilulevel", 0);
             // Already a parallel preconditioner. Need to pass comm, but no need to wrap it in a BlockPreconditioner.
             return wrapPreconditioner<Opm::ParallelOverlappingILU0<M, V, V, C>>(
-                op.getmat(), comm, 0, w, Opm::MILU_VARIANT::ILU);
+                op.getmat(), comm, n, w, Opm::MILU_VARIANT::ILU,
+                prm.get<bool>("redblack", false), prm.get<bool>("reorder_spheres", true),
+                prm.get<bool>("reorder_rcm", false), prm.get<bool>("speculative_coloring", false),
+                iluOrderings(data));
         });
         doAddCreator("ILUn", [](const O& op, const P& prm, const C& comm) {
             const int n = prm.get<int>("ilulevel");
@@ -202,11 +251,11 @@ private:
                 throw std::runtime_error(msg);
             }
         });
-        doAddCreator("cpr", [](const O& op, const P& prm, const C& comm) {
-            return std::make_shared<OwningTwoLevelPreconditioner<O, V, false, Comm>>(op, prm, comm);
+        doAddSetupCreator("cpr", [](const O& op, const P& prm, const C& comm, const SetupDataPtr& data) {
+            return std::make_shared<OwningTwoLevelPreconditioner<O, V, false, Comm>>(op, prm, comm, data);
         });
-        doAddCreator("cprt", [](const O& op, const P& prm, const C& comm) {
-            return std::make_shared<OwningTwoLevelPreconditioner<O, V, true, Comm>>(op, prm, comm);
+        doAddSetupCreator("cprt", [](const O& op, const P& prm, const C& comm, const SetupDataPtr& data) {
+            return std::make_shared<OwningTwoLevelPreconditioner<O, V, true, Comm>>(op, prm, comm, data);
         });
     }
 
@@ -223,9 +272,14 @@ private:
             const double w = prm.get<double>("relaxation");
             return wrapPreconditioner<SeqILU0<M, V, V>>(op.getmat(), w);
         });
-        doAddCreator("ParOverILU0", [](const O& op, const P& prm) {
+        doAddSetupCreator("ParOverILU0", [](const O& op, const P& prm, const SetupDataPtr& data) {
             const double w = prm.get<double>("relaxation");
-            return wrapPreconditioner<Opm::ParallelOverlappingILU0<M, V, V>>(op.getmat(), 0, w, Opm::MILU_VARIANT::ILU);
+            const int n = prm.get<int>("ilulevel", 0);
+            return wrapPreconditioner<Opm::ParallelOverlappingILU0<M, V, V>>(
+                op.getmat(), n, w, Opm::MILU_VARIANT::ILU,
+                prm.get<bool>("redblack", false), prm.get<bool>("reorder_spheres", true),
+                prm.get<bool>("reorder_rcm", false), prm.get<bool>("speculative_coloring", false),
+                iluOrderings(data));
         });
         doAddCreator("ILUn", [](const O& op, const P& prm) {
             const int n = prm.get<int>("ilulevel");
@@ -282,11 +336,11 @@ private:
             parms.setNoPostSmoothSteps(1);
             return wrapPreconditioner<Dune::Amg::FastAMG<O, V>>(op, crit, parms);
         });
-        doAddCreator("cpr", [](const O& op, const P& prm) {
-            return std::make_shared<OwningTwoLevelPreconditioner<O, V, false>>(op, prm);
+        doAddSetupCreator("cpr", [](const O& op, const P& prm, const SetupDataPtr& data) {
+            return std::make_shared<OwningTwoLevelPreconditioner<O, V, false>>(op, prm, data);
         });
-        doAddCreator("cprt", [](const O& op, const P& prm) {
-            return std::make_shared<OwningTwoLevelPreconditioner<O, V, true>>(op, prm);
+        doAddSetupCreator("cprt", [](const O& op, const P& prm, const SetupDataPtr& data) {
+            return std::make_shared<OwningTwoLevelPreconditioner<O, V, true>>(op, prm, data);
         });
     }
 
@@ -307,7 +361,7 @@ private:
     }
 
     // Actually creates the product object.
-    PrecPtr doCreate(const Operator& op, const boost::property_tree::ptree& prm)
+    PrecPtr doCreate(const Operator& op, const boost::property_tree::ptree& prm, const SetupDataPtr& data)
     {
         const std::string& type = prm.get<std::string>("type");
         auto it = creators_.find(type);
@@ -320,10 +374,11 @@ private:
             msg << std::endl;
             throw std::runtime_error(msg.str());
         }
-        return it->second(op, prm);
+        return it->second(op, prm, data);
     }
 
-    PrecPtr doCreate(const Operator& op, const boost::property_tree::ptree& prm, const Comm& comm)
+    PrecPtr doCreate(const Operator& op, const boost::property_tree::ptree& prm, const Comm& comm,
+                     const SetupDataPtr& data)
     {
         const std::string& type = prm.get<std::string>("type");
         auto it = parallel_creators_.find(type);
@@ -337,24 +392,41 @@ private:
             msg << std::endl;
             throw std::runtime_error(msg.str());
         }
-        return it->second(op, prm, comm);
+        return it->second(op, prm, comm, data);
     }
 
     // Actually adds the creator.
     void doAddCreator(const std::string& type, Creator c)
     {
-        creators_[type] = c;
+        creators_[type] = [c](const Operator& op, const boost::property_tree::ptree& prm, const SetupDataPtr&) {
+            return c(op, prm);
+        };
     }
 
     // Actually adds the creator.
     void doAddCreator(const std::string& type, ParCreator c)
+    {
+        parallel_creators_[type]
+            = [c](const Operator& op, const boost::property_tree::ptree& prm, const Comm& comm, const SetupDataPtr&) {
+                  return c(op, prm, comm);
+              };
+    }
+
+    // Adds a creator that uses the setup data.
+    void doAddSetupCreator(const std::string& type, SetupCreator c)
+    {
+        creators_[type] = c;
+    }
+
+    // Adds a creator that uses the setup data.
+    void doAddSetupCreator(const std::string& type, ParSetupCreator c)
     {
         parallel_creators_[type] = c;
     }
 
     // This map contains the whole factory, i.e. all the Creators.
-    std::map<std::string, Creator> creators_;
-    std::map<std::string, ParCreator> parallel_creators_;
+    std::map<std::string, SetupCreator> creators_;
+    std::map<std::string, ParSetupCreator> parallel_creators_;
 };
 
 } // namespace Dune
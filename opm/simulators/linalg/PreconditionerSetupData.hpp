@@ -0,0 +1,67 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PRECONDITIONERSETUPDATA_HEADER_INCLUDED
+#define OPM_PRECONDITIONERSETUPDATA_HEADER_INCLUDED
+
+#include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/istl/bcrsmatrix.hh>
+
+#include <memory>
+#include <vector>
+
+namespace Opm
+{
+
+/// Data that a linear solver keeps for the preconditioners it creates, such
+/// that a rebuilt preconditioner can reuse the work of the previous one.
+///
+/// All of it only depends on the sparsity pattern of the matrix. The solver
+/// calls clear() whenever it is handed a new matrix, which is the only time
+/// the pattern can change. The preconditioners are set up one after another,
+/// never concurrently.
+struct PreconditionerSetupData
+{
+    using PressureMatrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>>;
+
+    /// The pressure matrix of the last CPR preconditioner. The next one
+    /// copies its sparsity pattern instead of building it row by row.
+    std::shared_ptr<PressureMatrix> pressureMatrix;
+
+    /// Orderings of the ILU0 preconditioners on the full system.
+    std::shared_ptr<detail::OrderingCache> iluOrderings = std::make_shared<detail::OrderingCache>();
+
+    /// Fixed CPR weights, one per unknown and stored cell by cell, e.g. the
+    /// ones dumped along with a linear system that is replayed. If empty,
+    /// the CPR preconditioners compute quasi-IMPES weights themselves. These
+    /// are set by the caller and are not touched by clear().
+    std::vector<double> cprWeights;
+
+    void clear()
+    {
+        pressureMatrix.reset();
+        iluOrderings->clear();
+    }
+};
+
+} // namespace Opm
+
+#endif // OPM_PRECONDITIONERSETUPDATA_HEADER_INCLUDED
@@ -22,8 +22,12 @@
 #define OPM_PRESSURE_TRANSFER_POLICY_HEADER_INCLUDED
 
 
+#include <opm/simulators/linalg/PreconditionerSetupData.hpp>
 #include <opm/simulators/linalg/twolevelmethodcpr.hh>
 
+#include <cassert>
+#include <memory>
+#include <type_traits>
 
 namespace Opm
 {
@@ -37,25 +41,56 @@ public:
     typedef typename FineOperator::domain_type FineVectorType;
 
 public:
-    PressureTransferPolicy(const Communication& comm, const FineVectorType& weights, int pressure_var_index)
+    /// \param setupData Where the pressure matrix is left for the next policy
+    ///                  that is set up for a matrix with the same pattern, if any.
+    PressureTransferPolicy(const Communication& comm, const FineVectorType& weights, int pressure_var_index,
+                           std::shared_ptr<PreconditionerSetupData> setupData = nullptr)
         : communication_(&const_cast<Communication&>(comm))
         , weights_(weights)
         , pressure_var_index_(pressure_var_index)
+        , setupData_(std::move(setupData))
     {
     }
 
+    /// The copy has its own pressure matrix.
+    PressureTransferPolicy(const PressureTransferPolicy& other)
+        : ParentType(other)
+        , communication_(other.communication_)
+        , weights_(other.weights_)
+        , pressure_var_index_(other.pressure_var_index_)
+        , setupData_(other.setupData_)
+        , coarseLevelCommunication_(other.coarseLevelCommunication_)
+    {
+        if (other.coarseLevelMatrix_) {
+            coarseLevelMatrix_ = std::make_shared<CoarseMatrixType>(*other.coarseLevelMatrix_);
+            createCoarseOperator_();
+        }
+    }
+
     virtual void createCoarseLevelSystem(const FineOperator& fineOperator) override
     {
-        using CoarseMatrix = typename CoarseOperator::matrix_type;
         const auto& fineLevelMatrix = fineOperator.getmat();
-        coarseLevelMatrix_.reset(new CoarseMatrix(fineLevelMatrix.N(), fineLevelMatrix.M(), CoarseMatrix::row_wise));
-        auto createIter = coarseLevelMatrix_->createbegin();
 
-        for (const auto& row : fineLevelMatrix) {
-            for (auto col = row.begin(), cend = row.end(); col != cend; ++col) {
-                createIter.insert(col.index());
+        // The pressure matrix has the sparsity pattern of the fine matrix,
+        // which only changes when the solver gets a new matrix. The pattern
+        // of the previous pressure matrix is then copied, which is much
+        // cheaper than building it row by row.
+        if (setupData_ && setupData_->pressureMatrix) {
+            assert(setupData_->pressureMatrix->N() == fineLevelMatrix.N());
+            coarseLevelMatrix_ = std::make_shared<CoarseMatrixType>(*setupData_->pressureMatrix);
+        } else {
+            coarseLevelMatrix_.reset(new CoarseMatrixType(fineLevelMatrix.N(), fineLevelMatrix.M(), CoarseMatrixType::row_wise));
+            auto createIter = coarseLevelMatrix_->createbegin();
+
+            for (const auto& row : fineLevelMatrix) {
+                for (auto col = row.begin(), cend = row.end(); col != cend; ++col) {
+                    createIter.insert(col.index());
+                }
+                ++createIter;
             }
-            ++createIter;
+        }
+        if (setupData_) {
+            setupData_->pressureMatrix = coarseLevelMatrix_;
         }
 
         calculateCoarseEntries(fineOperator);
@@ -63,62 +98,58 @@ public:
 
         this->lhs_.resize(this->coarseLevelMatrix_->M());
         this->rhs_.resize(this->coarseLevelMatrix_->N());
-        using OperatorArgs = typename Dune::Amg::ConstructionTraits<CoarseOperator>::Arguments;
-#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 7)
-        OperatorArgs oargs(coarseLevelMatrix_, *coarseLevelCommunication_);
-        this->operator_ = Dune::Amg::ConstructionTraits<CoarseOperator>::construct(oargs);
-#else
-        OperatorArgs oargs(*coarseLevelMatrix_, *coarseLevelCommunication_);
-        this->operator_.reset(Dune::Amg::ConstructionTraits<CoarseOperator>::construct(oargs));
-#endif
+        createCoarseOperator_();
     }
 
     virtual void calculateCoarseEntries(const FineOperator& fineOperator) override
     {
         const auto& fineMatrix = fineOperator.getmat();
-        *coarseLevelMatrix_ = 0;
-        auto rowCoarse = coarseLevelMatrix_->begin();
-        for (auto row = fineMatrix.begin(), rowEnd = fineMatrix.end(); row != rowEnd; ++row, ++rowCoarse) {
-            assert(row.index() == rowCoarse.index());
-            auto entryCoarse = rowCoarse->begin();
-            for (auto entry = row->begin(), entryEnd = row->end(); entry != entryEnd; ++entry, ++entryCoarse) {
+        assert(fineMatrix.N() == coarseLevelMatrix_->N());
+        const int numRows = fineMatrix.N();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int rowIdx = 0; rowIdx < numRows; ++rowIdx) {
+            const auto& row = fineMatrix[rowIdx];
+            auto& rowCoarse = (*coarseLevelMatrix_)[rowIdx];
+            auto entryCoarse = rowCoarse.begin();
+            for (auto entry = row.begin(), entryEnd = row.end(); entry != entryEnd; ++entry, ++entryCoarse) {
                 assert(entry.index() == entryCoarse.index());
                 double matrix_el = 0;
                 if (transpose) {
-                    auto bw = weights_[entry.index()];
-                    for (size_t i = 0; i < bw.size(); ++i) {
+                    const auto& bw = weights_[entry.index()];
+                    for (int i = 0; i < blockSize; ++i) {
                         matrix_el += (*entry)[pressure_var_index_][i] * bw[i];
                     }
                 } else {
-                    auto bw = weights_[row.index()];
-                    for (size_t i = 0; i < bw.size(); ++i) {
+                    const auto& bw = weights_[rowIdx];
+                    for (int i = 0; i < blockSize; ++i) {
                         matrix_el += (*entry)[i][pressure_var_index_] * bw[i];
                     }
                 }
                 (*entryCoarse) = matrix_el;
             }
         }
-        assert(rowCoarse == coarseLevelMatrix_->end());
     }
 
     virtual void moveToCoarseLevel(const typename ParentType::FineRangeType& fine) override
     {
-        // Set coarse vector to zero
-        this->rhs_ = 0;
-
-        auto end = fine.end(), begin = fine.begin();
-
-        for (auto block = begin; block != end; ++block) {
-            auto bw = weights_[block.index()];
+        const int size = fine.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int blockIdx = 0; blockIdx < size; ++blockIdx) {
+            const auto& block = fine[blockIdx];
             double rhs_el = 0.0;
             if (transpose) {
-                rhs_el = (*block)[pressure_var_index_];
+                rhs_el = block[pressure_var_index_];
             } else {
-                for (size_t i = 0; i < block->size(); ++i) {
-                    rhs_el += (*block)[i] * bw[i];
+                const auto& bw = weights_[blockIdx];
+                for (int i = 0; i < blockSize; ++i) {
+                    rhs_el += block[i] * bw[i];
                 }
             }
-            this->rhs_[block - begin] = rhs_el;
+            this->rhs_[blockIdx] = rhs_el;
         }
 
         this->lhs_ = 0;
@@ -126,16 +157,19 @@ public:
 
     virtual void moveToFineLevel(typename ParentType::FineDomainType& fine) override
     {
-        auto end = fine.end(), begin = fine.begin();
-
-        for (auto block = begin; block != end; ++block) {
+        const int size = fine.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int blockIdx = 0; blockIdx < size; ++blockIdx) {
+            auto& block = fine[blockIdx];
             if (transpose) {
-                auto bw = weights_[block.index()];
-                for (size_t i = 0; i < block->size(); ++i) {
-                    (*block)[i] = this->lhs_[block - begin] * bw[i];
+                const auto& bw = weights_[blockIdx];
+                for (int i = 0; i < blockSize; ++i) {
+                    block[i] = this->lhs_[blockIdx] * bw[i];
                 }
             } else {
-                (*block)[pressure_var_index_] = this->lhs_[block - begin];
+                block[pressure_var_index_] = this->lhs_[blockIdx];
             }
         }
     }
@@ -151,9 +185,27 @@ public:
     }
 
 private:
+    using CoarseMatrixType = typename CoarseOperator::matrix_type;
+    static_assert(std::is_same<CoarseMatrixType, PreconditionerSetupData::PressureMatrix>::value,
+                  "The pressure matrix is kept as a PreconditionerSetupData::PressureMatrix");
+    static constexpr int blockSize = FineVectorType::block_type::dimension;
+
+    void createCoarseOperator_()
+    {
+        using OperatorArgs = typename Dune::Amg::ConstructionTraits<CoarseOperator>::Arguments;
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 7)
+        OperatorArgs oargs(coarseLevelMatrix_, *coarseLevelCommunication_);
+        this->operator_ = Dune::Amg::ConstructionTraits<CoarseOperator>::construct(oargs);
+#else
+        OperatorArgs oargs(*coarseLevelMatrix_, *coarseLevelCommunication_);
+        this->operator_.reset(Dune::Amg::ConstructionTraits<CoarseOperator>::construct(oargs));
+#endif
+    }
+
     Communication* communication_;
     const FineVectorType& weights_;
     const int pressure_var_index_;
+    std::shared_ptr<PreconditionerSetupData> setupData_;
     std::shared_ptr<Communication> coarseLevelCommunication_;
     std::shared_ptr<typename CoarseOperator::matrix_type> coarseLevelMatrix_;
 };
@@ -0,0 +1,212 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_RECYCLEDKRYLOVSPACE_HEADER_INCLUDED
+#define OPM_RECYCLEDKRYLOVSPACE_HEADER_INCLUDED
+
+#include <dune/common/version.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioner.hh>
+#include <dune/istl/scalarproducts.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+/// \brief A small subspace recycled between consecutive linear solves.
+///
+/// The space W is spanned by the solutions of previous solves. Those are
+/// dominated by the slowly converging components, which change little from
+/// one Newton iteration (or short time step) to the next. Before a solve,
+/// update() computes C = A W for the current operator and orthonormalizes
+/// it, such that A W = C and C^T C = I still hold. project() then removes
+/// the part of a residual that lies in the range of C, and adds the
+/// corresponding correction W C^T r to the solution. This is done for the
+/// initial guess and, through DeflatedPreconditioner, in every
+/// preconditioner application.
+///
+/// At most maxSize solutions are stored. The memory needed is 2 * maxSize
+/// vectors, because the images C are kept as well.
+template <class X>
+class RecycledKrylovSpace
+{
+public:
+    using field_type = typename X::field_type;
+
+    explicit RecycledKrylovSpace(int maxSize = 0)
+        : maxSize_(maxSize)
+    {
+    }
+
+    void setMaxSize(int maxSize)
+    {
+        maxSize_ = maxSize;
+        while (static_cast<int>(solutions_.size()) > std::max(maxSize_, 0)) {
+            solutions_.erase(solutions_.begin());
+        }
+    }
+
+    int maxSize() const
+    {
+        return maxSize_;
+    }
+
+    /// True if no usable vectors are available for the current operator.
+    bool empty() const
+    {
+        return basis_.empty();
+    }
+
+    /// Number of vectors in the basis built by the last update().
+    std::size_t size() const
+    {
+        return basis_.size();
+    }
+
+    /// Build W and C = A W for the given operator. Stored solutions that
+    /// are (numerically) linearly dependent in the image are skipped.
+    template <class Operator, class ScalarProduct>
+    void update(const Operator& op, ScalarProduct& sp)
+    {
+        basis_.clear();
+        images_.clear();
+        for (const auto& solution : solutions_) {
+            X w(solution);
+            X c(solution);
+            op.apply(w, c);
+            const field_type norm0 = sp.norm(c);
+            if (!(norm0 > 0.0) || !std::isfinite(norm0)) {
+                continue;
+            }
+            // Modified Gram-Schmidt on C, applying the same operations to W.
+            for (std::size_t i = 0; i < images_.size(); ++i) {
+                const field_type h = sp.dot(images_[i], c);
+                c.axpy(-h, images_[i]);
+                w.axpy(-h, basis_[i]);
+            }
+            const field_type norm = sp.norm(c);
+            if (norm < dropTolerance * norm0) {
+                continue;
+            }
+            c *= 1.0 / norm;
+            w *= 1.0 / norm;
+            images_.push_back(std::move(c));
+            basis_.push_back(std::move(w));
+        }
+    }
+
+    /// Replace r by (I - C C^T) r and add the correction W C^T r to x.
+    template <class ScalarProduct>
+    void project(X& x, X& r, ScalarProduct& sp) const
+    {
+        for (std::size_t i = 0; i < images_.size(); ++i) {
+            const field_type h = sp.dot(images_[i], r);
+            r.axpy(-h, images_[i]);
+            x.axpy(h, basis_[i]);
+        }
+    }
+
+    /// Remember a solution for later solves, discarding the oldest stored
+    /// one if the space is full.
+    void add(const X& solution)
+    {
+        if (maxSize_ <= 0) {
+            return;
+        }
+        if (static_cast<int>(solutions_.size()) >= maxSize_) {
+            solutions_.erase(solutions_.begin());
+        }
+        solutions_.push_back(solution);
+    }
+
+    /// Forget all stored solutions, e.g. when the sparsity pattern changes.
+    void clear()
+    {
+        solutions_.clear();
+        basis_.clear();
+        images_.clear();
+    }
+
+private:
+    static constexpr double dropTolerance = 1e-8;
+
+    int maxSize_;
+    std::vector<X> solutions_;
+    std::vector<X> basis_;
+    std::vector<X> images_;
+};
+
+
+/// \brief Wraps a preconditioner M with the coarse correction of a
+/// RecycledKrylovSpace: v = W C^T d + M^{-1} (I - C C^T) d.
+template <class X, class ScalarProduct>
+class DeflatedPreconditioner : public Dune::Preconditioner<X, X>
+{
+public:
+    DeflatedPreconditioner(Dune::Preconditioner<X, X>& prec,
+                           const RecycledKrylovSpace<X>& space,
+                           ScalarProduct& sp)
+        : prec_(prec)
+        , space_(space)
+        , sp_(sp)
+    {
+    }
+
+    virtual void pre(X& x, X& b) override
+    {
+        prec_.pre(x, b);
+    }
+
+    virtual void apply(X& v, const X& d) override
+    {
+        X r(d);
+        v = 0.0;
+        space_.project(v, r, sp_);
+        X z(v);
+        z = 0.0;
+        prec_.apply(z, r);
+        v += z;
+    }
+
+    virtual void post(X& x) override
+    {
+        prec_.post(x);
+    }
+
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
+    virtual Dune::SolverCategory::Category category() const override
+    {
+        return prec_.category();
+    }
+#endif
+
+private:
+    Dune::Preconditioner<X, X>& prec_;
+    const RecycledKrylovSpace<X>& space_;
+    ScalarProduct& sp_;
+};
+
+} // namespace Opm
+
+#endif // OPM_RECYCLEDKRYLOVSPACE_HEADER_INCLUDED
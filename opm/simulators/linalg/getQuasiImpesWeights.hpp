@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <exception>
 
 namespace Opm
 {
@@ -50,27 +51,41 @@ namespace Amg
         const Matrix& A = matrix;
         VectorBlockType rhs(0.0);
         rhs[pressureVarIndex] = 1.0;
-        const auto endi = A.end();
-        for (auto i = A.begin(); i != endi; ++i) {
-            const auto endj = (*i).end();
+        const int numRows = A.N();
+        std::exception_ptr exceptionPtr;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int rowIdx = 0; rowIdx < numRows; ++rowIdx) {
+            const auto& row = A[rowIdx];
             MatrixBlockType diag_block(0.0);
-            for (auto j = (*i).begin(); j != endj; ++j) {
-                if (i.index() == j.index()) {
-                    diag_block = (*j);
-                    break;
-                }
+            const auto diag = row.find(rowIdx);
+            if (diag != row.end()) {
+                diag_block = *diag;
             }
-            VectorBlockType bweights;
-            if (transpose) {
-                diag_block.solve(bweights, rhs);
-            } else {
-                auto diag_block_transpose = Opm::Details::transposeDenseMatrix(diag_block);
-                diag_block_transpose.solve(bweights, rhs);
+            VectorBlockType bweights(0.0);
+            try {
+                if (transpose) {
+                    diag_block.solve(bweights, rhs);
+                } else {
+                    auto diag_block_transpose = Opm::Details::transposeDenseMatrix(diag_block);
+                    diag_block_transpose.solve(bweights, rhs);
+                }
+            } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                exceptionPtr = std::current_exception();
+                weights[rowIdx] = 0.0;
+                continue;
             }
             double abs_max = *std::max_element(
                 bweights.begin(), bweights.end(), [](double a, double b) { return std::fabs(a) < std::fabs(b); });
             bweights /= std::fabs(abs_max);
-            weights[i.index()] = bweights;
+            weights[rowIdx] = bweights;
+        }
+        if (exceptionPtr) {
+            std::rethrow_exception(exceptionPtr);
         }
         // return weights;
     }
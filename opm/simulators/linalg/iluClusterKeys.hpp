@@ -0,0 +1,56 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ILUCLUSTERKEYS_HEADER_INCLUDED
+#define OPM_ILUCLUSTERKEYS_HEADER_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Opm
+{
+namespace detail
+{
+
+    /// \brief Cluster keys of the cells for the reverse Cuthill-McKee ordering
+    ///
+    /// Cells of the same PVTNUM and SATNUM regions get the same key, such
+    /// that the ordering keeps them close together within each level.
+    /// \tparam The type of the problem, which provides the region indices.
+    /// \param problem The problem holding the regions of the cells.
+    /// \param numCells The number of cells, i.e. rows of the matrix.
+    template <class Problem>
+    std::vector<int> iluClusterKeys(const Problem& problem, const std::size_t numCells)
+    {
+        std::vector<int> keys(numCells);
+        int numSatRegions = 1;
+        for (std::size_t cell = 0; cell < numCells; ++cell) {
+            numSatRegions = std::max(numSatRegions, static_cast<int>(problem.satnumRegionIndex(cell)) + 1);
+        }
+        for (std::size_t cell = 0; cell < numCells; ++cell) {
+            keys[cell] = problem.pvtRegionIndex(cell) * numSatRegions + problem.satnumRegionIndex(cell);
+        }
+        return keys;
+    }
+
+} // namespace detail
+} // namespace Opm
+
+#endif // OPM_ILUCLUSTERKEYS_HEADER_INCLUDED
@@ -41,9 +41,14 @@ setupPropertyTree(const FlowLinearSolverParameters& p)
         prm.put("tol", p.linear_solver_reduction_);
         prm.put("maxiter", p.linear_solver_maxiter_);
         prm.put("verbosity", p.linear_solver_verbosity_);
-        prm.put("solver", "bicgstab");
+        prm.put("solver", p.use_fused_bicgstab_ ? "fusedbicgstab" : "bicgstab");
         prm.put("preconditioner.type", "ParOverILU0");
         prm.put("preconditioner.relaxation", 1.0);
+        prm.put("preconditioner.ilulevel", p.ilu_fillin_level_);
+        prm.put("preconditioner.redblack", p.ilu_redblack_);
+        prm.put("preconditioner.reorder_spheres", p.ilu_reorder_sphere_);
+        prm.put("preconditioner.reorder_rcm", p.ilu_reorder_rcm_);
+        prm.put("preconditioner.speculative_coloring", p.ilu_speculative_coloring_);
     }
     return prm;
 }
@@ -15,6 +15,7 @@
 #include<dune/istl/paamg/galerkin.hh>
 #include<dune/istl/solver.hh>
 
+#include<dune/common/timer.hh>
 #include<dune/common/unused.hh>
 #include<dune/common/version.hh>
 
@@ -30,6 +31,30 @@ namespace Dune
 namespace Amg
 {
 
+/**
+ * @brief Wall clock time spent in a two level method.
+ */
+struct TwoLevelMethodTimings
+{
+  /** @brief Time for creating or updating the coarse level system and solver. */
+  double setup = 0.0;
+  /** @brief Time for applying the preconditioner. */
+  double apply = 0.0;
+};
+
+/**
+ * @brief Interface of preconditioners that record TwoLevelMethodTimings.
+ */
+class TwoLevelMethodTimingsProvider
+{
+public:
+  virtual ~TwoLevelMethodTimingsProvider() = default;
+  /**
+   * @brief Get the times accumulated since the last call and reset them.
+   */
+  virtual TwoLevelMethodTimings takeTimings() = 0;
+};
+
 /**
  * @brief Abstract base class for transfer between levels and creation
  * of the coarse level system.
@@ -434,9 +459,11 @@ public:
     : operator_(&op), smoother_(smoother),
       preSteps_(preSteps), postSteps_(postSteps)
   {
+    Timer timer;
     policy_ = policy.clone();
     policy_->createCoarseLevelSystem(*operator_);
     coarseSolver_=coarsePolicy.createCoarseLevelSolver(*policy_);
+    timings_.setup += timer.elapsed();
   }
 
   TwoLevelMethodCpr(const TwoLevelMethodCpr& other)
@@ -463,6 +490,7 @@ public:
                             CoarseLevelSolverPolicy& coarsePolicy)
   {
     //assume new matrix is not reallocated the new precondition should anyway be made
+    Timer timer;
     smoother_ = smoother;
     if (coarseSolver_) {
       policy_->calculateCoarseEntries(*operator_);
@@ -473,6 +501,17 @@ public:
       policy_->createCoarseLevelSystem(*operator_);
       coarseSolver_ = coarsePolicy.createCoarseLevelSolver(*policy_);
     }
+    timings_.setup += timer.elapsed();
+  }
+
+  /**
+   * @brief Get the times accumulated since the last call and reset them.
+   */
+  TwoLevelMethodTimings takeTimings()
+  {
+    TwoLevelMethodTimings timings = timings_;
+    timings_ = TwoLevelMethodTimings();
+    return timings;
   }
 
   void pre(FineDomainType& x, FineRangeType& b)
@@ -487,6 +526,7 @@ public:
 
   void apply(FineDomainType& v, const FineRangeType& d)
   {
+    Timer timer;
     FineDomainType u(v);
     FineRangeType rhs(d);
     LevelContext context;
@@ -508,7 +548,7 @@ public:
     *context.update += *context.lhs;
     // Postsmoothing
     postsmooth(context, postSteps_);
-
+    timings_.apply += timer.elapsed();
   }
 #if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)  
 //   //! Category of the preconditioner (see SolverCategory::Category)
@@ -561,6 +601,8 @@ private:
   std::size_t preSteps_;
   /** @brief The number of postsmoothing steps to apply. */
   std::size_t postSteps_;
+  /** @brief The times spent in setup and apply since the last takeTimings(). */
+  TwoLevelMethodTimings timings_;
 };
 }// end namespace Amg
 }// end namespace Dune
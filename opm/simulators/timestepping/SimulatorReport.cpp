@@ -35,6 +35,8 @@ namespace Opm
           assemble_time(0.0),
 	  linear_solve_setup_time(0.0),
           linear_solve_time(0.0),
+          cpr_setup_time(0.0),
+          cpr_apply_time(0.0),
           update_time(0.0),
           output_write_time(0.0),
           total_well_iterations(0),
@@ -52,6 +54,8 @@ namespace Opm
         transport_time += sr.transport_time;
 	linear_solve_setup_time += sr.linear_solve_setup_time;
         linear_solve_time += sr.linear_solve_time;
+        cpr_setup_time += sr.cpr_setup_time;
+        cpr_apply_time += sr.cpr_apply_time;
         solver_time += sr.solver_time;
         assemble_time += sr.assemble_time;
         update_time += sr.update_time;
@@ -128,7 +132,25 @@ namespace Opm
 		     << 100*failureReport->linear_solve_setup_time/t << "%)";
                 }
                 os << std::endl;
-		
+
+                if (cpr_setup_time > 0.0 || cpr_apply_time > 0.0) {
+                    t = cpr_setup_time + (failureReport ? failureReport->cpr_setup_time : 0.0);
+                    os << "  CPR setup time (seconds):   " << t;
+                    if (failureReport) {
+                        os << " (Failed: " << failureReport->cpr_setup_time << "; "
+                           << 100*failureReport->cpr_setup_time/t << "%)";
+                    }
+                    os << std::endl;
+
+                    t = cpr_apply_time + (failureReport ? failureReport->cpr_apply_time : 0.0);
+                    os << "  CPR apply time (seconds):   " << t;
+                    if (failureReport) {
+                        os << " (Failed: " << failureReport->cpr_apply_time << "; "
+                           << 100*failureReport->cpr_apply_time/t << "%)";
+                    }
+                    os << std::endl;
+                }
+
                 t = update_time + (failureReport ? failureReport->update_time : 0.0);
                 os << " Update time (seconds):       " << t;
                 if (failureReport) {
@@ -35,6 +35,8 @@ namespace Opm
         double assemble_time;
         double linear_solve_setup_time;
         double linear_solve_time;
+        double cpr_setup_time;
+        double cpr_apply_time;
         double update_time;
         double output_write_time;
 
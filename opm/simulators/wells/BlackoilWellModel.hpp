@@ -32,6 +32,7 @@
 
 #include <cassert>
 #include <tuple>
+#include <unordered_map>
 
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Well/WellTestState.hpp>
@@ -45,6 +46,8 @@
 #include <opm/simulators/wells/WellStateFullyImplicitBlackoil.hpp>
 #include <opm/simulators/wells/RateConverter.hpp>
 #include <opm/simulators/wells/WellInterface.hpp>
+#include <opm/simulators/wells/WellSchurComplement.hpp>
+#include <opm/simulators/wells/ParallelWellLoop.hpp>
 #include <opm/simulators/wells/StandardWell.hpp>
 #include <opm/simulators/wells/MultisegmentWell.hpp>
 #include <opm/simulators/timestepping/gatherConvergenceReport.hpp>
@@ -225,6 +228,17 @@ namespace Opm {
                 }
             }
 
+            // return the cells perforated by each local well
+            std::vector<std::vector<int>> wellCells() const
+            {
+                std::vector<std::vector<int>> cells;
+                cells.reserve(well_container_.size());
+                for ( const auto& well: well_container_ ) {
+                    cells.push_back(well->cells());
+                }
+                return cells;
+            }
+
             // called at the beginning of a report step
             void beginReportStep(const int time_step);
 
@@ -245,6 +259,26 @@ namespace Opm {
             // a vector of all the wells.
             std::vector<WellInterfacePtr > well_container_;
 
+            // Index registry of the wells, so that well names are only
+            // resolved at the boundaries of the well model. Apart from the
+            // maps from names, all entries are indexed by the index of the
+            // well in the wells struct, -1 and nullptr mark missing entries.
+            std::unordered_map<std::string, int> well_ecl_index_by_name_;
+            std::unordered_map<std::string, int> well_index_by_name_;
+            std::vector<int> well_ecl_index_;
+            std::vector<WellNode*> well_nodes_;
+            std::vector<int> well_container_index_;
+
+            // rebuild the registry entries depending on the wells struct and
+            // the well collection, called when they are recreated
+            void updateWellIndices();
+
+            // rebuild the position of the wells in well_container_
+            void updateWellContainerIndex();
+
+            // the node of the well in the well collection
+            WellNode& wellNode(const int well_index) const;
+
             // map from logically cartesian cell indices to compressed ones
             std::vector<int> cartesian_to_compressed_;
 
@@ -257,6 +291,10 @@ namespace Opm {
 
             WellState well_state_;
             WellState previous_well_state_;
+            // scratch well state for the well potential calculation
+            WellState well_state_potentials_;
+            // saved well state values to roll back failed well iterations
+            WellState::Snapshot well_state_snapshot_;
 
             const ModelParameters param_;
             bool terminal_output_;
@@ -281,6 +319,12 @@ namespace Opm {
             // used to better efficiency of calcuation
             mutable BVector scaleAddRes_;
 
+            // coupling of the wells to the reservoir, used by apply(x, Ax)
+            // when param_.use_well_schur_complement_ is set, and the wells
+            // not contained in it
+            WellSchurComplement<Scalar, numEq> schur_complement_;
+            std::vector<int> wells_outside_schur_complement_;
+
             const Wells* wells() const { return wells_manager_->c_wells(); }
 
             const Grid& grid() const
@@ -355,6 +399,9 @@ namespace Opm {
 
             void assembleWellEq(const std::vector<Scalar>& B_avg, const double dt, Opm::DeferredLogger& deferred_logger);
 
+            // collect the linearized wells in schur_complement_
+            void assembleSchurComplement();
+
             // some preparation work, mostly related to group control and RESV,
             // at the beginning of each time step (Not report step)
             void prepareTimeStep(Opm::DeferredLogger& deferred_logger);
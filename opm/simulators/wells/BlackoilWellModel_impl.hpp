@@ -225,6 +225,8 @@ namespace Opm {
                                                 grid.comm().size() > 1,
                                                 defunct_well_names) );
 
+        updateWellIndices();
+
         // Wells are active if they are active wells on at least
         // one process.
         wells_active_ = localWellsActive() ? 1 : 0;
@@ -235,6 +237,7 @@ namespace Opm {
         size_t nc = number_of_cells_;
         std::vector<double> cellPressures(nc, 0.0);
         ElementContext elemCtx(ebosSimulator_);
+        const auto& elemMapper = ebosSimulator_.model().elementMapper();
         const auto& gridView = ebosSimulator_.vanguard().gridView();
         const auto& elemEndIt = gridView.template end</*codim=*/0>();
         for (auto elemIt = gridView.template begin</*codim=*/0>();
@@ -245,11 +248,16 @@ namespace Opm {
             if (elem.partitionType() != Dune::InteriorEntity) {
                 continue;
             }
-            elemCtx.updatePrimaryStencil(elem);
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
 
-            const unsigned cellIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-            const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
+            // only evaluate the intensive quantities if they are not cached anyway
+            const unsigned cellIdx = elemMapper.index(elem);
+            const auto* cachedIntQuants = ebosSimulator_.model().cachedIntensiveQuantities(cellIdx, /*timeIdx=*/0);
+            if (!cachedIntQuants) {
+                elemCtx.updatePrimaryStencil(elem);
+                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+            }
+            const auto& intQuants = cachedIntQuants ? *cachedIntQuants
+                : elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
             const auto& fs = intQuants.fluidState();
 
             const double p = fs.pressure(FluidSystem::oilPhaseIdx).value();
@@ -305,6 +313,7 @@ namespace Opm {
 
             // create the well container
             well_container_ = createWellContainer(reportStepIdx, wells(), /*allow_closing_opening_wells=*/true, local_deferredLogger);
+            updateWellContainerIndex();
 
             // do the initialization for all the wells
             // TODO: to see whether we can postpone of the intialization of the well containers to
@@ -360,23 +369,71 @@ namespace Opm {
             computeAverageFormationFactor(B_avg);
 
             const auto& wellsForTesting = wellTestState_.updateWells(wtest_config, wells_ecl_, simulationTime);
+
+            // The tests of each well run as one task, in the order they are
+            // listed. Wells that are not in the wells struct belong to
+            // other processes and are tested there.
+            std::vector<std::string> tested_wells;
+            std::vector<std::vector<WellTestConfig::Reason>> testing_reasons;
+            std::unordered_map<std::string, int> test_index_by_name;
             for (const auto& testWell : wellsForTesting) {
                 const std::string& well_name = testWell.first;
+                if (well_index_by_name_.find(well_name) == well_index_by_name_.end()) {
+                    continue;
+                }
+                const auto inserted = test_index_by_name.emplace(well_name, tested_wells.size());
+                if (inserted.second) {
+                    tested_wells.push_back(well_name);
+                    testing_reasons.emplace_back();
+                }
+                testing_reasons[inserted.first->second].push_back(testWell.second);
+            }
 
-                // this is the well we will test
-                WellInterfacePtr well = createWellForWellTest(well_name, timeStepIdx, deferred_logger);
-
-                // some preparation before the well can be used
-                well->init(&phase_usage_, depth_, gravity_, number_of_cells_);
-                const WellNode& well_node = wellCollection().findWellNode(well_name);
-                const double well_efficiency_factor = well_node.getAccumulativeEfficiencyFactor();
-                well->setWellEfficiencyFactor(well_efficiency_factor);
-                well->setVFPProperties(vfp_properties_.get());
-
-                const WellTestConfig::Reason testing_reason = testWell.second;
+            if (tested_wells.empty()) {
+                return;
+            }
 
-                well->wellTesting(ebosSimulator_, B_avg, simulationTime, timeStepIdx,
-                                  testing_reason, well_state_, wellTestState_, deferred_logger);
+            // The tests start from a copy of the well state and of the well
+            // test state each, so they can run concurrently. Every task
+            // writes only the values of its own well to well_state_, and the
+            // changes of the well test states are merged afterwards.
+            const WellState well_state_before_testing = well_state_;
+            std::vector<WellTestState> welltest_states(tested_wells.size());
+            parallelWellLoop(tested_wells.size(), deferred_logger,
+                             [&](const int i, Opm::DeferredLogger& well_logger) {
+                                 // this is the well we will test
+                                 WellInterfacePtr well = createWellForWellTest(tested_wells[i], timeStepIdx, well_logger);
+
+                                 // some preparation before the well can be used
+                                 well->init(&phase_usage_, depth_, gravity_, number_of_cells_);
+                                 const WellNode& well_node = wellNode(well->indexOfWell());
+                                 const double well_efficiency_factor = well_node.getAccumulativeEfficiencyFactor();
+                                 well->setWellEfficiencyFactor(well_efficiency_factor);
+                                 well->setVFPProperties(vfp_properties_.get());
+
+                                 WellState well_state = well_state_before_testing;
+                                 welltest_states[i] = wellTestState_;
+                                 for (const WellTestConfig::Reason testing_reason : testing_reasons[i]) {
+                                     well->wellTesting(ebosSimulator_, B_avg, simulationTime, timeStepIdx,
+                                                       testing_reason, well_state, welltest_states[i], well_logger);
+                                 }
+                                 well_state_.copyWellValues(well_state, well->indexOfWell());
+                             });
+
+            for (std::size_t i = 0; i < tested_wells.size(); ++i) {
+                const std::string& well_name = tested_wells[i];
+                const WellTestState& welltest_state = welltest_states[i];
+                for (const WellTestConfig::Reason testing_reason : testing_reasons[i]) {
+                    if (!welltest_state.hasWellClosed(well_name, testing_reason)) {
+                        wellTestState_.openWell(well_name, testing_reason);
+                    }
+                }
+                for (const auto& completion : getWellEcl(well_name).getCompletions()) {
+                    if (wellTestState_.hasCompletion(well_name, completion.first) &&
+                        !welltest_state.hasCompletion(well_name, completion.first)) {
+                        wellTestState_.dropCompletion(well_name, completion.first);
+                    }
+                }
             }
         }
     }
@@ -455,15 +512,82 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     well(const std::string& wellName) const
     {
-        for (const auto& well : well_container_) {
-            if (well->name() == wellName) {
-                return well;
-            }
+        const auto it = well_index_by_name_.find(wellName);
+        if (it != well_index_by_name_.end() && well_container_index_[it->second] >= 0) {
+            return well_container_[well_container_index_[it->second]];
         }
         OPM_THROW(std::invalid_argument, "The well with name " + wellName + " is not in the well Container");
         return nullptr;
     }
 
+
+
+
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    updateWellIndices()
+    {
+        well_ecl_index_by_name_.clear();
+        for (int index_well_ecl = 0; index_well_ecl < static_cast<int>(wells_ecl_.size()); ++index_well_ecl) {
+            well_ecl_index_by_name_[wells_ecl_[index_well_ecl].name()] = index_well_ecl;
+        }
+
+        const int nw = numWells();
+        well_index_by_name_.clear();
+        well_ecl_index_.assign(nw, -1);
+        for (int w = 0; w < nw; ++w) {
+            const std::string well_name(wells()->name[w]);
+            well_index_by_name_[well_name] = w;
+            const auto it = well_ecl_index_by_name_.find(well_name);
+            if (it != well_ecl_index_by_name_.end()) {
+                well_ecl_index_[w] = it->second;
+            }
+        }
+
+        well_nodes_.assign(nw, nullptr);
+        for (WellNode* well_node : wellCollection().getLeafNodes()) {
+            const auto it = well_index_by_name_.find(well_node->name());
+            if (it != well_index_by_name_.end()) {
+                well_nodes_[it->second] = well_node;
+            }
+        }
+
+        well_container_index_.assign(nw, -1);
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    updateWellContainerIndex()
+    {
+        std::fill(well_container_index_.begin(), well_container_index_.end(), -1);
+        for (int i = 0; i < static_cast<int>(well_container_.size()); ++i) {
+            well_container_index_[well_container_[i]->indexOfWell()] = i;
+        }
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    WellNode&
+    BlackoilWellModel<TypeTag>::
+    wellNode(const int well_index) const
+    {
+        WellNode* well_node = well_nodes_[well_index];
+        if (well_node == nullptr) {
+            OPM_THROW(std::runtime_error, "Could not find well " << wells()->name[well_index] << " in the well collection!\n");
+        }
+        return *well_node;
+    }
+
     template<typename TypeTag>
     void
     BlackoilWellModel<TypeTag>::
@@ -526,17 +650,11 @@ namespace Opm {
             for (int w = 0; w < nw; ++w) {
                 const std::string well_name = std::string(wells->name[w]);
 
-                // finding the location of the well in wells_ecl
-                const int nw_wells_ecl = wells_ecl_.size();
-                int index_well = 0;
-                for (; index_well < nw_wells_ecl; ++index_well) {
-                    if (well_name == wells_ecl_[index_well].name()) {
-                        break;
-                    }
-                }
+                // the location of the well in wells_ecl
+                const int index_well = well_ecl_index_[w];
 
                 // It should be able to find in wells_ecl.
-                if (index_well == nw_wells_ecl) {
+                if (index_well < 0) {
                     OPM_DEFLOG_THROW(std::runtime_error, "Could not find well " + well_name + " in wells_ecl ", deferred_logger);
                 }
 
@@ -589,10 +707,10 @@ namespace Opm {
 
                 if ( !well_ecl.isMultiSegment() || !param_.use_multisegment_well_) {
                     well_container.emplace_back(new StandardWell<TypeTag>(well_ecl, time_step, wells,
-                                                param_, *rateConverter_, pvtreg, numComponents() ) );
+                                                param_, *rateConverter_, pvtreg, numComponents(), w ) );
                 } else {
                     well_container.emplace_back(new MultisegmentWell<TypeTag>(well_ecl, time_step, wells,
-                                                param_, *rateConverter_, pvtreg, numComponents() ) );
+                                                param_, *rateConverter_, pvtreg, numComponents(), w ) );
                 }
             }
         }
@@ -612,33 +730,20 @@ namespace Opm {
                           Opm::DeferredLogger& deferred_logger) const
     {
         // Finding the location of the well in wells_ecl
-        const int nw_wells_ecl = wells_ecl_.size();
-        int index_well_ecl = 0;
-        for (; index_well_ecl < nw_wells_ecl; ++index_well_ecl) {
-          if (well_name == wells_ecl_[index_well_ecl].name()) {
-                break;
-            }
-        }
+        const auto well_ecl_it = well_ecl_index_by_name_.find(well_name);
         // It should be able to find in wells_ecl.
-        if (index_well_ecl == nw_wells_ecl) {
+        if (well_ecl_it == well_ecl_index_by_name_.end()) {
             OPM_DEFLOG_THROW(std::logic_error, "Could not find well " << well_name << " in wells_ecl ", deferred_logger);
         }
 
-        const Well2& well_ecl = wells_ecl_[index_well_ecl];
+        const Well2& well_ecl = wells_ecl_[well_ecl_it->second];
 
         // Finding the location of the well in wells struct.
-        const int nw = numWells();
-        int well_index_wells = -999;
-        for (int w = 0; w < nw; ++w) {
-            if (well_name == std::string(wells()->name[w])) {
-                well_index_wells = w;
-                break;
-            }
-        }
-
-        if (well_index_wells < 0) {
+        const auto well_it = well_index_by_name_.find(well_name);
+        if (well_it == well_index_by_name_.end()) {
             OPM_DEFLOG_THROW(std::logic_error, "Could not find the well  " << well_name << " in the well struct ", deferred_logger);
         }
+        const int well_index_wells = well_it->second;
 
         // Use the pvtRegionIdx from the top cell
         const int well_cell_top = wells()->well_cells[wells()->well_connpos[well_index_wells]];
@@ -646,10 +751,10 @@ namespace Opm {
 
         if ( !well_ecl.isMultiSegment() || !param_.use_multisegment_well_) {
              return WellInterfacePtr(new StandardWell<TypeTag>(well_ecl, report_step, wells(),
-                                                 param_, *rateConverter_, pvtreg, numComponents() ) );
+                                                 param_, *rateConverter_, pvtreg, numComponents(), well_index_wells ) );
         } else {
              return WellInterfacePtr(new MultisegmentWell<TypeTag>(well_ecl, report_step, wells(),
-                                                 param_, *rateConverter_, pvtreg, numComponents() ) );
+                                                 param_, *rateConverter_, pvtreg, numComponents(), well_index_wells ) );
         }
     }
 
@@ -707,6 +812,10 @@ namespace Opm {
 
             assembleWellEq(B_avg, dt, local_deferredLogger);
 
+            if (param_.use_well_schur_complement_) {
+                assembleSchurComplement();
+            }
+
         } catch (std::exception& e) {
             exception_thrown = 1;
         }
@@ -720,9 +829,25 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     assembleWellEq(const std::vector<Scalar>& B_avg, const double dt, Opm::DeferredLogger& deferred_logger)
     {
-        for (auto& well : well_container_) {
-            well->assembleWellEq(ebosSimulator_, B_avg, dt, well_state_, deferred_logger);
+        parallelWellLoop(well_container_.size(), deferred_logger,
+                         [&](const int w, Opm::DeferredLogger& well_logger) {
+                             well_container_[w]->assembleWellEq(ebosSimulator_, B_avg, dt, well_state_, well_logger);
+                         });
+    }
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    assembleSchurComplement()
+    {
+        schur_complement_.clear();
+        wells_outside_schur_complement_.clear();
+        for (int w = 0; w < static_cast<int>(well_container_.size()); ++w) {
+            if (!well_container_[w]->addToSchurComplement(schur_complement_)) {
+                wells_outside_schur_complement_.push_back(w);
+            }
         }
+        schur_complement_.finalize();
     }
 
     template<typename TypeTag>
@@ -751,6 +876,14 @@ namespace Opm {
             return;
         }
 
+        if (param_.use_well_schur_complement_) {
+            schur_complement_.apply(x, Ax);
+            for (const int w : wells_outside_schur_complement_) {
+                well_container_[w]->apply(x, Ax);
+            }
+            return;
+        }
+
         for (auto& well : well_container_) {
             well->apply(x, Ax);
         }
@@ -795,9 +928,10 @@ namespace Opm {
         int exception_thrown = 0;
         try {
             if (localWellsActive()) {
-                for (auto& well : well_container_) {
-                    well->recoverWellSolutionAndUpdateWellState(x, well_state_, local_deferredLogger);
-                }
+                parallelWellLoop(well_container_.size(), local_deferredLogger,
+                                 [&](const int w, Opm::DeferredLogger& well_logger) {
+                                     well_container_[w]->recoverWellSolutionAndUpdateWellState(x, well_state_, well_logger);
+                                 });
             }
         } catch (std::exception& e) {
             exception_thrown = 1;
@@ -878,7 +1012,8 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     solveWellEq(const std::vector<Scalar>& B_avg, const double dt, Opm::DeferredLogger& deferred_logger)
     {
-        WellState well_state0 = well_state_;
+        // only the values are saved, the wells do not change during the iterations
+        well_state_.saveSnapshot(well_state_snapshot_);
 
         const int max_iter = param_.max_welleq_iter_;
 
@@ -909,9 +1044,10 @@ namespace Opm {
             try {
                 if( localWellsActive() )
                 {
-                    for (auto& well : well_container_) {
-                        well->solveEqAndUpdateWellState(well_state_, deferred_logger);
-                    }
+                    parallelWellLoop(well_container_.size(), deferred_logger,
+                                     [&](const int w, Opm::DeferredLogger& well_logger) {
+                                         well_container_[w]->solveEqAndUpdateWellState(well_state_, well_logger);
+                                     });
                 }
                 // updateWellControls uses communication
                 // Therefore the following is executed if there
@@ -939,7 +1075,7 @@ namespace Opm {
                     deferred_logger.debug("Well equation solution failed in getting converged with " + std::to_string(it) + " iterations");
                 }
 
-                well_state_ = well_state0;
+                well_state_.restoreSnapshot(well_state_snapshot_);
                 updatePrimaryVariables(deferred_logger);
                 // also recover the old well controls
                 for (const auto& well : well_container_) {
@@ -1010,9 +1146,10 @@ namespace Opm {
     calculateExplicitQuantities(Opm::DeferredLogger& deferred_logger) const
     {
         // TODO: checking isOperable() ?
-        for (auto& well : well_container_) {
-            well->calculateExplicitQuantities(ebosSimulator_, well_state_, deferred_logger);
-        }
+        parallelWellLoop(well_container_.size(), deferred_logger,
+                         [&](const int w, Opm::DeferredLogger& well_logger) {
+                             well_container_[w]->calculateExplicitQuantities(ebosSimulator_, well_state_, well_logger);
+                         });
     }
 
 
@@ -1066,15 +1203,9 @@ namespace Opm {
         // number of wells and phases
         const int nw = numWells();
         const int np = numPhases();
-        well_potentials.resize(nw * np, 0.0);
-
+        well_potentials.assign(nw * np, 0.0);
 
         const int reportStepIdx = ebosSimulator_.episodeIndex();
-        const double invalid_alq = -1e100;
-        const double invalid_vfp = -2147483647;
-        auto well_state_copy = well_state_;
-        const Wells* local_wells = clone_wells(wells());
-        std::vector<WellInterfacePtr> well_container_copy = createWellContainer(reportStepIdx, local_wells, /*allow_closing_opening_wells=*/ false, deferred_logger);
 
         // average B factors are required for the convergence checking of well equations
         // Note: this must be done on all processes, even those with
@@ -1083,73 +1214,45 @@ namespace Opm {
         computeAverageFormationFactor(B_avg);
 
         const Opm::SummaryConfig& summaryConfig = ebosSimulator_.vanguard().summaryConfig();
-        const auto& summaryState = ebosSimulator_.vanguard().summaryState();
         const bool write_restart_file = ebosSimulator_.vanguard().eclState().getRestartConfig().getWriteRestartFile(reportStepIdx);
-        int exception_thrown = 0;
-        try {
-            for (const auto& well : well_container_copy) {
-                // Only compute the well potential when asked for
-                well->init(&phase_usage_, depth_, gravity_, number_of_cells_);
-
-                WellControls* wc = well->wellControls();
-                well_controls_clear(wc);
-                well_controls_assert_number_of_phases( wc , np);
-                if (well->wellType() == INJECTOR) {
-                    const auto controls = well->wellEcl()->injectionControls(summaryState);
-
-                    if (controls.hasControl(WellInjector::THP)) {
-                        const double thp_limit  = controls.thp_limit;
-                        const int    vfp_number = controls.vfp_table_number;
-                        well_controls_add_new(THP, thp_limit, invalid_alq, vfp_number, NULL, wc);
-                    }
-
-                    // we always have a bhp limit
-                    const double bhp_limit = controls.bhp_limit;
-                    well_controls_add_new(BHP, bhp_limit, invalid_alq, invalid_vfp, NULL, wc);
-                } else {
-                    const auto controls = well->wellEcl()->productionControls(summaryState);
-                    if (controls.hasControl(WellProducer::THP)) {
-                        const double thp_limit  = controls.thp_limit;
-                        const double alq_value  = controls.alq_value;
-                        const int    vfp_number = controls.vfp_table_number;
-                        well_controls_add_new(THP, thp_limit, alq_value, vfp_number, NULL, wc);
-                    }
-
-                    // we always have a bhp limit
-                    const double bhp_limit = controls.bhp_limit;
-                    well_controls_add_new(BHP, bhp_limit, invalid_alq, invalid_vfp, NULL, wc);
-
-                    well->setVFPProperties(vfp_properties_.get());
-
-                }
-
-                if (has_polymer_)
-                {
-                    const Grid& grid = ebosSimulator_.vanguard().grid();
-                    if (PolymerModule::hasPlyshlog() || GET_PROP_VALUE(TypeTag, EnablePolymerMW) ) {
-                        well->computeRepRadiusPerfLength(grid, cartesian_to_compressed_, deferred_logger);
-                    }
-                }
-
-
 
-                const bool needed_for_summary = ((summaryConfig.hasSummaryKey( "WWPI:" + well->name()) ||
-                                                  summaryConfig.hasSummaryKey( "WOPI:" + well->name()) ||
-                                                  summaryConfig.hasSummaryKey( "WGPI:" + well->name())) && well->wellType() == INJECTOR) ||
-                                                ((summaryConfig.hasSummaryKey( "WWPP:" + well->name()) ||
-                                                  summaryConfig.hasSummaryKey( "WOPP:" + well->name()) ||
-                                                  summaryConfig.hasSummaryKey( "WGPP:" + well->name())) && well->wellType() == PRODUCER);
+        // Only compute the well potential when asked for
+        std::vector<int> wells_needing_potentials;
+        for (int w = 0; w < static_cast<int>(well_container_.size()); ++w) {
+            const auto& well = well_container_[w];
+            const bool needed_for_summary = ((summaryConfig.hasSummaryKey( "WWPI:" + well->name()) ||
+                                              summaryConfig.hasSummaryKey( "WOPI:" + well->name()) ||
+                                              summaryConfig.hasSummaryKey( "WGPI:" + well->name())) && well->wellType() == INJECTOR) ||
+                                            ((summaryConfig.hasSummaryKey( "WWPP:" + well->name()) ||
+                                              summaryConfig.hasSummaryKey( "WOPP:" + well->name()) ||
+                                              summaryConfig.hasSummaryKey( "WGPP:" + well->name())) && well->wellType() == PRODUCER);
+
+            if (write_restart_file || needed_for_summary || wellCollection().requireWellPotentials()) {
+                wells_needing_potentials.push_back(w);
+            }
+        }
 
-                if (write_restart_file || needed_for_summary || wellCollection().requireWellPotentials())
-                {
-                    std::vector<double> potentials;
-                    well->computeWellPotentials(ebosSimulator_, B_avg, well_state_copy, potentials, deferred_logger);
-                    // putting the sucessfully calculated potentials to the well_potentials
-                    for (int p = 0; p < np; ++p) {
-                        well_potentials[well->indexOfWell() * np + p] = std::abs(potentials[p]);
-                    }
-                }
-            } // end of for (int w = 0; w < nw; ++w)
+        int exception_thrown = 0;
+        try {
+            if (!wells_needing_potentials.empty()) {
+                // the potential calculation iterates the well equations on a
+                // scratch copy of the well state, its storage is kept between calls
+                well_state_potentials_ = well_state_;
+
+                parallelWellLoop(wells_needing_potentials.size(), deferred_logger,
+                                 [&](const int i, Opm::DeferredLogger& well_logger) {
+                                     const auto& well = well_container_[wells_needing_potentials[i]];
+                                     std::vector<double> potentials;
+                                     well->computeWellPotentialsWithLimits(ebosSimulator_, B_avg, well_state_potentials_, potentials, well_logger);
+                                     // putting the sucessfully calculated potentials to the well_potentials
+                                     for (int p = 0; p < np; ++p) {
+                                         well_potentials[well->indexOfWell() * np + p] = std::abs(potentials[p]);
+                                     }
+                                     // the calculation leaves the primary variables and connection
+                                     // pressures of the scratch state in the well, restore them
+                                     well->calculateExplicitQuantities(ebosSimulator_, well_state_, well_logger);
+                                 });
+            }
         } catch (std::exception& e) {
             exception_thrown = 1;
         }
@@ -1237,7 +1340,7 @@ namespace Opm {
         if (wellCollection().groupControlActive()) {
             for (const auto& well : well_container_) {
                 WellControls* wc = well->wellControls();
-                WellNode& well_node = wellCollection().findWellNode(well->name());
+                WellNode& well_node = wellNode(well->indexOfWell());
 
                 // handling the situation that wells do not have a valid control
                 // it happens the well specified with GRUP and restarting due to non-convergencing
@@ -1322,8 +1425,7 @@ namespace Opm {
         }
 
         for (auto& well : well_container_) {
-            const std::string& well_name = well->name();
-            const WellNode& well_node = wellCollection().findWellNode(well_name);
+            const WellNode& well_node = wellNode(well->indexOfWell());
 
             const double well_efficiency_factor = well_node.getAccumulativeEfficiencyFactor();
 
@@ -1436,7 +1538,7 @@ namespace Opm {
            for (auto& well : well_container_) {
                 // update whether well is under group control
                 // get well node in the well collection
-                WellNode& well_node = wellCollection().findWellNode(well->name());
+                WellNode& well_node = wellNode(well->indexOfWell());
 
                 // update whehter the well is under group control or individual control
                 const int current = well_state_.currentControls()[well->indexOfWell()];
@@ -1656,9 +1758,6 @@ namespace Opm {
         }
 
         if (! resv_wells.empty()) {
-            typedef SimFIBODetails::WellMap WellMap;
-            const WellMap& wmap = SimFIBODetails::mapWells(wells_ecl_);
-
             for (std::vector<int>::const_iterator
                      rp = resv_wells.begin(), e = resv_wells.end();
                  rp != e; ++rp)
@@ -1694,12 +1793,12 @@ namespace Opm {
                         // for the WCONHIST wells, we need to calculate the RESV rates since it can not be specified directly
                         // for the WCONPROD wells, the rates are specified already, it is not necessary to update
                         if (is_producer) {
-                            const WellMap::const_iterator i = wmap.find(wells()->name[*rp]);
+                            const int index_well_ecl = well_ecl_index_[*rp];
 
-                            if (i == wmap.end()) {
-                                OPM_DEFLOG_THROW(std::logic_error, "Failed to find the well " << wells()->name[*rp] << " in wmap.", deferred_logger);
+                            if (index_well_ecl < 0) {
+                                OPM_DEFLOG_THROW(std::logic_error, "Failed to find the well " << wells()->name[*rp] << " in wells_ecl.", deferred_logger);
                             }
-                            const auto& wp = i->second;
+                            const auto& wp = wells_ecl_[index_well_ecl];
                             const auto production_controls = wp.productionControls(summaryState);
                             if ( !production_controls.prediction_mode ) {
                                 // historical phase rates
@@ -1848,16 +1947,12 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     getWellEcl(const std::string& well_name) const
     {
-        // finding the iterator of the well in wells_ecl
-        auto well_ecl = std::find_if(wells_ecl_.begin(),
-                                     wells_ecl_.end(),
-                                     [&well_name](const Well2& elem)->bool {
-                                         return elem.name() == well_name;
-                                     });
+        // finding the location of the well in wells_ecl
+        const auto well_ecl = well_ecl_index_by_name_.find(well_name);
 
-        assert(well_ecl != wells_ecl_.end());
+        assert(well_ecl != well_ecl_index_by_name_.end());
 
-        return *well_ecl;
+        return wells_ecl_[well_ecl->second];
     }
 
 } // namespace Opm
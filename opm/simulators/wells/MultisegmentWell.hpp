@@ -24,6 +24,7 @@
 
 
 #include <opm/simulators/wells/WellInterface.hpp>
+#include <opm/simulators/wells/SegmentTreeSolver.hpp>
 
 namespace Opm
 {
@@ -102,7 +103,8 @@ namespace Opm
                          const ModelParameters& param,
                          const RateConverterType& rate_converter,
                          const int pvtRegionIdx,
-                         const int num_components);
+                         const int num_components,
+                         const int index_of_well = -1);
 
         virtual void init(const PhaseUsage* phase_usage_arg,
                           const std::vector<double>& depth_arg,
@@ -140,7 +142,7 @@ namespace Opm
         /// computing the well potentials for group control
         virtual void computeWellPotentials(const Simulator& ebosSimulator,
                                            const std::vector<Scalar>& B_avg,
-                                           const WellState& well_state,
+                                           WellState& well_state,
                                            std::vector<double>& well_potentials,
                                            Opm::DeferredLogger& deferred_logger) override;
 
@@ -223,6 +225,8 @@ namespace Opm
         mutable OffDiagMatWell duneC_;
         // diagonal matrix for the well
         mutable DiagMatWell duneD_;
+        // factorization of duneD_, updated when the well equations are assembled
+        mutable SegmentTreeSolver<Scalar, numWellEq> segment_solver_;
 
         // residuals of the well equations
         mutable BVectorWell resWell_;
@@ -273,6 +277,10 @@ namespace Opm
         // xw = inv(D)*(rw - C*x)
         void recoverSolutionWell(const BVector& x, BVectorWell& xw) const;
 
+        // obtain D^-1 * rhs, with the factorization of segment_solver_ if it
+        // is valid and with UMFPack otherwise
+        BVectorWell solveD(const BVectorWell& rhs) const;
+
         // updating the well_state based on well solution dwells
         void updateWellState(const BVectorWell& dwells,
                              WellState& well_state,
@@ -335,6 +343,7 @@ namespace Opm
         void computeWellRatesWithBhpPotential(const Simulator& ebosSimulator,
                                               const std::vector<Scalar>& B_avg,
                                               const double& bhp,
+                                              WellState& well_state,
                                               std::vector<double>& well_flux,
                                               Opm::DeferredLogger& deferred_logger);
 
@@ -32,8 +32,9 @@ namespace Opm
                      const ModelParameters& param,
                      const RateConverterType& rate_converter,
                      const int pvtRegionIdx,
-                     const int num_components)
-    : Base(well, time_step, wells, param, rate_converter, pvtRegionIdx, num_components)
+                     const int num_components,
+                     const int index_of_well)
+    : Base(well, time_step, wells, param, rate_converter, pvtRegionIdx, num_components, index_of_well)
     , segment_perforations_(numberOfSegments())
     , segment_inlets_(numberOfSegments())
     , cell_perforation_depth_diffs_(number_of_perforations_, 0.0)
@@ -188,6 +189,17 @@ namespace Opm
             }
         }
 
+        {
+            std::vector<int> outlets(numberOfSegments(), -1);
+            for (int seg = 0; seg < numberOfSegments(); ++seg) {
+                const int outlet_segment_number = segmentSet()[seg].outletSegment();
+                if (outlet_segment_number > 0) {
+                    outlets[seg] = segmentNumberToIndex(outlet_segment_number);
+                }
+            }
+            segment_solver_.setStructure(outlets);
+        }
+
         // make the C matrix
         for (auto row = duneC_.createbegin(), end = duneC_.createend(); row != end; ++row) {
             // the number of the row corresponds to the segment number now.
@@ -498,7 +510,7 @@ namespace Opm
         duneB_.mv(x, Bx);
 
         // invDBx = duneD^-1 * Bx_
-        const BVectorWell invDBx = mswellhelpers::invDXDirect(duneD_, Bx);
+        const BVectorWell invDBx = solveD(Bx);
 
         // Ax = Ax - duneC_^T * invDBx
         duneC_.mmtv(invDBx,Ax);
@@ -514,7 +526,7 @@ namespace Opm
     apply(BVector& r) const
     {
         // invDrw_ = duneD^-1 * resWell_
-        const BVectorWell invDrw = mswellhelpers::invDXDirect(duneD_, resWell_);
+        const BVectorWell invDrw = solveD(resWell_);
         // r = r - duneC_^T * invDrw
         duneC_.mmtv(invDrw, r);
     }
@@ -544,7 +556,7 @@ namespace Opm
     MultisegmentWell<TypeTag>::
     computeWellPotentials(const Simulator& ebosSimulator,
                           const std::vector<Scalar>& B_avg,
-                          const WellState& well_state,
+                          WellState& well_state,
                           std::vector<double>& well_potentials,
                           Opm::DeferredLogger& deferred_logger)
     {
@@ -564,7 +576,7 @@ namespace Opm
         if ( !Base::wellHasTHPConstraints() ) {
             assert(std::abs(bhp) != std::numeric_limits<double>::max());
 
-            computeWellRatesWithBhpPotential(ebosSimulator, B_avg, bhp, well_potentials, deferred_logger);
+            computeWellRatesWithBhpPotential(ebosSimulator, B_avg, bhp, well_state, well_potentials, deferred_logger);
         } else {
 
             const std::string msg = std::string("Well potential calculation is not supported for thp controlled multisegment wells \n")
@@ -585,6 +597,7 @@ namespace Opm
     computeWellRatesWithBhpPotential(const Simulator& ebosSimulator,
                                      const std::vector<Scalar>& B_avg,
                                      const double& bhp,
+                                     WellState& well_state,
                                      std::vector<double>& well_flux,
                                      Opm::DeferredLogger& deferred_logger)
     {
@@ -597,14 +610,16 @@ namespace Opm
         well_controls_iset_target(wc, bhp_index, bhp);
         well_controls_set_current(wc, bhp_index);
 
-        // store a copy of the well state, we don't want to update the real well state
-        WellState copy = ebosSimulator.problem().wellModel().wellState();
+        // well_state is scratch space owned by the caller, the real well state is not touched.
+        // Every solve starts from the values of the real well state, not from the previous solve.
+        well_state.copyWellValues(ebosSimulator.problem().wellModel().wellState(), index_of_well_);
+        well_state.currentControls()[index_of_well_] = bhp_index;
 
         initPrimaryVariablesEvaluation();
 
         const double dt = ebosSimulator.timeStepSize();
         // iterate to get a solution that satisfies the bhp potential.
-        iterateWellEquations(ebosSimulator, B_avg, dt, copy, deferred_logger);
+        iterateWellEquations(ebosSimulator, B_avg, dt, well_state, deferred_logger);
 
         // compute the potential and store in the flux vector.
         const int np = number_of_phases_;
@@ -693,6 +708,25 @@ namespace Opm
 
 
 
+    template <typename TypeTag>
+    typename MultisegmentWell<TypeTag>::BVectorWell
+    MultisegmentWell<TypeTag>::
+    solveD(const BVectorWell& rhs) const
+    {
+        if (!segment_solver_.factorized()) {
+            // a singular pivot block in the tree elimination, let UMFPack
+            // pivot over the whole system instead
+            return mswellhelpers::invDXDirect(duneD_, rhs);
+        }
+        BVectorWell x(rhs.size());
+        segment_solver_.solve(rhs, x);
+        return x;
+    }
+
+
+
+
+
     template <typename TypeTag>
     void
     MultisegmentWell<TypeTag>::
@@ -702,7 +736,7 @@ namespace Opm
         // resWell = resWell - B * x
         duneB_.mmv(x, resWell);
         // xw = D^-1 * resWell
-        xw = mswellhelpers::invDXDirect(duneD_, resWell);
+        xw = solveD(resWell);
     }
 
 
@@ -716,7 +750,7 @@ namespace Opm
     {
         // We assemble the well equations, then we check the convergence,
         // which is why we do not put the assembleWellEq here.
-        const BVectorWell dx_well = mswellhelpers::invDXDirect(duneD_, resWell_);
+        const BVectorWell dx_well = solveD(resWell_);
 
         updateWellState(dx_well, well_state);
     }
@@ -1879,7 +1913,6 @@ namespace Opm
                          Opm::DeferredLogger& deferred_logger)
     {
         const int max_iter_number = param_.max_inner_iter_ms_wells_;
-        const WellState well_state0 = well_state;
         const std::vector<Scalar> residuals0 = getWellResiduals(B_avg);
         std::vector<std::vector<Scalar> > residual_history;
         std::vector<double> measure_history;
@@ -1891,7 +1924,7 @@ namespace Opm
 
             assembleWellEqWithoutIteration(ebosSimulator, dt, well_state, deferred_logger);
 
-            const BVectorWell dx_well = mswellhelpers::invDXDirect(duneD_, resWell_);
+            const BVectorWell dx_well = solveD(resWell_);
 
 
             const auto report = getWellConvergence(B_avg, deferred_logger);
@@ -2102,6 +2135,10 @@ namespace Opm
                 assemblePressureEq(seg);
             }
         }
+
+        // D only changes here, the factorization is used by all the
+        // following solves with it, including the ones of apply().
+        segment_solver_.factorize(duneD_);
     }
 
 
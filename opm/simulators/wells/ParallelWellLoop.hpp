@@ -0,0 +1,68 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARALLELWELLLOOP_HEADER_INCLUDED
+#define OPM_PARALLELWELLLOOP_HEADER_INCLUDED
+
+#include <opm/simulators/utils/DeferredLogger.hpp>
+
+#include <exception>
+#include <vector>
+
+namespace Opm
+{
+
+    /// Call func(w, logger) for w = 0, ..., numWells - 1, split over the
+    /// OpenMP threads. The calls must be independent of each other.
+    ///
+    /// Each well logs to its own DeferredLogger, and the messages are
+    /// appended to deferred_logger in well order afterwards, so the log
+    /// does not depend on the number of threads. If calls throw, all wells
+    /// are still processed, and the exception of the first failing well is
+    /// rethrown once the messages are merged.
+    template <class Func>
+    void parallelWellLoop(const int numWells, DeferredLogger& deferred_logger, Func&& func)
+    {
+        std::vector<DeferredLogger> loggers(numWells);
+        std::vector<std::exception_ptr> exceptions(numWells);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int w = 0; w < numWells; ++w) {
+            try {
+                func(w, loggers[w]);
+            } catch (...) {
+                exceptions[w] = std::current_exception();
+            }
+        }
+
+        for (const auto& logger : loggers) {
+            deferred_logger.append(logger);
+        }
+        for (const auto& exception : exceptions) {
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+    }
+
+} // namespace Opm
+
+#endif // OPM_PARALLELWELLLOOP_HEADER_INCLUDED
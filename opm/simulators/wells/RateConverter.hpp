@@ -452,6 +452,7 @@ namespace Opm {
                 }
 
                 ElementContext elemCtx( simulator );
+                const auto& elemMapper = simulator.model().elementMapper();
                 const auto& gridView = simulator.gridView();
                 const auto& comm = gridView.comm();
 
@@ -465,10 +466,16 @@ namespace Opm {
                     if (elem.partitionType() != Dune::InteriorEntity)
                         continue;
 
-                    elemCtx.updatePrimaryStencil(elem);
-                    elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                    const unsigned cellIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                    const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
+                    // avoid re-evaluating the intensive quantities if the model still
+                    // has them cached
+                    const unsigned cellIdx = elemMapper.index(elem);
+                    const auto* cachedIntQuants = simulator.model().cachedIntensiveQuantities(cellIdx, /*timeIdx=*/0);
+                    if (!cachedIntQuants) {
+                        elemCtx.updatePrimaryStencil(elem);
+                        elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                    }
+                    const auto& intQuants = cachedIntQuants ? *cachedIntQuants
+                        : elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
                     const auto& fs = intQuants.fluidState();
                     // use pore volume weighted averages.
                     const double pv_cell =
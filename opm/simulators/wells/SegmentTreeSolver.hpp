@@ -0,0 +1,196 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_SEGMENTTREESOLVER_HEADER_INCLUDED
+#define OPM_SEGMENTTREESOLVER_HEADER_INCLUDED
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace Opm
+{
+
+    /// Direct solver for the segment system D of a multisegment well.
+    ///
+    /// The segments form a tree where every segment but the top one has one
+    /// outlet segment, and D only couples a segment to its outlet and its
+    /// inlets. Eliminating the segments leaves first, i.e. every segment
+    /// before its outlet, gives an exact block LU factorization without any
+    /// fill-in. Pivoting is only done inside the diagonal blocks.
+    ///
+    /// The structure is set once per well with setStructure(), the
+    /// factorization is recomputed by factorize() whenever D changes and
+    /// can be used for any number of solves.
+    template <class Scalar, int n>
+    class SegmentTreeSolver
+    {
+    public:
+        using Block = Dune::FieldMatrix<Scalar, n, n>;
+        using VectorBlock = Dune::FieldVector<Scalar, n>;
+
+        /// Set the tree, outlet[seg] is the index of the outlet segment of
+        /// seg and negative for the top segment. Throws std::logic_error if
+        /// the segments do not form a tree.
+        void setStructure(const std::vector<int>& outlet)
+        {
+            const int numSeg = outlet.size();
+            outlet_ = outlet;
+            std::vector<std::vector<int>> inlets(numSeg);
+            int top = -1;
+            for (int seg = 0; seg < numSeg; ++seg) {
+                if (outlet[seg] < 0) {
+                    if (top >= 0) {
+                        throw std::logic_error("Multisegment well with more than one top segment");
+                    }
+                    top = seg;
+                } else {
+                    inlets[outlet[seg]].push_back(seg);
+                }
+            }
+
+            // Reverse of a breadth first ordering from the top segment, so
+            // that every segment comes before its outlet.
+            order_.clear();
+            order_.reserve(numSeg);
+            if (top >= 0) {
+                order_.push_back(top);
+            }
+            for (std::size_t i = 0; i < order_.size(); ++i) {
+                const auto& segInlets = inlets[order_[i]];
+                order_.insert(order_.end(), segInlets.begin(), segInlets.end());
+            }
+            if (static_cast<int>(order_.size()) != numSeg) {
+                throw std::logic_error("The segments of a multisegment well do not form a tree");
+            }
+            std::reverse(order_.begin(), order_.end());
+
+            invDiag_.resize(numSeg);
+            lower_.resize(numSeg);
+            upper_.resize(numSeg);
+            factorized_ = false;
+        }
+
+        /// Factorize D, which has to have the sparsity pattern of the tree.
+        /// Returns false if a pivot block is singular, the solver can then
+        /// not be used until the next successful factorization.
+        template <class Matrix>
+        bool factorize(const Matrix& D)
+        {
+            factorized_ = false;
+            const int numSeg = order_.size();
+            for (int seg = 0; seg < numSeg; ++seg) {
+                invDiag_[seg] = D[seg][seg];
+            }
+            try {
+                for (const int seg : order_) {
+                    // invDiag_ holds the Schur complement of the segment,
+                    // its inlets are eliminated already.
+                    invDiag_[seg].invert();
+                    if (!isFinite(invDiag_[seg])) {
+                        return false;
+                    }
+                    const int out = outlet_[seg];
+                    if (out < 0) {
+                        continue;
+                    }
+                    // lower_ = D(out, seg) S^-1, upper_ = S^-1 D(seg, out)
+                    lower_[seg] = D[out][seg];
+                    lower_[seg].rightmultiply(invDiag_[seg]);
+                    upper_[seg] = invDiag_[seg];
+                    upper_[seg].rightmultiply(D[seg][out]);
+                    // S(out) -= D(out, seg) S^-1 D(seg, out)
+                    Block update = lower_[seg];
+                    update.rightmultiply(D[seg][out]);
+                    invDiag_[out] -= update;
+                }
+            } catch (const Dune::FMatrixError&) {
+                return false;
+            }
+            factorized_ = true;
+            return true;
+        }
+
+        bool factorized() const
+        {
+            return factorized_;
+        }
+
+        /// Solve D x = b with the last factorization.
+        template <class Vector>
+        void solve(const Vector& b, Vector& x) const
+        {
+            if (!factorized_) {
+                throw std::logic_error("SegmentTreeSolver::solve() without a valid factorization");
+            }
+            // Forward elimination from the leaves, y is stored in x.
+            x = b;
+            for (const int seg : order_) {
+                const int out = outlet_[seg];
+                if (out >= 0) {
+                    lower_[seg].mmv(x[seg], x[out]);
+                }
+            }
+            // Back substitution from the top segment.
+            VectorBlock tmp;
+            for (auto it = order_.rbegin(); it != order_.rend(); ++it) {
+                const int seg = *it;
+                invDiag_[seg].mv(x[seg], tmp);
+                const int out = outlet_[seg];
+                if (out >= 0) {
+                    upper_[seg].mmv(x[out], tmp);
+                }
+                x[seg] = tmp;
+            }
+        }
+
+    private:
+        static bool isFinite(const Block& block)
+        {
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    if (!std::isfinite(block[i][j])) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // outlet of each segment, and the elimination order
+        std::vector<int> outlet_;
+        std::vector<int> order_;
+
+        // per segment: inverse of the Schur complement of the diagonal
+        // block, D(out, seg) S^-1 and S^-1 D(seg, out)
+        std::vector<Block> invDiag_;
+        std::vector<Block> lower_;
+        std::vector<Block> upper_;
+
+        bool factorized_ = false;
+    };
+
+} // namespace Opm
+
+#endif // OPM_SEGMENTTREESOLVER_HEADER_INCLUDED
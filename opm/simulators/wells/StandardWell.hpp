@@ -33,9 +33,17 @@
 #include <ewoms/models/blackoil/blackoilfoammodules.hh>
 
 #include <opm/material/densead/DynamicEvaluation.hpp>
+#include <opm/material/densead/Evaluation.hpp>
 
 #include <dune/common/dynvector.hh>
 #include <dune/common/dynmatrix.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <type_traits>
 
 namespace Opm
 {
@@ -118,19 +126,33 @@ namespace Opm
         //[A C^T    [x       =  [ res
         // B  D ]   x_well]      res_well]
 
+        // With polymer molecular weight injectors the number of well equations depends
+        // on the number of perforations and is only known at run time. Otherwise it is
+        // always numStaticWellEq, and the blocks and evaluations below have sizes fixed
+        // at compile time, which keeps them off the heap.
+        static const bool has_dynamic_well_eq = Base::has_polymermw;
+
         // the vector type for the res_well and x_well
-        typedef Dune::DynamicVector<Scalar> VectorBlockWellType;
+        typedef typename std::conditional<has_dynamic_well_eq,
+                                          Dune::DynamicVector<Scalar>,
+                                          Dune::FieldVector<Scalar, numStaticWellEq> >::type VectorBlockWellType;
         typedef Dune::BlockVector<VectorBlockWellType> BVectorWell;
 
         // the matrix type for the diagonal matrix D
-        typedef Dune::DynamicMatrix<Scalar> DiagMatrixBlockWellType;
+        typedef typename std::conditional<has_dynamic_well_eq,
+                                          Dune::DynamicMatrix<Scalar>,
+                                          Dune::FieldMatrix<Scalar, numStaticWellEq, numStaticWellEq> >::type DiagMatrixBlockWellType;
         typedef Dune::BCRSMatrix <DiagMatrixBlockWellType> DiagMatWell;
 
         // the matrix type for the non-diagonal matrix B and C^T
-        typedef Dune::DynamicMatrix<Scalar> OffDiagMatrixBlockWellType;
+        typedef typename std::conditional<has_dynamic_well_eq,
+                                          Dune::DynamicMatrix<Scalar>,
+                                          Dune::FieldMatrix<Scalar, numStaticWellEq, numEq> >::type OffDiagMatrixBlockWellType;
         typedef Dune::BCRSMatrix<OffDiagMatrixBlockWellType> OffDiagMatWell;
 
-        typedef DenseAd::DynamicEvaluation<Scalar, numStaticWellEq + numEq + 1> EvalWell;
+        typedef typename std::conditional<has_dynamic_well_eq,
+                                          DenseAd::DynamicEvaluation<Scalar, numStaticWellEq + numEq + 1>,
+                                          DenseAd::Evaluation<Scalar, numStaticWellEq + numEq> >::type EvalWell;
 
         using Base::contiSolventEqIdx;
         using Base::contiPolymerEqIdx;
@@ -141,7 +163,8 @@ namespace Opm
                      const ModelParameters& param,
                      const RateConverterType& rate_converter,
                      const int pvtRegionIdx,
-                     const int num_components);
+                     const int num_components,
+                     const int index_of_well = -1);
 
         virtual void init(const PhaseUsage* phase_usage_arg,
                           const std::vector<double>& depth_arg,
@@ -179,7 +202,7 @@ namespace Opm
         /// computing the well potentials for group control
         virtual void computeWellPotentials(const Simulator& ebosSimulator,
                                            const std::vector<Scalar>& B_avg,
-                                           const WellState& well_state,
+                                           WellState& well_state,
                                            std::vector<double>& well_potentials,
                                            Opm::DeferredLogger& deferred_logger) /* const */ override;
 
@@ -193,6 +216,8 @@ namespace Opm
 
         virtual void  addWellContributions(Mat& mat) const override;
 
+        virtual bool addToSchurComplement(WellSchurComplement<Scalar, numEq>& op) const override;
+
         /// \brief Wether the Jacobian will also have well contributions in it.
         virtual bool jacobianContainsWellContributions() const override
         {
@@ -279,6 +304,9 @@ namespace Opm
         mutable std::vector<double> ipr_a_;
         mutable std::vector<double> ipr_b_;
 
+        // the VFP lift curve at the THP limit last used with the IPR above
+        mutable VFPProdProperties::LiftCurve thp_lift_curve_;
+
         const EvalWell& getBhp() const;
 
         EvalWell getQs(const int comp_idx) const;
@@ -293,6 +321,58 @@ namespace Opm
 
         EvalWell extendEval(const Eval& in) const;
 
+        // an EvalWell with the given value and zero derivatives
+        EvalWell makeEvalWell(const Scalar value) const
+        {
+            return makeEvalWell(value, std::integral_constant<bool, has_dynamic_well_eq>());
+        }
+
+        EvalWell makeEvalWell(const Scalar value, std::true_type) const
+        {
+            return EvalWell(numWellEq_ + numEq, value);
+        }
+
+        EvalWell makeEvalWell(const Scalar value, std::false_type) const
+        {
+            return EvalWell(value);
+        }
+
+        EvalWell makeEvalWellVariable(const Scalar value, const int varPos, std::true_type) const
+        {
+            return EvalWell::createVariable(numWellEq_ + numEq, value, varPos);
+        }
+
+        EvalWell makeEvalWellVariable(const Scalar value, const int varPos, std::false_type) const
+        {
+            return EvalWell::createVariable(value, varPos);
+        }
+
+        // only the run-time sized blocks need to be resized
+        static void resizeBlock(Dune::DynamicVector<Scalar>& block, const int size)
+        {
+            block.resize(size);
+        }
+
+        template <int n>
+        static void resizeBlock(Dune::FieldVector<Scalar, n>& /* block */, const int size)
+        {
+            assert(size == n);
+            static_cast<void>(size);
+        }
+
+        static void resizeBlock(Dune::DynamicMatrix<Scalar>& block, const int rows, const int cols)
+        {
+            block.resize(rows, cols);
+        }
+
+        template <int n, int m>
+        static void resizeBlock(Dune::FieldMatrix<Scalar, n, m>& /* block */, const int rows, const int cols)
+        {
+            assert(rows == n && cols == m);
+            static_cast<void>(rows);
+            static_cast<void>(cols);
+        }
+
         // xw = inv(D)*(rw - C*x)
         void recoverSolutionWell(const BVector& x, BVectorWell& xw) const;
 
@@ -348,15 +428,24 @@ namespace Opm
                                              std::vector<double>& well_flux,
                                              Opm::DeferredLogger& deferred_logger) const;
 
+        // computeWellPotentials() without keeping the IPR of the well
+        void computeWellPotentialsImpl(const Simulator& ebosSimulator,
+                                       const std::vector<Scalar>& B_avg,
+                                       WellState& well_state,
+                                       std::vector<double>& well_potentials,
+                                       Opm::DeferredLogger& deferred_logger);
+
         void computeWellRatesWithBhpPotential(const Simulator& ebosSimulator,
                                               const std::vector<Scalar>& B_avg,
                                               const double& bhp,
+                                              WellState& well_state,
                                               std::vector<double>& well_flux,
                                               Opm::DeferredLogger& deferred_logger);
 
         std::vector<double> computeWellPotentialWithTHP(const Simulator& ebosSimulator,
                                                         const std::vector<Scalar>& B_avg,
                                                         const double initial_bhp, // bhp from BHP constraints
+                                                        WellState& well_state,
                                                         const std::vector<double>& initial_potential,
                                                         Opm::DeferredLogger& deferred_logger);
 
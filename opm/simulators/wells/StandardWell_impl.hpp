@@ -30,8 +30,9 @@ namespace Opm
                  const ModelParameters& param,
                  const RateConverterType& rate_converter,
                  const int pvtRegionIdx,
-                 const int num_components)
-    : Base(well, time_step, wells, param, rate_converter, pvtRegionIdx, num_components)
+                 const int num_components,
+                 const int index_of_well)
+    : Base(well, time_step, wells, param, rate_converter, pvtRegionIdx, num_components, index_of_well)
     , perf_densities_(number_of_perforations_)
     , perf_pressure_diffs_(number_of_perforations_)
     , F0_(numWellConservationEq)
@@ -75,7 +76,7 @@ namespace Opm
 
         // with the updated numWellEq_, we can initialize the primary variables and matrices now
         primary_variables_.resize(numWellEq_, 0.0);
-        primary_variables_evaluation_.resize(numWellEq_, EvalWell{numWellEq_ + numEq, 0.0});
+        primary_variables_evaluation_.resize(numWellEq_, makeEvalWell(0.0));
 
         // setup sparsity pattern for the matrices
         //[A C^T    [x    =  [ res
@@ -89,8 +90,8 @@ namespace Opm
             // Add nonzeros for diagonal
             row.insert(row.index());
         }
-        // the block size is run-time determined now
-        invDuneD_[0][0].resize(numWellEq_, numWellEq_);
+        // the block size is only run-time determined with the dynamic well equations
+        resizeBlock(invDuneD_[0][0], numWellEq_, numWellEq_);
 
         for (auto row = duneB_.createbegin(), end = duneB_.createend(); row!=end; ++row) {
             for (int perf = 0 ; perf < number_of_perforations_; ++perf) {
@@ -101,8 +102,8 @@ namespace Opm
 
         for (int perf = 0 ; perf < number_of_perforations_; ++perf) {
             const int cell_idx = well_cells_[perf];
-             // the block size is run-time determined now
-             duneB_[0][cell_idx].resize(numWellEq_, numEq);
+             // the block size is only run-time determined with the dynamic well equations
+             resizeBlock(duneB_[0][cell_idx], numWellEq_, numEq);
         }
 
         // make the C^T matrix
@@ -115,22 +116,22 @@ namespace Opm
 
         for (int perf = 0; perf < number_of_perforations_; ++perf) {
             const int cell_idx = well_cells_[perf];
-            duneC_[0][cell_idx].resize(numWellEq_, numEq);
+            resizeBlock(duneC_[0][cell_idx], numWellEq_, numEq);
         }
 
         resWell_.resize(1);
-        // the block size of resWell_ is also run-time determined now
-        resWell_[0].resize(numWellEq_);
+        // the block size of resWell_ is also only run-time determined with the dynamic well equations
+        resizeBlock(resWell_[0], numWellEq_);
 
         // resize temporary class variables
         Bx_.resize( duneB_.N() );
         for (unsigned i = 0; i < duneB_.N(); ++i) {
-            Bx_[i].resize(numWellEq_);
+            resizeBlock(Bx_[i], numWellEq_);
         }
 
         invDrw_.resize( invDuneD_.N() );
         for (unsigned i = 0; i < invDuneD_.N(); ++i) {
-            invDrw_[i].resize(numWellEq_);
+            resizeBlock(invDrw_[i], numWellEq_);
         }
     }
 
@@ -144,7 +145,8 @@ namespace Opm
     {
         for (int eqIdx = 0; eqIdx < numWellEq_; ++eqIdx) {
             primary_variables_evaluation_[eqIdx] =
-                EvalWell::createVariable(numWellEq_ + numEq, primary_variables_[eqIdx], numEq + eqIdx);
+                makeEvalWellVariable(primary_variables_[eqIdx], numEq + eqIdx,
+                                     std::integral_constant<bool, has_dynamic_well_eq>());
         }
     }
 
@@ -250,7 +252,7 @@ namespace Opm
         }
 
         // Oil fraction
-        EvalWell well_fraction(numWellEq_ + numEq, 1.0);
+        EvalWell well_fraction = makeEvalWell(1.0);
         if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
             well_fraction -= primary_variables_evaluation_[WFrac];
         }
@@ -274,7 +276,7 @@ namespace Opm
     wellSurfaceVolumeFraction(const int compIdx) const
     {
 
-        EvalWell sum_volume_fraction_scaled(numWellEq_ + numEq, 0.);
+        EvalWell sum_volume_fraction_scaled = makeEvalWell(0.);
         for (int idx = 0; idx < num_components_; ++idx) {
             sum_volume_fraction_scaled += wellVolumeFractionScaled(idx);
         }
@@ -293,7 +295,7 @@ namespace Opm
     StandardWell<TypeTag>::
     extendEval(const Eval& in) const
     {
-        EvalWell out(numWellEq_ + numEq, in.value());
+        EvalWell out = makeEvalWell(in.value());
         for(int eqIdx = 0; eqIdx < numEq;++eqIdx) {
             out.setDerivative(eqIdx, in.derivative(eqIdx));
         }
@@ -323,7 +325,8 @@ namespace Opm
         const EvalWell pressure = extendEval(fs.pressure(FluidSystem::oilPhaseIdx));
         const EvalWell rs = extendEval(fs.Rs());
         const EvalWell rv = extendEval(fs.Rv());
-        std::vector<EvalWell> b_perfcells_dense(num_components_, EvalWell{numWellEq_ + numEq, 0.0});
+        std::array<EvalWell, numWellConservationEq> b_perfcells_dense;
+        b_perfcells_dense.fill(makeEvalWell(0.0));
         for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
             if (!FluidSystem::phaseIsActive(phaseIdx)) {
                 continue;
@@ -393,13 +396,13 @@ namespace Opm
             const EvalWell cqt_i = - Tw * (total_mob_dense * drawdown);
 
             // surface volume fraction of fluids within wellbore
-            std::vector<EvalWell> cmix_s(num_components_, EvalWell{numWellEq_ + numEq});
+            std::array<EvalWell, numWellConservationEq> cmix_s;
             for (int componentIdx = 0; componentIdx < num_components_; ++componentIdx) {
                 cmix_s[componentIdx] = wellSurfaceVolumeFraction(componentIdx);
             }
 
             // compute volume ratio between connection at standard conditions
-            EvalWell volumeRatio(numWellEq_ + numEq, 0.);
+            EvalWell volumeRatio = makeEvalWell(0.);
             if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
                 const unsigned waterCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::waterCompIdx);
                 volumeRatio += cmix_s[waterCompIdx] / b_perfcells_dense[waterCompIdx];
@@ -413,7 +416,7 @@ namespace Opm
                 const unsigned oilCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::oilCompIdx);
                 const unsigned gasCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::gasCompIdx);
                 // Incorporate RS/RV factors if both oil and gas active
-                const EvalWell d = EvalWell(numWellEq_ + numEq, 1.0) - rv * rs;
+                const EvalWell d = makeEvalWell(1.0) - rv * rs;
 
                 if (d.value() == 0.0) {
                     OPM_DEFLOG_THROW(Opm::NumericalIssue, "Zero d value obtained for well " << name() << " during flux calcuation"
@@ -513,14 +516,17 @@ namespace Opm
             well_state.productivityIndex()[np*index_of_well_ + p] = 0.;
         }
 
+        const EvalWell zero = makeEvalWell(0.);
+        std::vector<EvalWell> mob(num_components_, zero);
+        std::vector<EvalWell> cq_s(num_components_, zero);
         for (int perf = 0; perf < number_of_perforations_; ++perf) {
 
             const int cell_idx = well_cells_[perf];
             const auto& intQuants = *(ebosSimulator.model().cachedIntensiveQuantities(cell_idx, /*timeIdx=*/ 0));
-            std::vector<EvalWell> mob(num_components_, {numWellEq_ + numEq, 0.});
+            std::fill(mob.begin(), mob.end(), zero);
             getMobility(ebosSimulator, perf, mob, deferred_logger);
 
-            std::vector<EvalWell> cq_s(num_components_, {numWellEq_ + numEq, 0.});
+            std::fill(cq_s.begin(), cq_s.end(), zero);
             double perf_dis_gas_rate = 0.;
             double perf_vap_oil_rate = 0.;
             double trans_mult = ebosSimulator.problem().template rockCompTransMultiplier<double>(intQuants,  cell_idx);
@@ -580,7 +586,7 @@ namespace Opm
 
                     const unsigned activeCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
                     // convert to reservoar conditions
-                    EvalWell cq_r_thermal(numWellEq_ + numEq, 0.);
+                    EvalWell cq_r_thermal = makeEvalWell(0.);
                     if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx) && FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
 
                         if(FluidSystem::waterPhaseIdx == phaseIdx)
@@ -712,11 +718,11 @@ namespace Opm
     StandardWell<TypeTag>::
     assembleControlEq(Opm::DeferredLogger& deferred_logger)
     {
-        EvalWell control_eq(numWellEq_ + numEq, 0.);
+        EvalWell control_eq = makeEvalWell(0.);
         switch (well_controls_get_current_type(well_controls_)) {
             case THP:
             {
-                std::vector<EvalWell> rates(3, {numWellEq_ + numEq, 0.});
+                std::vector<EvalWell> rates(3, makeEvalWell(0.));
                 if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
                     rates[ Water ] = getQs(flowPhaseToEbosCompIdx(Water));
                 }
@@ -743,7 +749,7 @@ namespace Opm
                     control_eq = getWQTotal() - target_rate;
                 } else if (well_type_ == PRODUCER) {
                     if (target_rate != 0.) {
-                        EvalWell rate_for_control(numWellEq_ + numEq, 0.);
+                        EvalWell rate_for_control = makeEvalWell(0.);
                         const EvalWell& g_total = getWQTotal();
                         // a variable to check if we are producing any targeting fluids
                         double sum_fraction = 0.;
@@ -792,7 +798,7 @@ namespace Opm
                     }
                 } else {
                     const EvalWell& g_total = getWQTotal();
-                    EvalWell rate_for_control(numWellEq_ + numEq, 0.); // reservoir rate
+                    EvalWell rate_for_control = makeEvalWell(0.); // reservoir rate
                     for (int phase = 0; phase < number_of_phases_; ++phase) {
                         rate_for_control += g_total * wellVolumeFraction( flowPhaseToEbosCompIdx(phase) );
                     }
@@ -1315,7 +1321,7 @@ namespace Opm
         std::fill(ipr_b_.begin(), ipr_b_.end(), 0.);
 
         for (int perf = 0; perf < number_of_perforations_; ++perf) {
-            std::vector<EvalWell> mob(num_components_, {numWellEq_ + numEq, 0.0});
+            std::vector<EvalWell> mob(num_components_, makeEvalWell(0.0));
             // TODO: mabye we should store the mobility somewhere, so that we only need to calculate it one per iteration
             getMobility(ebos_simulator, perf, mob, deferred_logger);
 
@@ -1709,7 +1715,7 @@ namespace Opm
         const double  bhp_limit = mostStrictBhpFromBhpLimits(deferred_logger);
 
         const double obtain_bhp = vfp_properties_->getProd()->calculateBhpWithTHPTarget(ipr_a_, ipr_b_,
-                                             bhp_limit, thp_table_id, thp_target, alq, dp);
+                                             bhp_limit, thp_table_id, thp_target, alq, dp, thp_lift_curve_);
 
         return obtain_bhp;
     }
@@ -2101,7 +2107,7 @@ namespace Opm
         // We assemble the well equations, then we check the convergence,
         // which is why we do not put the assembleWellEq here.
         BVectorWell dx_well(1);
-        dx_well[0].resize(numWellEq_);
+        resizeBlock(dx_well[0], numWellEq_);
         invDuneD_.mv(resWell_, dx_well);
 
         updateWellState(dx_well, well_state, deferred_logger);
@@ -2219,7 +2225,7 @@ namespace Opm
         if (!this->isOperable()) return;
 
         BVectorWell xw(1);
-        xw[0].resize(numWellEq_);
+        resizeBlock(xw[0], numWellEq_);
 
         recoverSolutionWell(x, xw);
         updateWellState(xw, well_state, deferred_logger);
@@ -2246,15 +2252,15 @@ namespace Opm
             const int cell_idx = well_cells_[perf];
             const auto& intQuants = *(ebosSimulator.model().cachedIntensiveQuantities(cell_idx, /*timeIdx=*/ 0));
             // flux for each perforation
-            std::vector<EvalWell> mob(num_components_, {numWellEq_ + numEq, 0.});
+            std::vector<EvalWell> mob(num_components_, makeEvalWell(0.));
             getMobility(ebosSimulator, perf, mob, deferred_logger);
             double trans_mult = ebosSimulator.problem().template rockCompTransMultiplier<double>(intQuants, cell_idx);
             const double Tw = well_index_[perf] * trans_mult;
 
-            std::vector<EvalWell> cq_s(num_components_, {numWellEq_ + numEq, 0.});
+            std::vector<EvalWell> cq_s(num_components_, makeEvalWell(0.));
             double perf_dis_gas_rate = 0.;
             double perf_vap_oil_rate = 0.;
-            computePerfRate(intQuants, mob, EvalWell(numWellEq_ + numEq, bhp), Tw, perf, allow_cf,
+            computePerfRate(intQuants, mob, makeEvalWell(bhp), Tw, perf, allow_cf,
                             cq_s, perf_dis_gas_rate, perf_vap_oil_rate, deferred_logger);
 
             for(int p = 0; p < np; ++p) {
@@ -2271,6 +2277,7 @@ namespace Opm
     computeWellRatesWithBhpPotential(const Simulator& ebosSimulator,
                             const std::vector<Scalar>& B_avg,
                             const double& bhp,
+                            WellState& well_state,
                             std::vector<double>& well_flux,
                             Opm::DeferredLogger& deferred_logger)
     {
@@ -2284,12 +2291,12 @@ namespace Opm
         well_controls_set_current(wc, bhp_index);
 
         // iterate to get a more accurate well density
-        // create a copy of the well_state to use. If the operability checking is sucessful, we use this one
-        // to replace the original one
-        WellState well_state_copy = ebosSimulator.problem().wellModel().wellState();
-        well_state_copy.currentControls()[index_of_well_] = bhp_index;
+        // well_state is scratch space owned by the caller, the real well state is not touched.
+        // Every solve starts from the values of the real well state, not from the previous solve.
+        well_state.copyWellValues(ebosSimulator.problem().wellModel().wellState(), index_of_well_);
+        well_state.currentControls()[index_of_well_] = bhp_index;
 
-        bool converged = this->solveWellEqUntilConverged(ebosSimulator, B_avg, well_state_copy, deferred_logger);
+        bool converged = this->solveWellEqUntilConverged(ebosSimulator, B_avg, well_state, deferred_logger);
 
         if (!converged) {
             const std::string msg = " well " + name() + " did not get converged during well potential calculations "
@@ -2297,8 +2304,8 @@ namespace Opm
             deferred_logger.debug(msg);
             return;
         }
-        updatePrimaryVariables(well_state_copy, deferred_logger);
-        computeWellConnectionPressures(ebosSimulator, well_state_copy);
+        updatePrimaryVariables(well_state, deferred_logger);
+        computeWellConnectionPressures(ebosSimulator, well_state);
         initPrimaryVariablesEvaluation();
 
 
@@ -2318,6 +2325,7 @@ namespace Opm
     computeWellPotentialWithTHP(const Simulator& ebosSimulator,
                                 const std::vector<Scalar>& B_avg,
                                 const double initial_bhp, // bhp from BHP constraints
+                                WellState& well_state,
                                 const std::vector<double>& initial_potential,
                                 Opm::DeferredLogger& deferred_logger)
     {
@@ -2383,7 +2391,7 @@ namespace Opm
 
             converged = std::abs(old_bhp - bhp) < bhp_tolerance;
 
-            computeWellRatesWithBhpPotential(ebosSimulator, B_avg, bhp, potentials, deferred_logger);
+            computeWellRatesWithBhpPotential(ebosSimulator, B_avg, bhp, well_state, potentials, deferred_logger);
 
             // checking whether the potentials have valid values
             for (const double value : potentials) {
@@ -2426,9 +2434,36 @@ namespace Opm
     StandardWell<TypeTag>::
     computeWellPotentials(const Simulator& ebosSimulator,
                           const std::vector<Scalar>& B_avg,
-                          const WellState& well_state,
+                          WellState& well_state,
                           std::vector<double>& well_potentials,
                           Opm::DeferredLogger& deferred_logger) // const
+    {
+        // the IPR of the well belongs to the real well state, keep it
+        const std::vector<double> orig_ipr_a = ipr_a_;
+        const std::vector<double> orig_ipr_b = ipr_b_;
+        try {
+            computeWellPotentialsImpl(ebosSimulator, B_avg, well_state, well_potentials, deferred_logger);
+        } catch (...) {
+            ipr_a_ = orig_ipr_a;
+            ipr_b_ = orig_ipr_b;
+            throw;
+        }
+        ipr_a_ = orig_ipr_a;
+        ipr_b_ = orig_ipr_b;
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    void
+    StandardWell<TypeTag>::
+    computeWellPotentialsImpl(const Simulator& ebosSimulator,
+                              const std::vector<Scalar>& B_avg,
+                              WellState& well_state,
+                              std::vector<double>& well_potentials,
+                              Opm::DeferredLogger& deferred_logger)
     {
         updatePrimaryVariables(well_state, deferred_logger);
         computeWellConnectionPressures(ebosSimulator, well_state);
@@ -2446,7 +2481,7 @@ namespace Opm
         // does the well have a THP related constraint?
         if ( !wellHasTHPConstraints() ) {
             assert(std::abs(bhp) != std::numeric_limits<double>::max());
-            computeWellRatesWithBhpPotential(ebosSimulator, B_avg, bhp, well_potentials, deferred_logger);
+            computeWellRatesWithBhpPotential(ebosSimulator, B_avg, bhp, well_state, well_potentials, deferred_logger);
         } else {
             // the well has a THP related constraint
             // checking whether a well is newly added, it only happens at the beginning of the report step
@@ -2458,7 +2493,7 @@ namespace Opm
                 }
             } else {
                 // We need to generate a reasonable rates to start the iteration process
-                computeWellRatesWithBhpPotential(ebosSimulator, B_avg, bhp, well_potentials, deferred_logger);
+                computeWellRatesWithBhpPotential(ebosSimulator, B_avg, bhp, well_state, well_potentials, deferred_logger);
                 for (double& value : well_potentials) {
                     // make the value a little safer in case the BHP limits are default ones
                     // TODO: a better way should be a better rescaling based on the investigation of the VFP table.
@@ -2467,7 +2502,7 @@ namespace Opm
                 }
             }
 
-            well_potentials = computeWellPotentialWithTHP(ebosSimulator, B_avg, bhp, well_potentials, deferred_logger);
+            well_potentials = computeWellPotentialWithTHP(ebosSimulator, B_avg, bhp, well_state, well_potentials, deferred_logger);
         }
     }
 
@@ -2709,7 +2744,7 @@ namespace Opm
             const bool allow_cf = getAllowCrossFlow() || openCrossFlowAvoidSingularity(ebos_simulator);
             const EvalWell& bhp = getBhp();
 
-            std::vector<EvalWell> cq_s(num_components_, {numWellEq_ + numEq, 0.});
+            std::vector<EvalWell> cq_s(num_components_, makeEvalWell(0.));
             double perf_dis_gas_rate = 0.;
             double perf_vap_oil_rate = 0.;
             double trans_mult = ebos_simulator.problem().template rockCompTransMultiplier<double>(int_quant, cell_idx);
@@ -2765,7 +2800,7 @@ namespace Opm
                 while ( col != row.end() && col.index() < col_index ) ++col;
                 assert(col != row.end() && col.index() == col_index);
 
-                Dune::DynamicMatrix<Scalar> tmp;
+                OffDiagMatrixBlockWellType tmp;
                 Detail::multMatrix(invDuneD_[0][0],  (*colB), tmp);
                 typename Mat::block_type tmp1;
                 Detail::multMatrixTransposed((*colC), tmp, tmp1);
@@ -2778,6 +2813,48 @@ namespace Opm
 
 
 
+    template<typename TypeTag>
+    bool
+    StandardWell<TypeTag>::addToSchurComplement(WellSchurComplement<Scalar, numEq>& op) const
+    {
+        // Nothing to apply, see apply(x, Ax).
+        if (!this->isOperable() || param_.matrix_add_well_contributions_) {
+            return true;
+        }
+
+        std::vector<int> cells;
+        cells.reserve(duneB_[0].size());
+        for (auto colB = duneB_[0].begin(), endB = duneB_[0].end(); colB != endB; ++colB) {
+            cells.push_back(colB.index());
+        }
+        const int w = op.addWell(cells, numWellEq_);
+
+        const auto& invD = invDuneD_[0][0];
+        Scalar* d = op.invD(w);
+        for (int i = 0; i < numWellEq_; ++i) {
+            for (int j = 0; j < numWellEq_; ++j) {
+                d[i * numWellEq_ + j] = invD[i][j];
+            }
+        }
+        for (std::size_t conn = 0; conn < cells.size(); ++conn) {
+            const auto& b = duneB_[0][cells[conn]];
+            const auto& c = duneC_[0][cells[conn]];
+            Scalar* opB = op.B(w, conn);
+            Scalar* opC = op.C(w, conn);
+            for (int i = 0; i < numWellEq_; ++i) {
+                for (int j = 0; j < numEq; ++j) {
+                    opB[i * numEq + j] = b[i][j];
+                    opC[i * numEq + j] = c[i][j];
+                }
+            }
+        }
+        return true;
+    }
+
+
+
+
+
     template<typename TypeTag>
     double
     StandardWell<TypeTag>::
@@ -2962,9 +3039,9 @@ namespace Opm
             OPM_DEFLOG_THROW(std::runtime_error, "Unused SKPRWAT table id used for well " << name(), deferred_logger);
         }
         const auto& water_table_func = PolymerModule::getSkprwatTable(water_table_id);
-        const EvalWell throughput_eval(numWellEq_ + numEq, throughput);
+        const EvalWell throughput_eval = makeEvalWell(throughput);
         // the skin pressure when injecting water, which also means the polymer concentration is zero
-        EvalWell pskin_water(numWellEq_ + numEq, 0.0);
+        EvalWell pskin_water = makeEvalWell(0.0);
         pskin_water = water_table_func.eval(throughput_eval, water_velocity);
         return pskin_water;
     }
@@ -2996,9 +3073,9 @@ namespace Opm
         }
         const auto& skprpolytable = PolymerModule::getSkprpolyTable(polymer_table_id);
         const double reference_concentration = skprpolytable.refConcentration;
-        const EvalWell throughput_eval(numWellEq_ + numEq, throughput);
+        const EvalWell throughput_eval = makeEvalWell(throughput);
         // the skin pressure when injecting water, which also means the polymer concentration is zero
-        EvalWell pskin_poly(numWellEq_ + numEq, 0.0);
+        EvalWell pskin_poly = makeEvalWell(0.0);
         pskin_poly = skprpolytable.table_func.eval(throughput_eval, water_velocity_abs);
         if (poly_inj_conc == reference_concentration) {
             return sign * pskin_poly;
@@ -3026,8 +3103,8 @@ namespace Opm
         }
         const int table_id = well_ecl_.getPolymerProperties().m_plymwinjtable;
         const auto& table_func = PolymerModule::getPlymwinjTable(table_id);
-        const EvalWell throughput_eval(numWellEq_ + numEq, throughput);
-        EvalWell molecular_weight(numWellEq_ + numEq, 0.);
+        const EvalWell throughput_eval = makeEvalWell(throughput);
+        EvalWell molecular_weight = makeEvalWell(0.);
         if (wpolymer() == 0.) { // not injecting polymer
             return molecular_weight;
         }
@@ -3084,7 +3161,7 @@ namespace Opm
         const double throughput = well_state.perfThroughput()[first_perf_ + perf];
         const int pskin_index = Bhp + 1 + number_of_perforations_ + perf;
 
-        EvalWell poly_conc(numWellEq_ + numEq, 0.0);
+        EvalWell poly_conc = makeEvalWell(0.0);
         poly_conc.setValue(wpolymer());
 
         // equation for the skin pressure
@@ -144,6 +144,59 @@ bhpwithflo(const std::vector<double>& flos,
 
 
 
+constexpr double VFPProdProperties::LiftCurve::fraction_tolerance;
+
+
+void
+VFPProdProperties::
+updateLiftCurve(LiftCurve& lift_curve,
+                const int table_id,
+                const double wfr,
+                const double gfr,
+                const double thp,
+                const double alq) const
+{
+    const auto isClose = [](const double value, const double sampled) {
+        return std::abs(value - sampled) <= LiftCurve::fraction_tolerance * std::abs(sampled);
+    };
+
+    if (lift_curve.table_id == table_id && lift_curve.thp == thp && lift_curve.alq == alq
+        && isClose(wfr, lift_curve.wfr) && isClose(gfr, lift_curve.gfr)) {
+        return;
+    }
+
+    // we get the flo sampling points from the table,
+    // then extend it with zero for extrapolation
+    const VFPProdTable* table = detail::getTable(m_tables, table_id);
+    std::vector<double> flo_samples = table->getFloAxis();
+
+    if (flo_samples[0] > 0.) {
+        flo_samples.insert(flo_samples.begin(), 0.);
+    }
+
+    // kind of unncessarily following the tradation that producers should have negative rates
+    // the key is here that it should be consistent with the function bhpwithflo
+    for (double& value : flo_samples) {
+        value = -value;
+    }
+
+    const std::vector<double> bhp_flo_samples = bhpwithflo(flo_samples, table_id, wfr, gfr, thp, alq, 0.);
+
+    lift_curve.table_id = table_id;
+    lift_curve.wfr = wfr;
+    lift_curve.gfr = gfr;
+    lift_curve.thp = thp;
+    lift_curve.alq = alq;
+    lift_curve.samples.clear();
+    for (size_t i = 0; i < flo_samples.size(); ++i) {
+        lift_curve.samples.push_back( detail::RateBhpPair{flo_samples[i], bhp_flo_samples[i]} );
+    }
+}
+
+
+
+
+
 double
 VFPProdProperties::
 calculateBhpWithTHPTarget(const std::vector<double>& ipr_a,
@@ -153,6 +206,25 @@ calculateBhpWithTHPTarget(const std::vector<double>& ipr_a,
                           const double thp_limit,
                           const double alq,
                           const double dp) const
+{
+    LiftCurve lift_curve;
+    return calculateBhpWithTHPTarget(ipr_a, ipr_b, bhp_limit, thp_table_id, thp_limit, alq, dp, lift_curve);
+}
+
+
+
+
+
+double
+VFPProdProperties::
+calculateBhpWithTHPTarget(const std::vector<double>& ipr_a,
+                          const std::vector<double>& ipr_b,
+                          const double bhp_limit,
+                          const double thp_table_id,
+                          const double thp_limit,
+                          const double alq,
+                          const double dp,
+                          LiftCurve& lift_curve) const
 {
     // For producers, bhp_safe_limit is the highest BHP value that can still produce based on IPR
     double bhp_safe_limit = 1.e100;
@@ -199,30 +271,20 @@ calculateBhpWithTHPTarget(const std::vector<double>& ipr_a,
     const double wfr = detail::getWFR(aqua_bhp_middle, liquid_bhp_middle, vapour_bhp_middle, table->getWFRType());
     const double gfr = detail::getGFR(aqua_bhp_middle, liquid_bhp_middle, vapour_bhp_middle, table->getGFRType());
 
-    // we get the flo sampling points from the table,
-    // then extend it with zero and rate under bhp_limit for extrapolation
-    std::vector<double> flo_samples = table->getFloAxis();
-
-    if (flo_samples[0] > 0.) {
-        flo_samples.insert(flo_samples.begin(), 0.);
-    }
-
-    if (flo_samples.back() < std::abs(flo_bhp_limit)) {
-        flo_samples.push_back(std::abs(flo_bhp_limit));
-    }
+    // the bhp sampling values at the flo values of the table
+    updateLiftCurve(lift_curve, thp_table_id, wfr, gfr, thp_limit, alq);
 
-    // kind of unncessarily following the tradation that producers should have negative rates
-    // the key is here that it should be consistent with the function bhpwithflo
-    for (double& value : flo_samples) {
-        value = -value;
+    std::vector<detail::RateBhpPair> ratebhp_samples;
+    ratebhp_samples.reserve(lift_curve.samples.size() + 1);
+    for (const auto& sample : lift_curve.samples) {
+        ratebhp_samples.push_back( detail::RateBhpPair{sample.rate, sample.bhp - dp} );
     }
 
-    // get the bhp sampling values based on the flo sample values
-    const std::vector<double> bhp_flo_samples = bhpwithflo(flo_samples, thp_table_id, wfr, gfr, thp_limit, alq, dp);
-
-    std::vector<detail::RateBhpPair> ratebhp_samples;
-    for (size_t i = 0; i < flo_samples.size(); ++i) {
-        ratebhp_samples.push_back( detail::RateBhpPair{flo_samples[i], bhp_flo_samples[i]} );
+    // extend it with the rate under bhp_limit for extrapolation
+    if (-ratebhp_samples.back().rate < std::abs(flo_bhp_limit)) {
+        const double flo = -std::abs(flo_bhp_limit);
+        const double bhp = bhpwithflo({flo}, thp_table_id, lift_curve.wfr, lift_curve.gfr, thp_limit, alq, dp)[0];
+        ratebhp_samples.push_back( detail::RateBhpPair{flo, bhp} );
     }
 
     const std::array<detail::RateBhpPair, 2> ratebhp_twopoints_ipr {detail::RateBhpPair{flo_bhp_middle, bhp_middle},
@@ -171,6 +171,25 @@ public:
     }
 
 
+    /**
+     * The bhp values of a table at its flo values for a fixed WFR, GFR, THP
+     * and ALQ, without the datum depth correction. It is kept by the caller,
+     * typically a well, between calls of calculateBhpWithTHPTarget(), and is
+     * only resampled when the table, THP or ALQ change, or when WFR or GFR
+     * move by more than a relative tolerance of fraction_tolerance.
+     */
+    struct LiftCurve
+    {
+        static constexpr double fraction_tolerance = 1.e-3;
+
+        int table_id = -1;
+        double wfr = 0.;
+        double gfr = 0.;
+        double thp = 0.;
+        double alq = 0.;
+        std::vector<detail::RateBhpPair> samples;
+    };
+
     /**
      * Calculate the Bhp value from the THP target/constraint value
      * based on inflow performance relationship and VFP curves
@@ -184,7 +203,29 @@ public:
                                const double alq,
                                const double dp) const;
 
+    /**
+     * As above, reusing the lift curve from earlier calls if the flow
+     * fractions are close enough to the ones it was sampled at.
+     */
+     double
+     calculateBhpWithTHPTarget(const std::vector<double>& ipr_a,
+                               const std::vector<double>& ipr_b,
+                               const double bhp_limit,
+                               const double thp_table_id,
+                               const double thp_limit,
+                               const double alq,
+                               const double dp,
+                               LiftCurve& lift_curve) const;
+
 protected:
+    // resample the lift curve if its inputs changed
+    void updateLiftCurve(LiftCurve& lift_curve,
+                         const int table_id,
+                         const double wfr,
+                         const double gfr,
+                         const double thp,
+                         const double alq) const;
+
     // calculate a group bhp values with a group of flo rate values
     std::vector<double> bhpwithflo(const std::vector<double>& flos,
                                    const int table_id,
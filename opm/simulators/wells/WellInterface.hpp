@@ -42,6 +42,7 @@
 #include <opm/simulators/wells/VFPProperties.hpp>
 #include <opm/simulators/wells/WellHelpers.hpp>
 #include <opm/simulators/wells/WellStateFullyImplicitBlackoil.hpp>
+#include <opm/simulators/wells/WellSchurComplement.hpp>
 #include <opm/simulators/flow/BlackoilModelParametersEbos.hpp>
 
 #include <opm/simulators/timestepping/ConvergenceReport.hpp>
@@ -115,7 +116,8 @@ namespace Opm
                       const ModelParameters& param,
                       const RateConverterType& rate_converter,
                       const int pvtRegionIdx,
-                      const int num_components);
+                      const int num_components,
+                      const int index_of_well = -1);
 
         /// Virutal destructor
         virtual ~WellInterface() {}
@@ -178,12 +180,23 @@ namespace Opm
         virtual void apply(BVector& r) const = 0;
 
         // TODO: before we decide to put more information under mutable, this function is not const
+        /// well_state is used as scratch space, only the slices of this well are changed
         virtual void computeWellPotentials(const Simulator& ebosSimulator,
                                            const std::vector<Scalar>& B_avg,
-                                           const WellState& well_state,
+                                           WellState& well_state,
                                            std::vector<double>& well_potentials,
                                            Opm::DeferredLogger& deferred_logger) = 0;
 
+        /// Compute the well potentials with only the BHP and THP limits of the
+        /// well from the schedule as controls. The controls are swapped in for
+        /// the duration of the computation, the primary variables of the well
+        /// have to be recomputed from the real well state afterwards.
+        void computeWellPotentialsWithLimits(const Simulator& ebosSimulator,
+                                             const std::vector<Scalar>& B_avg,
+                                             WellState& well_state,
+                                             std::vector<double>& well_potentials,
+                                             Opm::DeferredLogger& deferred_logger);
+
         virtual void updateWellStateWithTarget(const Simulator& ebos_simulator,
                                                WellState& well_state,
                                                Opm::DeferredLogger& deferred_logger) const = 0;
@@ -211,6 +224,14 @@ namespace Opm
         virtual void addWellContributions(Mat&) const
         {}
 
+        /// Add the B, C and D^-1 blocks of the well to the operator shared by
+        /// all wells. Returns false if the well does not support this, and
+        /// then has to be applied on its own.
+        virtual bool addToSchurComplement(WellSchurComplement<Scalar, numEq>&) const
+        {
+            return false;
+        }
+
         void addCellRates(RateVector& rates, int cellIdx) const;
 
         Scalar volumetricSurfaceRateForConnection(int cellIdx, int phaseIdx) const;
@@ -284,6 +305,10 @@ namespace Opm
         // controls for this well
         struct WellControls* well_controls_;
 
+        // controls holding the BHP and THP limits only, reused for every
+        // well potential calculation
+        std::unique_ptr<WellControls, void(*)(WellControls*)> potential_controls_{nullptr, &well_controls_destroy};
+
         // number of the perforations for this well
         int number_of_perforations_;
 
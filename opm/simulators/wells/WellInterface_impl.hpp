@@ -31,7 +31,8 @@ namespace Opm
                   const ModelParameters& param,
                   const RateConverterType& rate_converter,
                   const int pvtRegionIdx,
-                  const int num_components)
+                  const int num_components,
+                  const int index_of_well)
       : well_ecl_(well)
       , current_step_(time_step)
       , param_(param)
@@ -49,17 +50,20 @@ namespace Opm
 
         const std::string& well_name = well.name();
 
-        // looking for the location of the well in the wells struct
-        int index_well;
-        for (index_well = 0; index_well < wells->number_of_wells; ++index_well) {
-            if (well_name == std::string(wells->name[index_well])) {
-                break;
+        // looking for the location of the well in the wells struct, unless the caller knows it
+        int index_well = index_of_well;
+        if (index_well < 0) {
+            for (index_well = 0; index_well < wells->number_of_wells; ++index_well) {
+                if (well_name == std::string(wells->name[index_well])) {
+                    break;
+                }
             }
         }
 
         // should not enter the constructor if the well does not exist in the wells struct
         // here, just another assertion.
         assert(index_well != wells->number_of_wells);
+        assert(well_name == std::string(wells->name[index_well]));
 
         index_of_well_ = index_well;
         well_type_ = wells->type[index_well];
@@ -1288,7 +1292,6 @@ namespace Opm
         int it = 0;
         const double dt = 1.0; //not used for the well tests
         bool converged;
-        WellState well_state0 = well_state;
         do {
             assembleWellEq(ebosSimulator, B_avg, dt, well_state, deferred_logger);
 
@@ -1313,6 +1316,68 @@ namespace Opm
 
 
 
+    template<typename TypeTag>
+    void
+    WellInterface<TypeTag>::
+    computeWellPotentialsWithLimits(const Simulator& ebosSimulator,
+                                    const std::vector<Scalar>& B_avg,
+                                    WellState& well_state,
+                                    std::vector<double>& well_potentials,
+                                    Opm::DeferredLogger& deferred_logger)
+    {
+        const double invalid_alq = -1e100;
+        const double invalid_vfp = -2147483647;
+
+        if (!potential_controls_) {
+            potential_controls_.reset(well_controls_create());
+            if (!potential_controls_) {
+                OPM_DEFLOG_THROW(std::runtime_error, "Could not allocate the potential controls for well " << name(), deferred_logger);
+            }
+        }
+        WellControls* wc = potential_controls_.get();
+        well_controls_clear(wc);
+        well_controls_assert_number_of_phases(wc, number_of_phases_);
+
+        const auto& summaryState = ebosSimulator.vanguard().summaryState();
+        if (well_type_ == INJECTOR) {
+            const auto controls = well_ecl_.injectionControls(summaryState);
+            if (controls.hasControl(WellInjector::THP)) {
+                well_controls_add_new(THP, controls.thp_limit, invalid_alq, controls.vfp_table_number, NULL, wc);
+            }
+            // we always have a bhp limit
+            well_controls_add_new(BHP, controls.bhp_limit, invalid_alq, invalid_vfp, NULL, wc);
+        } else {
+            const auto controls = well_ecl_.productionControls(summaryState);
+            if (controls.hasControl(WellProducer::THP)) {
+                well_controls_add_new(THP, controls.thp_limit, controls.alq_value, controls.vfp_table_number, NULL, wc);
+            }
+            // we always have a bhp limit
+            well_controls_add_new(BHP, controls.bhp_limit, invalid_alq, invalid_vfp, NULL, wc);
+        }
+        const int bhp_index = well_controls_get_num(wc) - 1;
+        well_controls_set_current(wc, bhp_index);
+        well_state.currentControls()[index_of_well_] = bhp_index;
+
+        // the potential calculation may update the operability of the well,
+        // which has to stay the one of the real well state
+        WellControls* const orig_controls = well_controls_;
+        const OperabilityStatus orig_operability = operability_status_;
+        well_controls_ = wc;
+        try {
+            computeWellPotentials(ebosSimulator, B_avg, well_state, well_potentials, deferred_logger);
+        } catch (...) {
+            well_controls_ = orig_controls;
+            operability_status_ = orig_operability;
+            throw;
+        }
+        well_controls_ = orig_controls;
+        operability_status_ = orig_operability;
+    }
+
+
+
+
+
     template<typename TypeTag>
     void
     WellInterface<TypeTag>::calculateReservoirRates(WellState& well_state) const
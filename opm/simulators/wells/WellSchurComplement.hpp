@@ -0,0 +1,253 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_WELLSCHURCOMPLEMENT_HEADER_INCLUDED
+#define OPM_WELLSCHURCOMPLEMENT_HEADER_INCLUDED
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace Opm
+{
+
+    /// The well part C^T D^-1 B of the Schur complement of the reservoir
+    /// system, for all wells of a process in one data structure.
+    ///
+    /// For each well the blocks of B and C (numWellEq x numEq, one per
+    /// perforated cell) and the inverse of D (numWellEq x numWellEq) are
+    /// stored row by row in contiguous arrays. Applying the operator first
+    /// computes z_w = D_w^-1 B_w x for all wells and then subtracts C^T z
+    /// cell by cell, so both steps can be split over threads without any
+    /// two threads writing to the same entry.
+    template <class Scalar, int numEq>
+    class WellSchurComplement
+    {
+    public:
+        WellSchurComplement()
+        {
+            clear();
+        }
+
+        /// Remove all wells.
+        void clear()
+        {
+            wellEqStart_.assign(1, 0);
+            wellCellStart_.assign(1, 0);
+            offDiagStart_.clear();
+            invDStart_.clear();
+            cells_.clear();
+            offDiag_.clear();
+            invD_.clear();
+            cellStart_.clear();
+            cellEntries_.clear();
+            rowCells_.clear();
+            z_.clear();
+        }
+
+        /// Add a well with the given perforated cells (each cell only once)
+        /// and number of well equations. The blocks are zero initialized and
+        /// set through B(), C() and invD(). Returns the index of the well.
+        int addWell(const std::vector<int>& cells, const int numWellEq)
+        {
+            const int well = numberOfWells();
+            wellEqStart_.push_back(wellEqStart_.back() + numWellEq);
+            wellCellStart_.push_back(wellCellStart_.back() + cells.size());
+            cells_.insert(cells_.end(), cells.begin(), cells.end());
+            // B and C blocks of a connection are stored next to each other.
+            offDiagStart_.push_back(offDiag_.size());
+            offDiag_.resize(offDiag_.size() + 2 * cells.size() * numWellEq * numEq, 0.0);
+            invDStart_.push_back(invD_.size());
+            invD_.resize(invD_.size() + numWellEq * numWellEq, 0.0);
+            return well;
+        }
+
+        int numberOfWells() const
+        {
+            return wellEqStart_.size() - 1;
+        }
+
+        int numberOfWellEquations(const int well) const
+        {
+            return wellEqStart_[well + 1] - wellEqStart_[well];
+        }
+
+        /// Row major numWellEq x numEq block of B for the connection to the
+        /// conn-th cell of the well.
+        Scalar* B(const int well, const int conn)
+        {
+            return &offDiag_[offDiagStart(well, wellCellStart_[well] + conn)];
+        }
+
+        /// Row major numWellEq x numEq block of C (not transposed) for the
+        /// connection to the conn-th cell of the well.
+        Scalar* C(const int well, const int conn)
+        {
+            return &offDiag_[offDiagStart(well, wellCellStart_[well] + conn) + numberOfWellEquations(well) * numEq];
+        }
+
+        /// Row major numWellEq x numWellEq inverse of D.
+        Scalar* invD(const int well)
+        {
+            return &invD_[invDStart_[well]];
+        }
+
+        /// Build the cell wise lookup used by apply(). Has to be called after
+        /// the last well was added.
+        void finalize()
+        {
+            const int numConn = cells_.size();
+            std::vector<int> order(numConn);
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(),
+                             [this](const int a, const int b) { return cells_[a] < cells_[b]; });
+            rowCells_.clear();
+            cellStart_.assign(1, 0);
+            cellEntries_.clear();
+            cellEntries_.reserve(numConn);
+            std::vector<int> connWell(numConn);
+            for (int well = 0; well < numberOfWells(); ++well) {
+                for (int conn = wellCellStart_[well]; conn < wellCellStart_[well + 1]; ++conn) {
+                    connWell[conn] = well;
+                }
+            }
+            for (const int conn : order) {
+                if (rowCells_.empty() || rowCells_.back() != cells_[conn]) {
+                    if (!rowCells_.empty()) {
+                        cellStart_.push_back(cellEntries_.size());
+                    }
+                    rowCells_.push_back(cells_[conn]);
+                }
+                cellEntries_.push_back({conn, connWell[conn]});
+            }
+            if (!rowCells_.empty()) {
+                cellStart_.push_back(cellEntries_.size());
+            }
+            z_.assign(wellEqStart_.back(), 0.0);
+        }
+
+        /// Ax = Ax - C^T D^-1 B x
+        template <class Vector>
+        void apply(const Vector& x, Vector& Ax) const
+        {
+            const int nw = numberOfWells();
+            std::vector<Scalar>& z = z_;
+            assert(z.size() == static_cast<std::size_t>(wellEqStart_.back()));
+
+            // z_w = D_w^-1 B_w x
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+            for (int well = 0; well < nw; ++well) {
+                const int n = numberOfWellEquations(well);
+                Scalar* zw = &z[wellEqStart_[well]];
+                // B_w x, on the stack unless the well has many equations
+                Scalar bx[maxStackEquations];
+                std::vector<Scalar> bxHeap;
+                Scalar* bxp = bx;
+                if (n > maxStackEquations) {
+                    bxHeap.resize(n);
+                    bxp = bxHeap.data();
+                }
+                std::fill(bxp, bxp + n, 0.0);
+                for (int conn = wellCellStart_[well]; conn < wellCellStart_[well + 1]; ++conn) {
+                    const Scalar* b = &offDiag_[offDiagStart(well, conn)];
+                    const auto& xc = x[cells_[conn]];
+                    for (int i = 0; i < n; ++i) {
+                        Scalar sum = 0.0;
+                        for (int j = 0; j < numEq; ++j) {
+                            sum += b[i * numEq + j] * xc[j];
+                        }
+                        bxp[i] += sum;
+                    }
+                }
+                const Scalar* d = &invD_[invDStart_[well]];
+                for (int i = 0; i < n; ++i) {
+                    Scalar sum = 0.0;
+                    for (int j = 0; j < n; ++j) {
+                        sum += d[i * n + j] * bxp[j];
+                    }
+                    zw[i] = sum;
+                }
+            }
+
+            // Ax_c = Ax_c - sum_w C_wc^T z_w
+            const int numRows = rowCells_.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+            for (int row = 0; row < numRows; ++row) {
+                auto& y = Ax[rowCells_[row]];
+                for (int entry = cellStart_[row]; entry < cellStart_[row + 1]; ++entry) {
+                    const int conn = cellEntries_[entry].connection;
+                    const int well = cellEntries_[entry].well;
+                    const int n = numberOfWellEquations(well);
+                    const Scalar* c = &offDiag_[offDiagStart(well, conn) + n * numEq];
+                    const Scalar* zw = &z[wellEqStart_[well]];
+                    for (int i = 0; i < n; ++i) {
+                        for (int j = 0; j < numEq; ++j) {
+                            y[j] -= c[i * numEq + j] * zw[i];
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        // well equations up to this number use a buffer on the stack in apply()
+        static const int maxStackEquations = 16;
+
+        struct CellEntry
+        {
+            int connection;
+            int well;
+        };
+
+        // offset of the B block of a connection, numbered over all wells
+        std::size_t offDiagStart(const int well, const int conn) const
+        {
+            return offDiagStart_[well] + 2 * static_cast<std::size_t>(conn - wellCellStart_[well])
+                * numberOfWellEquations(well) * numEq;
+        }
+
+        // per well: start of the equations in z_, of the cells in cells_, of
+        // the B and C blocks in offDiag_ and of D^-1 in invD_
+        std::vector<int> wellEqStart_;
+        std::vector<int> wellCellStart_;
+        std::vector<std::size_t> offDiagStart_;
+        std::vector<std::size_t> invDStart_;
+
+        // per connection: the perforated cell, and the B and C blocks
+        std::vector<int> cells_;
+        std::vector<Scalar> offDiag_;
+        std::vector<Scalar> invD_;
+
+        // connections grouped by cell, for the second step of apply()
+        std::vector<int> rowCells_;
+        std::vector<int> cellStart_;
+        std::vector<CellEntry> cellEntries_;
+
+        mutable std::vector<Scalar> z_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_WELLSCHURCOMPLEMENT_HEADER_INCLUDED
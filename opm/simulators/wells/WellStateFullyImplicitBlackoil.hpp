@@ -917,7 +917,130 @@ namespace Opm
             return perf_water_velocity_;
         }
 
+        /// The values of the well state that are changed when solving the
+        /// well equations. Unlike a copy of the whole well state it does
+        /// not clone the Wells struct and the well map, and the storage is
+        /// reused when the same snapshot is saved to repeatedly.
+        struct Snapshot
+        {
+            std::vector<double> bhp;
+            std::vector<double> thp;
+            std::vector<double> temperature;
+            std::vector<double> well_rates;
+            std::vector<double> perf_rates;
+            std::vector<double> perf_press;
+            std::vector<double> perf_phase_rates;
+            std::vector<int> current_controls;
+            std::vector<double> perf_rate_solvent;
+            std::vector<double> perf_water_throughput;
+            std::vector<double> perf_skin_pressure;
+            std::vector<double> perf_water_velocity;
+            std::vector<double> well_reservoir_rates;
+            std::vector<double> well_dissolved_gas_rates;
+            std::vector<double> well_vaporized_oil_rates;
+            std::vector<double> seg_rates;
+            std::vector<double> seg_press;
+            std::vector<double> productivity_index;
+            std::vector<double> well_potentials;
+        };
+
+        void saveSnapshot(Snapshot& snapshot) const
+        {
+            snapshot.bhp = bhp();
+            snapshot.thp = thp();
+            snapshot.temperature = temperature();
+            snapshot.well_rates = wellRates();
+            snapshot.perf_rates = perfRates();
+            snapshot.perf_press = perfPress();
+            snapshot.perf_phase_rates = perfphaserates_;
+            snapshot.current_controls = current_controls_;
+            snapshot.perf_rate_solvent = perfRateSolvent_;
+            snapshot.perf_water_throughput = perf_water_throughput_;
+            snapshot.perf_skin_pressure = perf_skin_pressure_;
+            snapshot.perf_water_velocity = perf_water_velocity_;
+            snapshot.well_reservoir_rates = well_reservoir_rates_;
+            snapshot.well_dissolved_gas_rates = well_dissolved_gas_rates_;
+            snapshot.well_vaporized_oil_rates = well_vaporized_oil_rates_;
+            snapshot.seg_rates = segrates_;
+            snapshot.seg_press = segpress_;
+            snapshot.productivity_index = productivity_index_;
+            snapshot.well_potentials = well_potentials_;
+        }
+
+        /// Restore the values saved by saveSnapshot(). The wells must not
+        /// have changed in between.
+        void restoreSnapshot(const Snapshot& snapshot)
+        {
+            assert(snapshot.bhp.size() == bhp().size());
+            assert(snapshot.perf_phase_rates.size() == perfphaserates_.size());
+            assert(snapshot.seg_rates.size() == segrates_.size());
+
+            bhp() = snapshot.bhp;
+            thp() = snapshot.thp;
+            temperature() = snapshot.temperature;
+            wellRates() = snapshot.well_rates;
+            perfRates() = snapshot.perf_rates;
+            perfPress() = snapshot.perf_press;
+            perfphaserates_ = snapshot.perf_phase_rates;
+            current_controls_ = snapshot.current_controls;
+            perfRateSolvent_ = snapshot.perf_rate_solvent;
+            perf_water_throughput_ = snapshot.perf_water_throughput;
+            perf_skin_pressure_ = snapshot.perf_skin_pressure;
+            perf_water_velocity_ = snapshot.perf_water_velocity;
+            well_reservoir_rates_ = snapshot.well_reservoir_rates;
+            well_dissolved_gas_rates_ = snapshot.well_dissolved_gas_rates;
+            well_vaporized_oil_rates_ = snapshot.well_vaporized_oil_rates;
+            segrates_ = snapshot.seg_rates;
+            segpress_ = snapshot.seg_press;
+            productivity_index_ = snapshot.productivity_index;
+            well_potentials_ = snapshot.well_potentials;
+        }
+
+        /// Copy the values of well w held by a snapshot from other, which
+        /// must have the same wells. The values of the other wells are
+        /// left untouched.
+        void copyWellValues(const WellStateFullyImplicitBlackoil& other, const int w)
+        {
+            assert(other.numWells() == numWells());
+            assert(other.numSegment() == numSegment());
+
+            const int np = numPhases();
+            const int first_perf = wells_->well_connpos[w];
+            const int end_perf = wells_->well_connpos[w + 1];
+            const int top_segment = topSegmentIndex(w);
+            const int end_segment = top_segment + numSegments(w);
+            bhp()[w] = other.bhp()[w];
+            thp()[w] = other.thp()[w];
+            temperature()[w] = other.temperature()[w];
+            current_controls_[w] = other.current_controls_[w];
+            copyRange(other.wellRates(), wellRates(), w * np, (w + 1) * np);
+            copyRange(other.perfRates(), perfRates(), first_perf, end_perf);
+            copyRange(other.perfPress(), perfPress(), first_perf, end_perf);
+            copyRange(other.perfphaserates_, perfphaserates_, first_perf * np, end_perf * np);
+            copyRange(other.perfRateSolvent_, perfRateSolvent_, first_perf, end_perf);
+            copyRange(other.perf_water_throughput_, perf_water_throughput_, first_perf, end_perf);
+            copyRange(other.perf_skin_pressure_, perf_skin_pressure_, first_perf, end_perf);
+            copyRange(other.perf_water_velocity_, perf_water_velocity_, first_perf, end_perf);
+            copyRange(other.well_reservoir_rates_, well_reservoir_rates_, w * np, (w + 1) * np);
+            well_dissolved_gas_rates_[w] = other.well_dissolved_gas_rates_[w];
+            well_vaporized_oil_rates_[w] = other.well_vaporized_oil_rates_[w];
+            copyRange(other.segrates_, segrates_, top_segment * np, end_segment * np);
+            copyRange(other.segpress_, segpress_, top_segment, end_segment);
+            copyRange(other.productivity_index_, productivity_index_, w * np, (w + 1) * np);
+            copyRange(other.well_potentials_, well_potentials_, w * np, (w + 1) * np);
+        }
+
     private:
+        // copy the entries [begin, end) of from, which might be unused and empty
+        template <class T>
+        static void copyRange(const std::vector<T>& from, std::vector<T>& to, const int begin, const int end)
+        {
+            assert(from.size() == to.size());
+            if (!from.empty()) {
+                std::copy(from.begin() + begin, from.begin() + end, to.begin() + begin);
+            }
+        }
+
         std::vector<double> perfphaserates_;
         std::vector<int> current_controls_;
         std::vector<double> perfRateSolvent_;
@@ -0,0 +1,56 @@
+#!/bin/bash
+
+# This runs a simulator twice, with the natural cell order and with the
+# region clustered reverse Cuthill-McKee ordering (--ilu-reorder-rcm) in
+# the ILU0 preconditioner. It reports the linear iterations, the linear
+# solve time and the assembly time of both runs. The linear systems of
+# the first run are replayed with flow_linsolve_bench with both
+# orderings. Finally the summary files of the two runs are compared.
+
+INPUT_DATA_PATH="$1"
+RESULT_PATH="$2"
+BINPATH="$3"
+FILENAME="$4"
+ABS_TOL="$5"
+REL_TOL="$6"
+COMPARE_ECL_COMMAND="$7"
+EXE_NAME="${8}"
+shift 8
+TEST_ARGS="$@"
+
+rm -Rf ${RESULT_PATH}
+mkdir -p ${RESULT_PATH}/natural ${RESULT_PATH}/rcm ${RESULT_PATH}/systems
+cd ${RESULT_PATH}
+
+${BINPATH}/${EXE_NAME} ${TEST_ARGS} --ilu-reorder-rcm=false --linear-solver-dump-prefix=${RESULT_PATH}/systems/system --linear-solver-dump-interval=10 --output-dir=${RESULT_PATH}/natural
+test $? -eq 0 || exit 1
+${BINPATH}/${EXE_NAME} ${TEST_ARGS} --ilu-reorder-rcm=true --output-dir=${RESULT_PATH}/rcm
+test $? -eq 0 || exit 1
+cd ..
+
+report() {
+  local prt=${RESULT_PATH}/$1/${FILENAME}.PRT
+  local its=`grep "Overall Linear Iterations:" ${prt} | tail -n 1 | awk '{print $4}'`
+  local lin=`grep "Linear solve time (seconds):" ${prt} | tail -n 1 | awk '{print $5}'`
+  local asm=`grep "Assembly time (seconds):" ${prt} | tail -n 1 | awk '{print $4}'`
+  printf "%-10s linear its = %8s   linear solve time = %10s s   assembly time = %10s s\n" $1 ${its} ${lin} ${asm}
+}
+
+echo "=== Simulator runs for ${FILENAME} ==="
+report natural
+report rcm
+
+echo "=== Replay of the linear systems of the natural run ==="
+${BINPATH}/flow_linsolve_bench ${RESULT_PATH}/systems/*.opmls | tail -n 1
+${BINPATH}/flow_linsolve_bench --ilu-reorder-rcm ${RESULT_PATH}/systems/*.opmls | tail -n 1
+
+ecode=0
+echo "=== Executing comparison for summary file ==="
+${COMPARE_ECL_COMMAND} -t SMRY ${RESULT_PATH}/natural/${FILENAME} ${RESULT_PATH}/rcm/${FILENAME} ${ABS_TOL} ${REL_TOL}
+if [ $? -ne 0 ]
+then
+  ecode=1
+  ${COMPARE_ECL_COMMAND} -a -t SMRY ${RESULT_PATH}/natural/${FILENAME} ${RESULT_PATH}/rcm/${FILENAME} ${ABS_TOL} ${REL_TOL}
+fi
+
+exit $ecode
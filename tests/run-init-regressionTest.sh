@@ -5,6 +5,8 @@
 # This is meant to track regressions in INIT file writing.
 # Useful for models that are too large to do simulation on
 # as a regression test.
+# The wall time and the peak memory use of the initialization are
+# reported as well, to track the startup cost of large models.
 
 INPUT_DATA_PATH="$1"
 RESULT_PATH="$2"
@@ -20,9 +22,14 @@ TEST_ARGS="$@"
 rm -Rf  ${RESULT_PATH}
 mkdir -p ${RESULT_PATH}
 cd ${RESULT_PATH}
-${BINPATH}/${EXE_NAME} ${TEST_ARGS} --enable-dry-run=true --output-dir=${RESULT_PATH}
+/usr/bin/time -f "%e %M" -o ${RESULT_PATH}/startup ${BINPATH}/${EXE_NAME} ${TEST_ARGS} --enable-dry-run=true --output-dir=${RESULT_PATH}
+test $? -eq 0 || exit 1
 cd ..
 
+echo "=== Initialization of ${FILENAME} ==="
+read wall rss < ${RESULT_PATH}/startup
+printf "wall time = %10s s   max RSS = %10s kB\n" ${wall} ${rss}
+
 ecode=0
 ${COMPARE_ECL_COMMAND} -t INIT ${RESULT_PATH}/${FILENAME} ${INPUT_DATA_PATH}/opm-simulation-reference/${EXE_NAME}/${FILENAME} ${ABS_TOL} ${REL_TOL}
 if [ $? -ne 0 ]
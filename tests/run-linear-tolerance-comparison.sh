@@ -0,0 +1,50 @@
+#!/bin/bash
+
+# This runs a simulator twice, with the fixed linear solver reduction and
+# with the adaptive (Eisenstat-Walker) linear tolerance. It reports the
+# linear iterations and linear solve time of both runs, then compares
+# the summary files of the two runs.
+
+INPUT_DATA_PATH="$1"
+RESULT_PATH="$2"
+BINPATH="$3"
+FILENAME="$4"
+ABS_TOL="$5"
+REL_TOL="$6"
+COMPARE_ECL_COMMAND="$7"
+EXE_NAME="${8}"
+shift 8
+TEST_ARGS="$@"
+
+rm -Rf ${RESULT_PATH}
+mkdir -p ${RESULT_PATH}/fixed ${RESULT_PATH}/adaptive
+cd ${RESULT_PATH}
+
+/usr/bin/time -f "%e" -o fixed/walltime ${BINPATH}/${EXE_NAME} ${TEST_ARGS} --use-adaptive-linear-tolerance=false --output-dir=${RESULT_PATH}/fixed
+test $? -eq 0 || exit 1
+/usr/bin/time -f "%e" -o adaptive/walltime ${BINPATH}/${EXE_NAME} ${TEST_ARGS} --use-adaptive-linear-tolerance=true --output-dir=${RESULT_PATH}/adaptive
+test $? -eq 0 || exit 1
+cd ..
+
+report() {
+  local prt=${RESULT_PATH}/$1/${FILENAME}.PRT
+  local its=`grep "Overall Linear Iterations:" ${prt} | tail -n 1 | awk '{print $4}'`
+  local lin=`grep "Linear solve time (seconds):" ${prt} | tail -n 1 | awk '{print $5}'`
+  local wall=`cat ${RESULT_PATH}/$1/walltime`
+  printf "%-10s linear its = %8s   linear solve time = %10s s   wall time = %10s s\n" $1 ${its} ${lin} ${wall}
+}
+
+echo "=== Linear solver effort for ${FILENAME} ==="
+report fixed
+report adaptive
+
+ecode=0
+echo "=== Executing comparison for summary file ==="
+${COMPARE_ECL_COMMAND} -t SMRY ${RESULT_PATH}/fixed/${FILENAME} ${RESULT_PATH}/adaptive/${FILENAME} ${ABS_TOL} ${REL_TOL}
+if [ $? -ne 0 ]
+then
+  ecode=1
+  ${COMPARE_ECL_COMMAND} -a -t SMRY ${RESULT_PATH}/fixed/${FILENAME} ${RESULT_PATH}/adaptive/${FILENAME} ${ABS_TOL} ${REL_TOL}
+fi
+
+exit $ecode
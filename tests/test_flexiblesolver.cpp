@@ -36,7 +36,8 @@
 
 template <int bz>
 Dune::BlockVector<Dune::FieldVector<double, bz>>
-testSolver(const boost::property_tree::ptree& prm, const std::string& matrix_filename, const std::string& rhs_filename)
+testSolver(const boost::property_tree::ptree& prm, const std::string& matrix_filename, const std::string& rhs_filename,
+           const std::shared_ptr<Opm::PreconditionerSetupData>& setupData = nullptr)
 {
     using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, bz, bz>>;
     using Vector = Dune::BlockVector<Dune::FieldVector<double, bz>>;
@@ -56,7 +57,7 @@ testSolver(const boost::property_tree::ptree& prm, const std::string& matrix_fil
         }
         readMatrixMarket(rhs, rhsfile);
     }
-    Dune::FlexibleSolver<Matrix, Vector> solver(prm, matrix);
+    Dune::FlexibleSolver<Matrix, Vector> solver(prm, matrix, setupData);
     Vector x(rhs.size());
     Dune::InverseOperatorResult res;
     solver.apply(x, rhs, res);
@@ -112,6 +113,60 @@ BOOST_AUTO_TEST_CASE(TestFlexibleSolver)
     }
 }
 
+BOOST_AUTO_TEST_CASE(TestCprSetupDataReuse)
+{
+    namespace pt = boost::property_tree;
+    pt::ptree prm;
+    {
+        std::ifstream file("options_flexiblesolver.json");
+        pt::read_json(file, prm);
+    }
+
+    const int bz = 3;
+    auto setupData = std::make_shared<Opm::PreconditionerSetupData>();
+    auto sol = testSolver<bz>(prm, "matr33.txt", "rhs3.txt", setupData);
+    BOOST_REQUIRE(setupData->pressureMatrix);
+    BOOST_CHECK_EQUAL(setupData->pressureMatrix->N(), sol.size());
+    const auto pressureMatrix = setupData->pressureMatrix;
+
+    // A second solver for the same pattern copies the kept pressure matrix
+    // and solves exactly as the first one.
+    auto solReused = testSolver<bz>(prm, "matr33.txt", "rhs3.txt", setupData);
+    BOOST_CHECK(setupData->pressureMatrix != pressureMatrix);
+    BOOST_REQUIRE_EQUAL(sol.size(), solReused.size());
+    for (size_t i = 0; i < sol.size(); ++i) {
+        for (int row = 0; row < bz; ++row) {
+            BOOST_CHECK_EQUAL(solReused[i][row], sol[i][row]);
+        }
+    }
+
+    setupData->clear();
+    BOOST_CHECK(!setupData->pressureMatrix);
+}
+
+BOOST_AUTO_TEST_CASE(TestFusedBiCGSTAB)
+{
+    namespace pt = boost::property_tree;
+    pt::ptree prm;
+    {
+        std::ifstream file("options_flexiblesolver_simple.json");
+        pt::read_json(file, prm);
+    }
+
+    const int bz = 3;
+    auto sol = testSolver<bz>(prm, "matr33.txt", "rhs3.txt");
+    prm.put("solver", "fusedbicgstab");
+    auto solFused = testSolver<bz>(prm, "matr33.txt", "rhs3.txt");
+
+    BOOST_REQUIRE_EQUAL(sol.size(), solFused.size());
+    const double scale = sol.infinity_norm();
+    for (size_t i = 0; i < sol.size(); ++i) {
+        for (int row = 0; row < bz; ++row) {
+            BOOST_CHECK_SMALL((solFused[i][row] - sol[i][row]) / scale, 1e-8);
+        }
+    }
+}
+
 #else
 
 // Do nothing if we do not have at least Dune 2.6.
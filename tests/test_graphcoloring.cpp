@@ -11,6 +11,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <cstdlib>
+
 ///! \brief check that all indices are represented in the new ordering.
 void checkAllIndices(const std::vector<std::size_t>& ordering)
 {
@@ -99,3 +101,155 @@ BOOST_AUTO_TEST_CASE(TestWelschPowell)
                                            graph, 0);
     checkAllIndices(newOrder);
 }
+
+///! \brief check that no two neighbours have the same color.
+template<class Graph>
+void checkColoring(const Graph& graph, const std::vector<int>& colors, int noColors,
+                   const std::vector<std::size_t>& verticesPerColor)
+{
+    std::vector<std::size_t> count(noColors, 0);
+    for (auto vertex : graph)
+    {
+        BOOST_REQUIRE(colors[vertex] >= 0 && colors[vertex] < noColors);
+        ++count[colors[vertex]];
+        for(auto edge = graph.beginEdges(vertex); edge != graph.endEdges(vertex); ++edge)
+        {
+            BOOST_CHECK(colors[edge.target()] != colors[vertex]);
+        }
+    }
+    BOOST_CHECK(count == verticesPerColor);
+}
+
+template<class Matrix>
+Matrix laplacian3D(int N, bool withDiagonals)
+{
+    Matrix matrix(N*N*N, N*N*N, withDiagonals ? 27 : 7, 0.4, Matrix::implicit);
+    for( int k = 0; k < N; k++)
+    {
+        for( int j = 0; j < N; j++)
+        {
+            for(int i = 0; i < N; i++)
+            {
+                auto index = (k*N + j)*N + i;
+                for( int dk = -1; dk <= 1; dk++)
+                {
+                    for( int dj = -1; dj <= 1; dj++)
+                    {
+                        for( int di = -1; di <= 1; di++)
+                        {
+                            const int neighbours = std::abs(di) + std::abs(dj) + std::abs(dk);
+                            if ( (neighbours > 1 && !withDiagonals) ||
+                                 i + di < 0 || i + di >= N || j + dj < 0 || j + dj >= N ||
+                                 k + dk < 0 || k + dk >= N )
+                            {
+                                continue;
+                            }
+                            matrix.entry(index, index + (dk*N + dj)*N + di) = 1;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    matrix.compress();
+    return matrix;
+}
+
+BOOST_AUTO_TEST_CASE(TestSpeculative)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double,1,1>>;
+    using Graph = Dune::Amg::MatrixGraph<Matrix>;
+
+    for ( bool withDiagonals : {false, true} )
+    {
+        auto matrix = laplacian3D<Matrix>(40, withDiagonals);
+        Graph graph(matrix);
+        // Without the diagonal entry of the matrix.
+        const int maxDegree = withDiagonals ? 26 : 6;
+
+        auto serial = Opm::colorVerticesWelshPowell(graph);
+        checkColoring(graph, std::get<0>(serial), std::get<1>(serial), std::get<2>(serial));
+
+        // Small blocks to get many conflicts between the blocks.
+        for ( std::size_t blockSize : {std::size_t(4096), std::size_t(100), std::size_t(7)} )
+        {
+            auto parallel = Opm::colorVerticesSpeculative(graph, blockSize);
+            const auto& colors = std::get<0>(parallel);
+            const auto noColors = std::get<1>(parallel);
+            const auto& verticesPerColor = std::get<2>(parallel);
+            checkColoring(graph, colors, noColors, verticesPerColor);
+
+            // First fit never needs more colors than the degree plus one.
+            BOOST_CHECK(noColors <= maxDegree + 1);
+            if ( withDiagonals )
+            {
+                BOOST_CHECK(noColors <= 2 * std::get<1>(serial));
+            }
+            else
+            {
+                // The checkerboard is found despite the blocks.
+                BOOST_CHECK(noColors == 2);
+                BOOST_CHECK(std::get<1>(serial) == 2);
+            }
+
+            // The coloring does not depend on the scheduling of the blocks.
+            auto again = Opm::colorVerticesSpeculative(graph, blockSize);
+            BOOST_CHECK(std::get<0>(again) == colors);
+
+            auto newOrder = Opm::reorderVerticesSpheres(colors, noColors, verticesPerColor,
+                                                        graph, 0);
+            checkAllIndices(newOrder);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestReverseCuthillMcKee)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double,1,1>>;
+    using Graph = Dune::Amg::MatrixGraph<Matrix>;
+    // Two disconnected chains whose vertices are numbered in a scrambled way.
+    int N = 19;
+    auto scramble = [N](int i) { return (7 * i) % N; };
+    Matrix matrix(2*N, 2*N, 3, 0.4, Matrix::implicit);
+    for( int chain = 0; chain < 2; chain++)
+    {
+        for(int i = 0; i < N; i++)
+        {
+            auto index = chain*N + scramble(i);
+            matrix.entry(index,index) = 1;
+            if ( i > 0 )
+            {
+                matrix.entry(index, chain*N + scramble(i-1)) = 1;
+            }
+            if ( i < N - 1 )
+            {
+                matrix.entry(index, chain*N + scramble(i+1)) = 1;
+            }
+        }
+    }
+    matrix.compress();
+
+    Graph graph(matrix);
+    auto newOrder = Opm::reorderVerticesReverseCuthillMcKee(graph);
+    checkAllIndices(newOrder);
+
+    // The reordered chains must have bandwidth one.
+    for(auto row = matrix.begin(); row != matrix.end(); ++row)
+    {
+        for(auto col = row->begin(); col != row->end(); ++col)
+        {
+            auto distance = std::max(newOrder[row.index()], newOrder[col.index()]) -
+                std::min(newOrder[row.index()], newOrder[col.index()]);
+            BOOST_CHECK(distance <= 1);
+        }
+    }
+
+    // Clustering keys must still give a permutation.
+    std::vector<int> keys(2*N);
+    for(int i = 0; i < 2*N; i++)
+    {
+        keys[i] = i % 3;
+    }
+    newOrder = Opm::reorderVerticesReverseCuthillMcKee(graph, keys);
+    checkAllIndices(newOrder);
+}
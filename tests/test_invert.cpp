@@ -72,3 +72,46 @@ BOOST_AUTO_TEST_CASE(Invert4x4)
 
 
 
+
+template <int n, int m>
+void checkBlockKernels()
+{
+    Dune::MatrixBlock<double, n, m> block;
+    Dune::FieldVector<double, m> x;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < m; ++j) {
+            block[i][j] = 0.5*i - 1.5*j + 1.0;
+        }
+    }
+    for (int j = 0; j < m; ++j) {
+        x[j] = 2.0 - j;
+    }
+
+    Dune::FieldVector<double, n> y(1.0);
+    Dune::FieldVector<double, n> yRef(1.0);
+    block.mv(x, y);
+    block.asBase().mv(x, yRef);
+    for (int i = 0; i < n; ++i) {
+        BOOST_CHECK_CLOSE(yRef[i], y[i], 1e-14);
+    }
+
+    block.umv(x, y);
+    block.asBase().umv(x, yRef);
+    block.mmv(x, y);
+    block.asBase().mmv(x, yRef);
+    block.usmv(0.25, x, y);
+    block.asBase().usmv(0.25, x, yRef);
+    for (int i = 0; i < n; ++i) {
+        BOOST_CHECK_CLOSE(yRef[i], y[i], 1e-14);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(BlockKernels)
+{
+    checkBlockKernels<1, 1>();
+    checkBlockKernels<2, 2>();
+    checkBlockKernels<3, 3>();
+    checkBlockKernels<4, 4>();
+    checkBlockKernels<6, 6>();
+    checkBlockKernels<3, 4>();
+}
@@ -0,0 +1,99 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE LinearSystemIOTest
+
+#include <opm/simulators/linalg/LinearSystemIO.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/matrixmarket.hh>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 3, 3>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, 3>>;
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+    Matrix matrix;
+    Vector rhs;
+    {
+        std::ifstream mfile("matr33.txt");
+        std::ifstream rhsfile("rhs3.txt");
+        BOOST_REQUIRE(mfile && rhsfile);
+        Dune::readMatrixMarket(matrix, mfile);
+        Dune::readMatrixMarket(rhs, rhsfile);
+    }
+    Vector weights(rhs.size());
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        weights[i] = {1.0, 0.5 * i, -2.0};
+    }
+
+    const std::string filename = "test_linearsystemio.opmls";
+    Opm::writeLinearSystem(filename, matrix, rhs, weights);
+    BOOST_CHECK_EQUAL(Opm::readLinearSystemBlockSize(filename), 3);
+
+    Matrix matrix2;
+    Vector rhs2, weights2;
+    Opm::readLinearSystem(filename, matrix2, rhs2, weights2);
+
+    BOOST_REQUIRE_EQUAL(matrix2.N(), matrix.N());
+    BOOST_REQUIRE_EQUAL(matrix2.nonzeroes(), matrix.nonzeroes());
+    for (auto row = matrix.begin(); row != matrix.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            BOOST_REQUIRE(matrix2.exists(row.index(), col.index()));
+            const auto& block2 = matrix2[row.index()][col.index()];
+            for (int i = 0; i < 3; ++i) {
+                for (int j = 0; j < 3; ++j) {
+                    BOOST_CHECK_EQUAL(block2[i][j], (*col)[i][j]);
+                }
+            }
+        }
+    }
+    BOOST_REQUIRE_EQUAL(rhs2.size(), rhs.size());
+    BOOST_REQUIRE_EQUAL(weights2.size(), weights.size());
+    for (std::size_t i = 0; i < rhs.size(); ++i) {
+        for (int k = 0; k < 3; ++k) {
+            BOOST_CHECK_EQUAL(rhs2[i][k], rhs[i][k]);
+            BOOST_CHECK_EQUAL(weights2[i][k], weights[i][k]);
+        }
+    }
+
+    // Without weights, and with the wrong block size.
+    Opm::writeLinearSystem(filename, matrix, rhs, Vector());
+    Matrix matrix3;
+    Opm::readLinearSystem(filename, matrix3, rhs2, weights2);
+    BOOST_CHECK_EQUAL(matrix3.nonzeroes(), matrix.nonzeroes());
+    BOOST_CHECK_EQUAL(weights2.size(), 0u);
+
+    Dune::BCRSMatrix<Dune::FieldMatrix<double, 2, 2>> matrix22;
+    Dune::BlockVector<Dune::FieldVector<double, 2>> rhs22, weights22;
+    BOOST_CHECK_THROW(Opm::readLinearSystem(filename, matrix22, rhs22, weights22), std::runtime_error);
+
+    std::remove(filename.c_str());
+}
@@ -9,6 +9,7 @@
 #include<dune/istl/bvector.hh>
 #include<dune/common/fmatrix.hh>
 #include<dune/common/fvector.hh>
+#include<dune/istl/preconditioners.hh>
 #include<opm/simulators/linalg/ParallelOverlappingILU0.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -191,3 +192,123 @@ BOOST_AUTO_TEST_CASE(MILULaplace4)
 {
     test<4>();
 }
+
+template<int bsize>
+void testILUn(int n)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, bsize, bsize> >;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, bsize> >;
+    std::size_t N = 16;
+    Matrix A;
+    setupLaplacian(A, N);
+
+    // ILU(1) has the same pattern as the one of dune-istl.
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector> ilu(A, n, 1.0, Opm::MILU_VARIANT::ILU);
+    Dune::SeqILUn<Matrix, Vector, Vector> duneIlu(A, n, 1.0);
+    Vector d(A.N()), v1(A.N()), v2(A.N());
+    for ( std::size_t i = 0; i < A.N(); ++i )
+    {
+        d[i] = 1.0 + (i % 7);
+    }
+    Vector d1(d), d2(d);
+    ilu.apply(v1, d1);
+    duneIlu.apply(v2, d2);
+    for ( std::size_t i = 0; i < A.N(); ++i )
+    {
+        for ( int k = 0; k < bsize; ++k )
+        {
+            BOOST_CHECK_CLOSE(v1[i][k], v2[i][k], 1e-10);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ILUnLaplace)
+{
+    testILUn<1>(1);
+    testILUn<2>(1);
+}
+
+BOOST_AUTO_TEST_CASE(ILUkPattern)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1> >;
+    const int N = 8;
+    Matrix A;
+    setupLaplacian(A, N);
+    Opm::detail::NoReorderer identity;
+
+    // Level 1 adds the two diagonals next to the outer ones, level 2 the
+    // next two, both except where the rows end.
+    auto pattern0 = Opm::detail::iluk_pattern(A, 0, identity, identity, std::vector<bool>());
+    auto pattern1 = Opm::detail::iluk_pattern(A, 1, identity, identity, std::vector<bool>());
+    auto pattern2 = Opm::detail::iluk_pattern(A, 2, identity, identity, std::vector<bool>());
+    BOOST_CHECK_EQUAL(pattern0.nonzeroes(), A.nonzeroes());
+    BOOST_CHECK_EQUAL(pattern1.nonzeroes(), A.nonzeroes() + 2 * (N - 1) * (N - 1));
+    BOOST_CHECK_GT(pattern2.nonzeroes(), pattern1.nonzeroes());
+
+    // Without fill-in in the rows and columns of the last two lines.
+    std::vector<bool> interior(N * N, true);
+    for ( int i = N * (N - 2); i < N * N; ++i )
+    {
+        interior[i] = false;
+    }
+    auto restricted = Opm::detail::iluk_pattern(A, 2, identity, identity, interior);
+    BOOST_CHECK_LT(restricted.nonzeroes(), pattern2.nonzeroes());
+    for ( std::size_t i = 0; i < A.N(); ++i )
+    {
+        for ( auto k = restricted.rowStart[i]; k < restricted.rowStart[i + 1]; ++k )
+        {
+            const auto j = restricted.columns[k];
+            if ( !interior[i] || !interior[j] )
+            {
+                BOOST_CHECK(A.exists(i, j));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(RedBlackOrderingCache)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 2, 2> >;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, 2> >;
+    using ILU = Opm::ParallelOverlappingILU0<Matrix, Vector, Vector>;
+    const int N = 16;
+    Matrix A;
+    setupLaplacian(A, N);
+    Vector d(A.N());
+    for ( std::size_t i = 0; i < A.N(); ++i )
+    {
+        d[i] = 1.0 + (i % 7);
+    }
+    auto applyILU = [&d](ILU& ilu)
+    {
+        Vector v(d.size()), dCopy(d);
+        ilu.apply(v, dCopy);
+        return v;
+    };
+
+    for ( bool speculative : {false, true} )
+    {
+        auto cache = std::make_shared<Opm::detail::OrderingCache>();
+        ILU ilu(A, 0, 1.0, Opm::MILU_VARIANT::ILU, true, true, false, speculative, cache);
+        const int kind = speculative ? 4 : 1;
+        const auto* ordering = cache->find(A, kind);
+        BOOST_REQUIRE(ordering);
+        BOOST_CHECK(!cache->find(A, speculative ? 1 : 4));
+
+        // The second preconditioner uses the cached ordering and is the same.
+        ILU iluCached(A, 0, 1.0, Opm::MILU_VARIANT::ILU, true, true, false, speculative, cache);
+        BOOST_CHECK(cache->find(A, kind) == ordering);
+        const Vector v = applyILU(ilu);
+        const Vector vCached = applyILU(iluCached);
+        for ( std::size_t i = 0; i < A.N(); ++i )
+        {
+            for ( int k = 0; k < 2; ++k )
+            {
+                BOOST_CHECK_EQUAL(v[i][k], vCached[i][k]);
+            }
+        }
+
+        cache->clear();
+        BOOST_CHECK(!cache->find(A, kind));
+    }
+}
@@ -50,3 +50,34 @@ BOOST_AUTO_TEST_CASE(Test1) {
         ++expectedNnc2;
     }
 }
+
+BOOST_AUTO_TEST_CASE(TestLarge) {
+    // large enough to exercise the threaded sort if OpenMP is enabled
+    const std::size_t numCells = 1000;
+    const std::size_t numNnc = 100000;
+    std::vector<Opm::NNCdata> nncDataIn;
+    std::vector<Opm::NNCdata> editnncData;
+    for (std::size_t nncIdx = 0; nncIdx < numNnc; ++nncIdx) {
+        std::size_t c1 = (nncIdx*7919) % numCells;
+        std::size_t c2 = (nncIdx*104729 + 17) % numCells;
+        nncDataIn.emplace_back(c1, c2, 1.0);
+        if (nncIdx % 10 == 0)
+            editnncData.emplace_back(c2, c1, 2.0);
+    }
+
+    auto nncDataProcessed = Ewoms::sortNncAndApplyEditnnc(nncDataIn, editnncData, /*log=*/false);
+    BOOST_CHECK(nncDataProcessed.size() == nncDataIn.size());
+
+    for (std::size_t nncIdx = 0; nncIdx < nncDataProcessed.size(); ++nncIdx) {
+        const auto& entry = nncDataProcessed[nncIdx];
+        BOOST_CHECK(entry.cell1 <= entry.cell2);
+        if (nncIdx > 0) {
+            const auto& prevEntry = nncDataProcessed[nncIdx - 1];
+            BOOST_CHECK(prevEntry.cell1 < entry.cell1
+                        || (prevEntry.cell1 == entry.cell1 && prevEntry.cell2 <= entry.cell2));
+            // all NNCs between the same cells must have been edited by the same factor
+            if (prevEntry.cell1 == entry.cell1 && prevEntry.cell2 == entry.cell2)
+                BOOST_CHECK_CLOSE(prevEntry.trans, entry.trans, 1e-10);
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE ParallelWellLoopTest
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/wells/ParallelWellLoop.hpp>
+
+#include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/OpmLog/LogUtil.hpp>
+#include <opm/common/OpmLog/StreamLog.hpp>
+
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+
+struct Result
+{
+    std::vector<double> values;
+    std::string log;
+    std::string error;
+};
+
+// Run a loop over wells doing an uneven amount of work, logging from some
+// of them and throwing from the ones listed in failing.
+Result runLoop(const int numThreads, const int numWells, const std::vector<int>& failing)
+{
+#ifdef _OPENMP
+    omp_set_num_threads(numThreads);
+#else
+    static_cast<void>(numThreads);
+#endif
+    std::ostringstream log_stream;
+    Opm::OpmLog::removeAllBackends();
+    auto streamLog = std::make_shared<Opm::StreamLog>(log_stream, Opm::Log::DefaultMessageTypes);
+    streamLog->setMessageFormatter(std::make_shared<Opm::SimpleMessageFormatter>(false, false));
+    Opm::OpmLog::addBackend("STREAM", streamLog);
+
+    Result result;
+    result.values.assign(numWells, 0.0);
+    Opm::DeferredLogger deferred_logger;
+    deferred_logger.info("before");
+    try {
+        Opm::parallelWellLoop(numWells, deferred_logger,
+                              [&](const int w, Opm::DeferredLogger& logger) {
+                                  double sum = 0.0;
+                                  for (int i = 0; i < 1000 * (w % 7 + 1); ++i) {
+                                      sum += std::sin(w + 0.001 * i);
+                                  }
+                                  result.values[w] = sum;
+                                  if (w % 3 == 0) {
+                                      logger.warning("well " + std::to_string(w));
+                                  }
+                                  for (const int f : failing) {
+                                      if (f == w) {
+                                          logger.error("failed " + std::to_string(w));
+                                          throw std::runtime_error("well " + std::to_string(w) + " failed");
+                                      }
+                                  }
+                              });
+    } catch (const std::runtime_error& e) {
+        result.error = e.what();
+    }
+    deferred_logger.logMessages();
+    result.log = log_stream.str();
+    return result;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(SameResultForAnyNumberOfThreads)
+{
+    const int numWells = 200;
+    const Result serial = runLoop(1, numWells, {});
+    BOOST_CHECK(serial.error.empty());
+
+    std::string expected = "before\n";
+    for (int w = 0; w < numWells; w += 3) {
+        expected += "well " + std::to_string(w) + "\n";
+    }
+    BOOST_CHECK_EQUAL(serial.log, expected);
+
+    for (const int threads : {2, 4, 7}) {
+        const Result parallel = runLoop(threads, numWells, {});
+        BOOST_CHECK_EQUAL(parallel.log, serial.log);
+        BOOST_CHECK(parallel.error.empty());
+        for (int w = 0; w < numWells; ++w) {
+            BOOST_CHECK_EQUAL(parallel.values[w], serial.values[w]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(FirstFailingWellIsRethrown)
+{
+    const int numWells = 50;
+    for (const int threads : {1, 4}) {
+        const Result result = runLoop(threads, numWells, {41, 17});
+        BOOST_CHECK_EQUAL(result.error, "well 17 failed");
+        // All wells are processed, and all messages are kept.
+        for (int w = 0; w < numWells; ++w) {
+            BOOST_CHECK(result.values[w] != 0.0);
+        }
+        BOOST_CHECK(result.log.find("failed 17\n") != std::string::npos);
+        BOOST_CHECK(result.log.find("failed 41\n") != std::string::npos);
+        BOOST_CHECK(result.log.find("well 48\n") != std::string::npos);
+    }
+}
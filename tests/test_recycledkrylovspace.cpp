@@ -0,0 +1,187 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE RecycledKrylovSpaceTest
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/version.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/scalarproducts.hh>
+#include <dune/istl/solvers.hh>
+
+#include <opm/simulators/linalg/RecycledKrylovSpace.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#if DUNE_VERSION_NEWER(DUNE_ISTL, 2, 6)
+
+using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, 1>>;
+
+// Slightly shifted 1D Laplacian, which converges slowly with ILU0.
+Matrix laplacian(int n)
+{
+    Matrix A(n, n, 3 * n, Matrix::row_wise);
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        const int i = row.index();
+        if (i > 0) {
+            row.insert(i - 1);
+        }
+        row.insert(i);
+        if (i < n - 1) {
+            row.insert(i + 1);
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        if (i > 0) {
+            A[i][i - 1] = -1.0;
+        }
+        A[i][i] = 2.0001;
+        if (i < n - 1) {
+            A[i][i + 1] = -1.0;
+        }
+    }
+    return A;
+}
+
+BOOST_AUTO_TEST_CASE(ProjectionIsExactOnRecycledSpace)
+{
+    const int n = 100;
+    const Matrix A = laplacian(n);
+    Dune::MatrixAdapter<Matrix, Vector, Vector> op(A);
+    Dune::SeqScalarProduct<Vector> sp;
+
+    Vector w1(n), w2(n);
+    for (int i = 0; i < n; ++i) {
+        w1[i] = std::sin(M_PI * (i + 1) / (n + 1));
+        w2[i] = 1.0 + i % 5;
+    }
+
+    Opm::RecycledKrylovSpace<Vector> space(3);
+    space.add(w1);
+    space.add(w2);
+    space.add(w1); // Linearly dependent, must be dropped.
+    space.update(op, sp);
+    BOOST_CHECK_EQUAL(space.size(), 2u);
+
+    // For b = A (w1 + 2 w2) the projection gives the exact solution.
+    Vector xExact(w1);
+    xExact.axpy(2.0, w2);
+    Vector b(n);
+    op.apply(xExact, b);
+    Vector x(n);
+    x = 0.0;
+    Vector r(b);
+    space.project(x, r, sp);
+    for (int i = 0; i < n; ++i) {
+        BOOST_CHECK_SMALL(x[i][0] - xExact[i][0], 1e-10);
+        BOOST_CHECK_SMALL(r[i][0], 1e-10);
+    }
+
+    // Shrinking the space drops the oldest solutions.
+    space.setMaxSize(1);
+    space.update(op, sp);
+    BOOST_CHECK_EQUAL(space.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(DeflationReducesIterations)
+{
+    const int n = 400;
+    const Matrix A = laplacian(n);
+    Dune::MatrixAdapter<Matrix, Vector, Vector> op(A);
+    Dune::SeqScalarProduct<Vector> sp;
+    Dune::SeqILU0<Matrix, Vector, Vector> ilu(A, 1.0);
+    const double reduction = 1e-8;
+
+    Vector b(n);
+    for (int i = 0; i < n; ++i) {
+        b[i] = 1.0 + std::cos(0.1 * i);
+    }
+
+    // First solve without recycling.
+    Vector x1(n);
+    x1 = 0.0;
+    Dune::InverseOperatorResult res1;
+    {
+        Vector rhs(b);
+        Dune::BiCGSTABSolver<Vector> solver(op, sp, ilu, reduction, 1000, 0);
+        solver.apply(x1, rhs, res1);
+    }
+    BOOST_REQUIRE(res1.converged);
+
+    Opm::RecycledKrylovSpace<Vector> space(2);
+    space.add(x1);
+    space.update(op, sp);
+
+    // Second solve with a slightly perturbed right hand side.
+    Vector b2(b);
+    for (int i = 0; i < n; ++i) {
+        b2[i] += 1e-2 * std::sin(0.37 * i);
+    }
+
+    Dune::InverseOperatorResult resPlain;
+    {
+        Vector x(n);
+        x = 0.0;
+        Vector rhs(b2);
+        Dune::BiCGSTABSolver<Vector> solver(op, sp, ilu, reduction, 1000, 0);
+        solver.apply(x, rhs, resPlain);
+    }
+
+    Dune::InverseOperatorResult resDeflated;
+    Vector x(n);
+    x = 0.0;
+    {
+        Vector r(b2);
+        const double defect = sp.norm(r);
+        space.project(x, r, sp);
+        const double projectedReduction = std::min(1.0, reduction * defect / sp.norm(r));
+        Opm::DeflatedPreconditioner<Vector, Dune::SeqScalarProduct<Vector>> deflated(ilu, space, sp);
+        Vector rhs(b2);
+        Dune::BiCGSTABSolver<Vector> solver(op, sp, deflated, projectedReduction, 1000, 0);
+        solver.apply(x, rhs, resDeflated);
+    }
+    BOOST_REQUIRE(resPlain.converged);
+    BOOST_REQUIRE(resDeflated.converged);
+    BOOST_CHECK_LT(resDeflated.iterations, resPlain.iterations);
+
+    // The deflated solve reaches the requested accuracy relative to b2.
+    Vector defect(b2);
+    op.applyscaleadd(-1.0, x, defect);
+    BOOST_CHECK_LT(sp.norm(defect), 10.0 * reduction * sp.norm(b2));
+}
+
+#else
+
+// Do nothing if we do not have at least Dune 2.6.
+BOOST_AUTO_TEST_CASE(DummyTest)
+{
+    BOOST_REQUIRE(true);
+}
+
+#endif
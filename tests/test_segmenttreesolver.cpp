@@ -0,0 +1,161 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE SegmentTreeSolverTest
+
+#include <opm/simulators/wells/SegmentTreeSolver.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+constexpr int n = 4;
+using Block = Dune::FieldMatrix<double, n, n>;
+using Matrix = Dune::BCRSMatrix<Block>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, n>>;
+
+double value(int a, int b, int c)
+{
+    return std::sin(1.0 + 0.37 * a + 1.3 * b + 2.1 * c);
+}
+
+// Segment matrix with the pattern MultisegmentWell uses for duneD_.
+Matrix segmentMatrix(const std::vector<int>& outlets)
+{
+    const int numSeg = outlets.size();
+    Matrix D(numSeg, numSeg, Matrix::random);
+    std::vector<int> rowSize(numSeg, 1);
+    for (int seg = 0; seg < numSeg; ++seg) {
+        if (outlets[seg] >= 0) {
+            ++rowSize[seg];
+            ++rowSize[outlets[seg]];
+        }
+    }
+    for (int seg = 0; seg < numSeg; ++seg) {
+        D.setrowsize(seg, rowSize[seg]);
+    }
+    D.endrowsizes();
+    for (int seg = 0; seg < numSeg; ++seg) {
+        D.addindex(seg, seg);
+        if (outlets[seg] >= 0) {
+            D.addindex(seg, outlets[seg]);
+            D.addindex(outlets[seg], seg);
+        }
+    }
+    D.endindices();
+
+    for (auto row = D.begin(); row != D.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    (*col)[i][j] = value(row.index(), col.index(), i * n + j);
+                }
+            }
+            if (row.index() == col.index()) {
+                for (int i = 0; i < n; ++i) {
+                    (*col)[i][i] += 4.0;
+                }
+            }
+        }
+    }
+    return D;
+}
+
+// A main stem with laterals, numbered so that some outlets come after
+// their inlets.
+std::vector<int> stemWithLaterals(const int stem, const int laterals, const int lateralLength)
+{
+    std::vector<int> outlets;
+    outlets.push_back(-1);
+    for (int seg = 1; seg < stem; ++seg) {
+        outlets.push_back(seg - 1);
+    }
+    for (int lat = 0; lat < laterals; ++lat) {
+        const int first = outlets.size();
+        for (int k = 0; k < lateralLength; ++k) {
+            // the segment closest to the stem is numbered last
+            outlets.push_back(k + 1 < lateralLength ? first + k + 1 : (lat * 7) % stem);
+        }
+    }
+    return outlets;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(SolvesTreeSystem)
+{
+    for (const auto& outlets : {std::vector<int>{-1}, stemWithLaterals(10, 0, 0), stemWithLaterals(30, 4, 6)}) {
+        const Matrix D = segmentMatrix(outlets);
+        Vector x0(outlets.size());
+        for (std::size_t seg = 0; seg < x0.size(); ++seg) {
+            for (int i = 0; i < n; ++i) {
+                x0[seg][i] = value(seg, i, 11);
+            }
+        }
+        Vector b(x0.size());
+        D.mv(x0, b);
+
+        Opm::SegmentTreeSolver<double, n> solver;
+        solver.setStructure(outlets);
+        BOOST_REQUIRE(solver.factorize(D));
+        Vector x(x0.size());
+        // the factorization is reused
+        for (int repeat = 0; repeat < 2; ++repeat) {
+            x = 0.0;
+            solver.solve(b, x);
+            for (std::size_t seg = 0; seg < x0.size(); ++seg) {
+                for (int i = 0; i < n; ++i) {
+                    BOOST_CHECK_SMALL(x[seg][i] - x0[seg][i], 1e-10);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SingularPivotAndInvalidStructure)
+{
+    const auto outlets = stemWithLaterals(5, 1, 3);
+    Matrix D = segmentMatrix(outlets);
+    D[2][2] = 0.0;
+    D[2][3] = 0.0;
+    D[2][1] = 0.0;
+
+    Opm::SegmentTreeSolver<double, n> solver;
+    solver.setStructure(outlets);
+    BOOST_CHECK(!solver.factorize(D));
+    BOOST_CHECK(!solver.factorized());
+    Vector b(outlets.size()), x(outlets.size());
+    b = 1.0;
+    BOOST_CHECK_THROW(solver.solve(b, x), std::logic_error);
+
+    BOOST_CHECK_THROW(solver.setStructure({-1, 0, -1}), std::logic_error);
+    BOOST_CHECK_THROW(solver.setStructure({-1, 2, 1}), std::logic_error);
+}
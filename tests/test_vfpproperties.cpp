@@ -554,6 +554,47 @@ BOOST_AUTO_TEST_CASE(THPToBHPAndBackNonTrivial)
 
 
 
+BOOST_AUTO_TEST_CASE(BhpWithTHPTargetReusesLiftCurve)
+{
+    fillDataPlane();
+    initProperties();
+
+    // rates are bhp * ipr_b - ipr_a for water, oil and gas
+    const std::vector<double> ipr_a{0.4, 0.9, 0.2};
+    const std::vector<double> ipr_b{0.1, 0.2, 0.05};
+    const double bhp_limit = 1.0;
+    const double thp = 0.5;
+    const double alq = 0.5;
+    const double dp = 0.1;
+
+    Opm::VFPProdProperties::LiftCurve lift_curve;
+    const double bhp = properties->calculateBhpWithTHPTarget(ipr_a, ipr_b, bhp_limit, 1, thp, alq, dp);
+    BOOST_CHECK_EQUAL(properties->calculateBhpWithTHPTarget(ipr_a, ipr_b, bhp_limit, 1, thp, alq, dp, lift_curve), bhp);
+    BOOST_CHECK_EQUAL(lift_curve.samples.size(), 17u);
+    const double wfr = lift_curve.wfr;
+    const double gfr = lift_curve.gfr;
+
+    // A slightly different inflow keeps the lift curve
+    std::vector<double> ipr_a_close = ipr_a;
+    ipr_a_close[1] *= 1.0 + 1.e-5;
+    properties->calculateBhpWithTHPTarget(ipr_a_close, ipr_b, bhp_limit, 1, thp, alq, dp, lift_curve);
+    BOOST_CHECK_EQUAL(lift_curve.wfr, wfr);
+    BOOST_CHECK_EQUAL(lift_curve.gfr, gfr);
+
+    // while a different one resamples it
+    std::vector<double> ipr_a_far = ipr_a;
+    ipr_a_far[1] *= 2.0;
+    const double bhp_far = properties->calculateBhpWithTHPTarget(ipr_a_far, ipr_b, bhp_limit, 1, thp, alq, dp, lift_curve);
+    BOOST_CHECK(lift_curve.wfr != wfr);
+    BOOST_CHECK_EQUAL(bhp_far, properties->calculateBhpWithTHPTarget(ipr_a_far, ipr_b, bhp_limit, 1, thp, alq, dp));
+
+    // as does a different THP
+    properties->calculateBhpWithTHPTarget(ipr_a_far, ipr_b, bhp_limit, 1, 0.75, alq, dp, lift_curve);
+    BOOST_CHECK_EQUAL(lift_curve.thp, 0.75);
+}
+
+
+
 BOOST_AUTO_TEST_SUITE_END() // Trivial tests
 
 
@@ -24,6 +24,7 @@
 #define BOOST_TEST_MODULE WellCollectionTest
 #include <boost/test/unit_test.hpp>
 #include <opm/core/wells/WellCollection.hpp>
+#include <opm/core/wells.h>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -70,6 +71,13 @@ BOOST_AUTO_TEST_CASE(AddWellsAndGroupToCollection) {
     BOOST_CHECK_EQUAL("G1", collection.findNode("INJ2")->getParent()->name());
     BOOST_CHECK_EQUAL("G2", collection.findNode("PROD1")->getParent()->name());
     BOOST_CHECK_EQUAL("G2", collection.findNode("PROD2")->getParent()->name());
+
+    // Every leaf node is found by the name of its well.
+    BOOST_CHECK_EQUAL(collection.getLeafNodes().size(), 4);
+    for (WellNode* well_node : collection.getLeafNodes()) {
+        BOOST_CHECK_EQUAL(&collection.findWellNode(well_node->name()), well_node);
+    }
+    BOOST_CHECK_THROW(collection.findWellNode("G1"), std::runtime_error);
 }
 
 BOOST_AUTO_TEST_CASE(EfficiencyFactor) {
@@ -112,3 +120,71 @@ BOOST_AUTO_TEST_CASE(EfficiencyFactor) {
     // 1.0 (prod2) * 1.0 (G2)
     BOOST_CHECK_CLOSE(1.0, collection.findWellNode("PROD2").getAccumulativeEfficiencyFactor(), 1e-10);
 }
+
+BOOST_AUTO_TEST_CASE(CachedProductionRates) {
+    Parser parser;
+    std::string scheduleFile("wells_group.data");
+    Deck deck = parser.parseFile(scheduleFile);
+    EclipseState eclipseState(deck);
+    PhaseUsage pu = phaseUsageFromDeck(eclipseState);
+    const auto& grid = eclipseState.getInputGrid();
+    const TableManager table ( deck );
+    const Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    const Runspec runspec(deck);
+    const Schedule sched(deck, grid, eclipseProperties, runspec);
+    SummaryState summaryState;
+
+    size_t timestep = 2;
+    WellCollection collection;
+    const auto& fieldGroup =  sched.getGroup2("FIELD", timestep);
+    collection.addField( fieldGroup, summaryState, pu);
+    collection.addGroup( sched.getGroup2( "G1", timestep ), fieldGroup.name(), summaryState, pu);
+    collection.addGroup( sched.getGroup2( "G2", timestep ), fieldGroup.name(), summaryState, pu);
+
+    const auto wells_ecl = sched.getWells2(timestep);
+    for (size_t i=0; i<wells_ecl.size(); i++) {
+        collection.addWell(wells_ecl[i], summaryState, pu);
+    }
+
+    // A wells struct with the wells in the order of the leaf nodes.
+    const int np = pu.num_phases;
+    const int nw = collection.getLeafNodes().size();
+    std::unique_ptr<Wells, void(*)(Wells*)> wells(create_wells(np, nw, nw), &destroy_wells);
+    const std::vector<double> comp_frac(np, 1.0 / np);
+    for (int w = 0; w < nw; ++w) {
+        const WellNode* well_node = collection.getLeafNodes()[w];
+        const bool injector = well_node->name().compare(0, 3, "INJ") == 0;
+        const int cell = w;
+        const int sat_table_id = 0;
+        BOOST_REQUIRE(add_well(injector ? INJECTOR : PRODUCER, 0.0, 1, comp_frac.data(), &cell,
+                               nullptr, &sat_table_id, well_node->name().c_str(), 1, wells.get()));
+    }
+    collection.setWellsPointer(wells.get());
+
+    std::vector<double> well_rates(nw * np);
+    for (int i = 0; i < nw * np; ++i) {
+        well_rates[i] = -10.0 * (i + 1);
+    }
+
+    const auto checkRates = [&]() {
+        collection.updateProductionRates(well_rates);
+        for (const auto mode : { ProductionSpecification::LRAT, ProductionSpecification::ORAT,
+                                 ProductionSpecification::WRAT, ProductionSpecification::GRAT }) {
+            for (const std::string name : { "FIELD", "G1", "G2", "PROD1", "PROD2" }) {
+                const WellsGroupInterface* node = collection.findNode(name);
+                BOOST_CHECK_EQUAL(node->productionRate(mode), node->getProductionRate(well_rates, mode));
+            }
+        }
+    };
+
+    checkRates();
+    BOOST_CHECK(collection.findNode("FIELD")->productionRate(ProductionSpecification::ORAT) != 0.0);
+
+    // Changing the rates of one well, and an efficiency factor.
+    well_rates[np * collection.findWellNode("PROD2").selfIndex()] *= 3.0;
+    checkRates();
+    collection.findNode("G2")->setEfficiencyFactor(0.5);
+    checkRates();
+    well_rates[np * collection.findWellNode("PROD1").selfIndex() + np - 1] = 0.0;
+    checkRates();
+}
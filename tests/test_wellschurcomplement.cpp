@@ -0,0 +1,275 @@
+/*
+  Copyright 2019 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE WellSchurComplementTest
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <boost/test/unit_test.hpp>
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+
+#include <opm/grid/UnstructuredGrid.h>
+#include <opm/grid/GridHelpers.hpp>
+#include <opm/core/wells/WellsManager.hpp>
+#include <opm/core/wells.h>
+#include <opm/core/props/phaseUsageFromDeck.hpp>
+
+#include <opm/simulators/flow/FlowMainEbos.hpp>
+#include <opm/simulators/flow/BlackoilModelEbos.hpp>
+
+#include <ebos/eclproblem.hh>
+#include <ewoms/common/start.hh>
+
+#include <opm/simulators/wells/StandardWell.hpp>
+#include <opm/simulators/wells/WellSchurComplement.hpp>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+
+#include <cmath>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace
+{
+
+using StandardWell = Opm::StandardWell<TTAG(EclFlowProblem)>;
+using BVector = StandardWell::BVector;
+using Mat = StandardWell::Mat;
+constexpr int numEq = StandardWell::numEq;
+using Operator = Opm::WellSchurComplement<double, numEq>;
+
+double value(int a, int b, int c)
+{
+    return std::sin(1.0 + 0.37 * a + 1.3 * b + 2.1 * c);
+}
+
+// A standard well whose linearized equations are set directly instead of
+// being assembled from a simulator.
+class StandardWellWithBlocks : public StandardWell
+{
+public:
+    using StandardWell::StandardWell;
+
+    void setBlocks(const int seed)
+    {
+        for (auto col = this->duneB_[0].begin(); col != this->duneB_[0].end(); ++col) {
+            fill(*col, seed, col.index());
+        }
+        for (auto col = this->duneC_[0].begin(); col != this->duneC_[0].end(); ++col) {
+            fill(*col, seed + 1, col.index());
+        }
+        fill(this->invDuneD_[0][0], seed + 2, 0);
+    }
+
+    const std::vector<int>& cells() const
+    {
+        return this->well_cells_;
+    }
+
+private:
+    template <class Block>
+    static void fill(Block& block, const int seed, const int col)
+    {
+        for (std::size_t i = 0; i < block.N(); ++i) {
+            for (std::size_t j = 0; j < block.M(); ++j) {
+                block[i][j] = value(seed, col, i * block.M() + j);
+            }
+        }
+    }
+};
+
+struct SetupWells
+{
+    SetupWells()
+    {
+        Opm::Parser parser;
+        auto deck = parser.parseFile("TESTWELLMODEL.DATA");
+        Opm::EclipseState ecl_state(deck);
+        const Opm::TableManager table(deck);
+        const Opm::Eclipse3DProperties eclipseProperties(deck, table, ecl_state.getInputGrid());
+        const Opm::Runspec runspec(deck);
+        const Opm::Schedule schedule(deck, ecl_state.getInputGrid(), eclipseProperties, runspec);
+
+        const std::vector<double>& porv =
+            ecl_state.get3DProperties().getDoubleGridProperty("PORV").getData();
+        Opm::GridManager gm(ecl_state.getInputGrid(), porv);
+        const UnstructuredGrid& grid = *(gm.c_grid());
+        numCells = Opm::UgGridHelpers::numCells(grid);
+
+        const int current_timestep = 0;
+        Opm::SummaryState summaryState;
+        const Opm::WellsManager wells_manager(ecl_state, schedule, summaryState, current_timestep,
+                                              numCells,
+                                              Opm::UgGridHelpers::globalCell(grid),
+                                              Opm::UgGridHelpers::cartDims(grid),
+                                              Opm::UgGridHelpers::dimensions(grid),
+                                              Opm::UgGridHelpers::cell2Faces(grid),
+                                              Opm::UgGridHelpers::beginFaceCentroids(grid),
+                                              false,
+                                              std::unordered_set<std::string>());
+        const Wells* wells_struct = wells_manager.c_wells();
+        const auto& wells_ecl = schedule.getWells2(current_timestep);
+
+        phaseUsage = Opm::phaseUsageFromDeck(ecl_state);
+        rateConverter.reset(new RateConverterType(phaseUsage, std::vector<int>(numCells, 0)));
+        const std::vector<double> depth(numCells, 0.0);
+
+        for (int w = 0; w < wells_struct->number_of_wells; ++w) {
+            for (const auto& well_ecl : wells_ecl) {
+                if (well_ecl.name() == wells_struct->name[w]) {
+                    wells.emplace_back(new StandardWellWithBlocks(well_ecl, current_timestep, wells_struct, param,
+                                                                  *rateConverter, /*pvtIdx=*/0,
+                                                                  wells_struct->number_of_phases));
+                }
+            }
+            wells.back()->init(&phaseUsage, depth, /*gravity=*/9.81, numCells);
+            wells.back()->setBlocks(3 * w);
+        }
+    }
+
+    using RateConverterType = StandardWell::RateConverterType;
+
+    int numCells = 0;
+    Opm::PhaseUsage phaseUsage;
+    const Opm::BlackoilModelParametersEbos<TTAG(EclFlowProblem)> param;
+    std::unique_ptr<RateConverterType> rateConverter;
+    std::vector<std::unique_ptr<StandardWellWithBlocks>> wells;
+};
+
+struct GlobalFixture
+{
+    GlobalFixture()
+    {
+        int argcDummy = 1;
+        const char *tmp[] = {"test_wellschurcomplement"};
+        char **argvDummy = const_cast<char**>(tmp);
+
+#if HAVE_DUNE_FEM
+        Dune::Fem::MPIManager::initialize(argcDummy, argvDummy);
+#else
+        Dune::MPIHelper::instance(argcDummy, argvDummy);
+#endif
+
+        Opm::FlowMainEbos<TTAG(EclFlowProblem)>::setupParameters_(argcDummy, argvDummy);
+    }
+};
+
+BVector makeVector(const int numCells, const int seed)
+{
+    BVector x(numCells);
+    for (int cell = 0; cell < numCells; ++cell) {
+        for (int k = 0; k < numEq; ++k) {
+            x[cell][k] = value(cell, k, seed);
+        }
+    }
+    return x;
+}
+
+void checkClose(const BVector& actual, const BVector& expected)
+{
+    BOOST_REQUIRE_EQUAL(actual.size(), expected.size());
+    for (std::size_t cell = 0; cell < expected.size(); ++cell) {
+        for (int k = 0; k < numEq; ++k) {
+            BOOST_CHECK_SMALL(actual[cell][k] - expected[cell][k], 1e-12);
+        }
+    }
+}
+
+} // anonymous namespace
+
+BOOST_GLOBAL_FIXTURE(GlobalFixture);
+
+BOOST_AUTO_TEST_CASE(MatchesStandardWellApply)
+{
+    const SetupWells setup;
+    BOOST_REQUIRE_EQUAL(setup.wells.size(), 2);
+
+    Operator op;
+    for (const auto& well : setup.wells) {
+        BOOST_CHECK(well->addToSchurComplement(op));
+    }
+    op.finalize();
+    BOOST_CHECK_EQUAL(op.numberOfWells(), 2);
+
+    const BVector x = makeVector(setup.numCells, 3);
+    BVector expected = makeVector(setup.numCells, 5);
+    BVector Ax(expected);
+    for (const auto& well : setup.wells) {
+        well->apply(x, expected);
+    }
+    op.apply(x, Ax);
+    checkClose(Ax, expected);
+
+    // Applying again after clear() leaves Ax unchanged.
+    op.clear();
+    op.finalize();
+    BOOST_CHECK_EQUAL(op.numberOfWells(), 0);
+    BVector Ax2(Ax);
+    op.apply(x, Ax2);
+    checkClose(Ax2, Ax);
+}
+
+BOOST_AUTO_TEST_CASE(MatchesStandardWellAddWellContributions)
+{
+    const SetupWells setup;
+    const int numCells = setup.numCells;
+
+    // The diagonal and all couplings between the cells of a well.
+    std::vector<std::set<int>> pattern(numCells);
+    for (int cell = 0; cell < numCells; ++cell) {
+        pattern[cell].insert(cell);
+    }
+    for (const auto& well : setup.wells) {
+        for (const int row : well->cells()) {
+            pattern[row].insert(well->cells().begin(), well->cells().end());
+        }
+    }
+    Mat mat(numCells, numCells, Mat::row_wise);
+    for (auto row = mat.createbegin(); row != mat.createend(); ++row) {
+        for (const int col : pattern[row.index()]) {
+            row.insert(col);
+        }
+    }
+    mat = 0.0;
+
+    Operator op;
+    for (const auto& well : setup.wells) {
+        well->addWellContributions(mat);
+        well->addToSchurComplement(op);
+    }
+    op.finalize();
+
+    const BVector x = makeVector(setup.numCells, 7);
+    BVector expected = makeVector(setup.numCells, 11);
+    BVector Ax(expected);
+    mat.umv(x, expected);
+    op.apply(x, Ax);
+    checkClose(Ax, expected);
+}
@@ -303,3 +303,98 @@ BOOST_AUTO_TEST_CASE(Rates)
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+// ---------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Snapshot)
+
+BOOST_AUTO_TEST_CASE(RestoreSavedValues)
+{
+    const Setup setup{ "msw.data" };
+    const auto tstep = std::size_t{0};
+
+    auto wstate = buildWellState(setup, tstep);
+
+    const auto& wells = setup.sched.getWells2atEnd();
+    setSegPress(wells, wstate);
+    setSegRates(wells, setup.pu, wstate);
+
+    const auto bhp0      = wstate.bhp();
+    const auto rates0    = wstate.wellRates();
+    const auto perf0     = wstate.perfPhaseRates();
+    const auto ctrl0     = wstate.currentControls();
+    const auto segPress0 = wstate.segPress();
+    const auto segRates0 = wstate.segRates();
+
+    auto snapshot = Opm::WellStateFullyImplicitBlackoil::Snapshot{};
+
+    // Saving twice reuses the snapshot.
+    for (int repeat = 0; repeat < 2; ++repeat) {
+        wstate.saveSnapshot(snapshot);
+
+        for (auto& bhp   : wstate.bhp())             { bhp   += 1.0e5; }
+        for (auto& rate  : wstate.wellRates())       { rate  *= 2.0;   }
+        for (auto& rate  : wstate.perfPhaseRates())  { rate  -= 1.0;   }
+        for (auto& ctrl  : wstate.currentControls()) { ctrl  += 1;     }
+        for (auto& press : wstate.segPress())        { press += 10.0;  }
+        for (auto& rate  : wstate.segRates())        { rate  += 5.0;   }
+
+        wstate.restoreSnapshot(snapshot);
+
+        BOOST_CHECK(wstate.bhp() == bhp0);
+        BOOST_CHECK(wstate.wellRates() == rates0);
+        BOOST_CHECK(wstate.perfPhaseRates() == perf0);
+        BOOST_CHECK(wstate.currentControls() == ctrl0);
+        BOOST_CHECK(wstate.segPress() == segPress0);
+        BOOST_CHECK(wstate.segRates() == segRates0);
+    }
+
+    // The structure is untouched.
+    BOOST_CHECK_EQUAL(wstate.numSegment(), 6 + 1);
+    BOOST_CHECK_EQUAL(wstate.numWells(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(CopyValuesOfOneWell)
+{
+    const Setup setup{ "msw.data" };
+    const auto tstep = std::size_t{0};
+
+    auto wstate = buildWellState(setup, tstep);
+
+    const auto& wells = setup.sched.getWells2atEnd();
+    setSegPress(wells, wstate);
+    setSegRates(wells, setup.pu, wstate);
+
+    auto other = wstate;
+    for (auto& bhp   : other.bhp())             { bhp   += 1.0e5; }
+    for (auto& rate  : other.wellRates())       { rate  *= 2.0;   }
+    for (auto& ctrl  : other.currentControls()) { ctrl  += 1;     }
+    for (auto& press : other.segPress())        { press += 10.0;  }
+    for (auto& rate  : other.segRates())        { rate  += 5.0;   }
+
+    const auto before = wstate;
+    const auto np = wstate.numPhases();
+    const auto well = 1;
+    wstate.copyWellValues(other, well);
+
+    for (auto w = 0; w < wstate.numWells(); ++w) {
+        const auto& expected = (w == well) ? other : before;
+        BOOST_CHECK_EQUAL(wstate.bhp()[w], expected.bhp()[w]);
+        BOOST_CHECK_EQUAL(wstate.currentControls()[w], expected.currentControls()[w]);
+        for (auto p = 0; p < np; ++p) {
+            BOOST_CHECK_EQUAL(wstate.wellRates()[w*np + p], expected.wellRates()[w*np + p]);
+        }
+    }
+
+    // The segments of the last well are stored at the end.
+    const auto topSeg = wstate.topSegmentIndex(well);
+    for (auto seg = 0; seg < wstate.numSegment(); ++seg) {
+        const auto& expected = (seg >= topSeg) ? other : before;
+        BOOST_CHECK_EQUAL(wstate.segPress()[seg], expected.segPress()[seg]);
+        for (auto p = 0; p < np; ++p) {
+            BOOST_CHECK_EQUAL(wstate.segRates()[seg*np + p], expected.segRates()[seg*np + p]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()